@@ -0,0 +1,118 @@
+#include <rpg/asset_archive.hpp>
+
+#include <docopt.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+static constexpr auto usage = R"(
+  RPG Archive Packer
+
+  Packs files into a single asset archive that the game maps into memory.
+  Files are stored under their file name; the files inside a directory are
+  stored under their path relative to it.
+
+  Usage:
+    rpg-archive-packer --output=FILE <input>...
+
+  Options:
+    -h --help             Show this message
+    --output=FILE         Archive to write
+)";
+
+struct cli_args {
+  std::filesystem::path output;
+  std::vector<std::filesystem::path> inputs;
+};
+
+[[nodiscard]] inline auto parse_cli_args(int argc, char **argv) -> cli_args {
+  std::map<std::string, docopt::value> args =
+      docopt::docopt(usage, {std::next(argv), std::next(argv, argc)}, true,
+                     "RPG Archive Packer 0.0.0.0");
+  cli_args result{.output = args["--output"].asString(), .inputs = {}};
+  for (const auto &input : args["<input>"].asStringList()) {
+    result.inputs.emplace_back(input);
+  }
+  return result;
+}
+
+// Name and path of every file to pack, sorted by name so the same inputs
+// always give the same archive.
+[[nodiscard]] auto collect(const cli_args &args)
+    -> std::vector<std::pair<std::string, std::filesystem::path>> {
+  std::vector<std::pair<std::string, std::filesystem::path>> files{};
+  for (const auto &input : args.inputs) {
+    if (not std::filesystem::is_directory(input)) {
+      files.emplace_back(input.filename().generic_string(), input);
+      continue;
+    }
+    for (const auto &entry :
+         std::filesystem::recursive_directory_iterator{input}) {
+      if (entry.is_regular_file()) {
+        files.emplace_back(
+            entry.path().lexically_relative(input).generic_string(),
+            entry.path());
+      }
+    }
+  }
+  std::ranges::sort(files);
+  return files;
+}
+
+[[nodiscard]] auto read_file(const std::filesystem::path &path)
+    -> std::vector<std::byte> {
+  std::ifstream file{path, std::ios::binary};
+  if (not file) {
+    throw std::runtime_error{"failed to read " + path.string()};
+  }
+  const std::string contents{std::istreambuf_iterator<char>{file},
+                             std::istreambuf_iterator<char>{}};
+  const auto *begin = reinterpret_cast<const std::byte *>(std::data(contents));
+  return {begin, begin + std::size(contents)};
+}
+
+auto pack(const cli_args &args) -> int {
+  const auto files = collect(args);
+  std::vector<std::vector<std::byte>> contents{};
+  std::vector<rpg::asset_archive_entry> entries{};
+  contents.reserve(std::size(files));
+  for (const auto &[name, path] : files) {
+    entries.push_back({.name = name, .bytes = contents.emplace_back(
+                                         read_file(path))});
+  }
+
+  const auto archive = rpg::pack_asset_archive(entries);
+  if (args.output.has_parent_path()) {
+    std::filesystem::create_directories(args.output.parent_path());
+  }
+  std::ofstream file{args.output, std::ios::binary};
+  file.write(reinterpret_cast<const char *>(std::data(archive)),
+             static_cast<std::streamsize>(std::size(archive)));
+  if (not file) {
+    spdlog::error("Failed to write archive: `{}`", args.output.string());
+    return 1;
+  }
+  spdlog::info("Packed {} files into {} ({} bytes)", std::size(entries),
+               args.output.string(), std::size(archive));
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  try {
+    return pack(parse_cli_args(argc, argv));
+  } catch (const std::exception &error) {
+    spdlog::error("{}", error.what());
+    return 1;
+  }
+}
@@ -0,0 +1,192 @@
+#include <rpg/atlas.hpp>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <docopt.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static constexpr auto usage = R"(
+  RPG Atlas Packer
+
+  Packs textures into atlas pages and writes a header describing where each
+  texture ended up.
+
+  Usage:
+    rpg-atlas-packer [options] --output-dir=DIR --header=FILE <texture>...
+
+  Options:
+    -h --help             Show this message
+    --output-dir=DIR      Directory to write the atlas pages to
+    --header=FILE         Header to generate
+    --page-size=SIZE      Width and height of each page [default: 2048]
+    --padding=PIXELS      Space between textures [default: 1]
+)";
+
+struct cli_args {
+  std::filesystem::path output_dir;
+  std::filesystem::path header;
+  int page_size;
+  int padding;
+  std::vector<std::filesystem::path> textures;
+};
+
+[[nodiscard]] inline auto parse_cli_args(int argc, char **argv) -> cli_args {
+  std::map<std::string, docopt::value> args =
+      docopt::docopt(usage, {std::next(argv), std::next(argv, argc)}, true,
+                     "RPG Atlas Packer 0.0.0.0");
+  cli_args result{
+      .output_dir = args["--output-dir"].asString(),
+      .header = args["--header"].asString(),
+      .page_size = static_cast<int>(args["--page-size"].asLong()),
+      .padding = static_cast<int>(args["--padding"].asLong()),
+      .textures = {},
+  };
+  for (const auto &texture : args["<texture>"].asStringList()) {
+    result.textures.emplace_back(texture);
+  }
+  // Sorted so the same textures always pack the same way.
+  std::ranges::sort(result.textures);
+  return result;
+}
+
+// survivor-idle_shotgun_0.png becomes survivor_idle_shotgun_0.
+[[nodiscard]] auto identifier(const std::filesystem::path &texture) {
+  auto name = texture.stem().string();
+  for (auto &character : name) {
+    if (std::isalnum(static_cast<unsigned char>(character)) == 0) {
+      character = '_';
+    }
+  }
+  if (name.empty() or std::isdigit(static_cast<unsigned char>(name[0])) != 0) {
+    name.insert(0, "texture_");
+  }
+  return name;
+}
+
+[[nodiscard]] auto page_path(const std::filesystem::path &output_dir,
+                             const std::size_t page) {
+  return output_dir / ("atlas_" + std::to_string(page) + ".png");
+}
+
+[[nodiscard]] auto
+generate_header(const cli_args &args,
+                const std::vector<std::string> &identifiers,
+                const std::vector<rpg::atlas_region> &regions,
+                const std::size_t page_count) -> std::string {
+  std::ostringstream header{};
+  header << "#pragma once\n\n"
+         << "// Generated by rpg-atlas-packer from textures/. Do not edit.\n\n"
+         << "#include <rpg/atlas.hpp>\n\n"
+         << "#include <array>\n\n"
+         << "namespace rpg::inline texture_atlas {\n"
+         << "inline constexpr std::array<const char *, " << page_count
+         << "> pages{\n";
+  for (std::size_t page = 0; page < page_count; ++page) {
+    header << "    \"" << page_path(args.output_dir, page).generic_string()
+           << "\",\n";
+  }
+  header << "};\n\n";
+  for (std::size_t i = 0; i < std::size(regions); ++i) {
+    const auto &region = regions[i];
+    header << "inline constexpr atlas_region " << identifiers[i]
+           << "{.page = " << region.page << ", .left = " << region.left
+           << ", .top = " << region.top << ", .width = " << region.width
+           << ", .height = " << region.height << "};\n";
+  }
+  header << "} // namespace rpg::inline texture_atlas\n";
+  return header.str();
+}
+
+void write_header(const std::filesystem::path &path,
+                  const std::string &contents) {
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream file{path, std::ios::binary};
+  file << contents;
+  if (not file) {
+    throw std::runtime_error{"failed to write " + path.string()};
+  }
+}
+
+auto pack(const cli_args &args) -> int {
+  std::vector<sf::Image> images(std::size(args.textures));
+  std::vector<rpg::atlas_size> sizes{};
+  std::vector<std::string> identifiers{};
+  std::set<std::string> seen{};
+  for (std::size_t i = 0; i < std::size(args.textures); ++i) {
+    if (not images[i].loadFromFile(args.textures[i].string())) {
+      spdlog::error("Failed to load texture: `{}`", args.textures[i].string());
+      return 1;
+    }
+    sizes.push_back({.width = static_cast<int>(images[i].getSize().x),
+                     .height = static_cast<int>(images[i].getSize().y)});
+    identifiers.push_back(identifier(args.textures[i]));
+    if (not seen.insert(identifiers.back()).second) {
+      spdlog::error("Two textures are both named `{}`", identifiers.back());
+      return 1;
+    }
+  }
+
+  const auto regions = rpg::pack_atlas(sizes, args.page_size, args.padding);
+  std::size_t page_count = 0;
+  for (const auto &region : regions) {
+    page_count = std::max<std::size_t>(page_count, region.page + 1);
+  }
+
+  std::filesystem::create_directories(args.output_dir);
+  for (std::size_t page = 0; page < page_count; ++page) {
+    // Pages are cropped to what is used on them.
+    unsigned width = 0;
+    unsigned height = 0;
+    for (const auto &region : regions) {
+      if (region.page == page) {
+        width = std::max(width, static_cast<unsigned>(region.left +
+                                                      region.width));
+        height = std::max(height, static_cast<unsigned>(region.top +
+                                                        region.height));
+      }
+    }
+    sf::Image atlas{};
+    atlas.create(width, height, sf::Color::Transparent);
+    for (std::size_t i = 0; i < std::size(regions); ++i) {
+      if (regions[i].page == page) {
+        atlas.copy(images[i], static_cast<unsigned>(regions[i].left),
+                   static_cast<unsigned>(regions[i].top));
+      }
+    }
+    const auto path = page_path(args.output_dir, page);
+    if (not atlas.saveToFile(path.string())) {
+      spdlog::error("Failed to write atlas page: `{}`", path.string());
+      return 1;
+    }
+  }
+
+  write_header(args.header,
+               generate_header(args, identifiers, regions, page_count));
+  spdlog::info("Packed {} textures into {} atlas pages", std::size(regions),
+               page_count);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  try {
+    return pack(parse_cli_args(argc, argv));
+  } catch (const std::exception &error) {
+    spdlog::error("{}", error.what());
+    return 1;
+  }
+}
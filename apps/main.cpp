@@ -1,8 +1,24 @@
 #include <rpg/action.hpp>
+#include <rpg/action_bindings.hpp>
+#include <rpg/allocations.hpp>
+#include <rpg/asset_archive.hpp>
 #include <rpg/controllers/movement.hpp>
-#include <rpg/texture_paths.hpp>
-#include <rpg/window/input.hpp>
-#include <rpg/window/keyboard_input.hpp>
+#include <rpg/game_loop.hpp>
+#include <rpg/graphics/texture_manager.hpp>
+#include <rpg/guid_generator.hpp>
+#include <rpg/jobs/frame_graph.hpp>
+#include <rpg/jobs/thread_pool.hpp>
+#include <rpg/profiler.hpp>
+#include <rpg/profiler_window.hpp>
+#include <rpg/scheduler.hpp>
+#include <rpg/slot_map.hpp>
+#include <rpg/texture_archive.hpp>
+#include <rpg/texture_atlas.hpp>
+#include <rpg/window/bitset_input.hpp>
+#include <rpg/window/event_input.hpp>
+#include <rpg/window/input_recorder.hpp>
+#include <rpg/window/input_replay.hpp>
+#include <rpg/window/key_bitset.hpp>
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
@@ -14,17 +30,51 @@
 #include <imgui.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
+
+#if defined(RPG_TRACK_ALLOCATIONS)
+#include <rpg/allocation_hook.hpp>
+#endif
 
 struct cli_args {
   std::uint32_t width;
   std::uint32_t height;
   double scale;
   std::uint32_t frame_limit;
+  std::uint32_t simulation_rate;
+  std::uint32_t max_catch_up;
+  std::optional<std::string> record;
+  bool headless;
+  std::uint64_t ticks;
+  std::uint32_t entities;
+  std::optional<std::string> replay;
+  std::uint32_t threads;
+  std::optional<std::string> trace;
+  std::optional<std::string> bindings;
 };
 
+// More headless threads than any machine this runs on has cores.
+static constexpr std::uint32_t max_threads = 256;
+// Headless entities, each of which gets a transformable, a movement
+// controller and a scheduled action; a few gigabytes' worth at most.
+static constexpr std::uint32_t max_entities = 10'000'000;
+
 static constexpr auto usage = R"(
   RPG Game
 
@@ -37,17 +87,61 @@ static constexpr auto usage = R"(
     --height=HEIGHT            Screen height in pixels [default: 1080]
     --scale=SCALE              Scale [default: 2]
     --frame-limit=FRAME LIMIT  Frame limit [default: 60]
+    --sim-rate=RATE            Simulation ticks per second [default: 120]
+    --max-catch-up=TICKS       Most simulation ticks per frame [default: 8]
+    --record=FILE              Record keyboard input to FILE
+    --headless                 Simulate without a window as fast as possible
+    --ticks=TICKS              Ticks to simulate when headless [default: 10000]
+    --entities=COUNT           Entities to simulate headless [default: 1000]
+    --replay=FILE              Drive headless input from a --record recording
+    --threads=COUNT            Threads to simulate headless on [default: 1]
+    --trace=FILE               Write profiled zones to FILE as a Chrome trace
+    --bindings=FILE            Read key bindings from FILE
 )";
 
 [[nodiscard]] inline auto parse_cli_args(int argc, char **argv) -> cli_args {
   std::map<std::string, docopt::value> args =
       docopt::docopt(usage, {std::next(argv), std::next(argv, argc)}, true,
                      "RPG Game 0.0.0.0");
+  // Values that would stop the game loop from ticking are rejected here
+  // rather than crashing later.
+  // The bounds are the type of the field the value goes into, and compared
+  // with std::cmp_* so bounds wider than long, as on Windows, still hold.
+  const auto in_range = [&]<class T>(const std::string &name, const T low,
+                                     const T high) -> T {
+    const auto value = args[name].asLong();
+    if (std::cmp_less(value, low) or std::cmp_greater(value, high)) {
+      throw std::invalid_argument{
+          std::format("{} must be between {} and {}", name, low, high)};
+    }
+    return static_cast<T>(value);
+  };
   return {
       .width = static_cast<std::uint32_t>(args["--width"].asLong()),
       .height = static_cast<std::uint32_t>(args["--height"].asLong()),
       .scale = static_cast<double>(args["--scale"].asLong()),
       .frame_limit = static_cast<std::uint32_t>(args["--frame-limit"].asLong()),
+      .simulation_rate =
+          in_range("--sim-rate", std::uint32_t{1},
+                   rpg::game_loop_settings::max_simulation_rate),
+      .max_catch_up = in_range("--max-catch-up", std::uint32_t{1},
+                               std::numeric_limits<std::uint32_t>::max()),
+      .record = args["--record"]
+                    ? std::optional{args["--record"].asString()}
+                    : std::nullopt,
+      .headless = args["--headless"].asBool(),
+      .ticks = in_range("--ticks", std::uint64_t{0},
+                        std::uint64_t{std::numeric_limits<long>::max()}),
+      .entities = in_range("--entities", std::uint32_t{0}, max_entities),
+      .replay = args["--replay"]
+                    ? std::optional{args["--replay"].asString()}
+                    : std::nullopt,
+      .threads = in_range("--threads", std::uint32_t{1}, max_threads),
+      .trace = args["--trace"] ? std::optional{args["--trace"].asString()}
+                               : std::nullopt,
+      .bindings = args["--bindings"]
+                      ? std::optional{args["--bindings"].asString()}
+                      : std::nullopt,
   };
 }
 
@@ -72,10 +166,315 @@ struct speed {
   [[nodiscard]] float rotational_movement() const noexcept { return 250.0f; }
 };
 
+[[nodiscard]] auto loop_settings(const cli_args &args)
+    -> rpg::game_loop_settings {
+  return {.simulation_rate = args.simulation_rate,
+          .max_ticks_per_frame = args.max_catch_up};
+}
+
+// The --bindings file if there is one and it reads, the defaults otherwise.
+[[nodiscard]] auto load_bindings(const cli_args &args)
+    -> rpg::action_bindings {
+  if (not args.bindings) {
+    return rpg::default_action_bindings;
+  }
+  try {
+    return rpg::load_action_bindings(*args.bindings);
+  } catch (const std::exception &error) {
+    spdlog::error("Failed to read key bindings, using the defaults: {}",
+                  error.what());
+    return rpg::default_action_bindings;
+  }
+}
+
+// Key source for headless runs without a recording. Walks through a fixed
+// script of key combinations, holding each for a while, and starts over at
+// the end.
+class scripted_keys {
+  struct step {
+    std::array<sf::Keyboard::Key, 2> keys;
+    std::uint32_t ticks;
+  };
+
+  static constexpr std::array script_{
+      step{{sf::Keyboard::Key::W, sf::Keyboard::Key::Unknown}, 240},
+      step{{sf::Keyboard::Key::E, sf::Keyboard::Key::Unknown}, 60},
+      step{{sf::Keyboard::Key::W, sf::Keyboard::Key::E}, 120},
+      step{{sf::Keyboard::Key::D, sf::Keyboard::Key::Unknown}, 120},
+      step{{sf::Keyboard::Key::A, sf::Keyboard::Key::S}, 120},
+      step{{sf::Keyboard::Key::Q, sf::Keyboard::Key::Unknown}, 90},
+      step{{sf::Keyboard::Key::Unknown, sf::Keyboard::Key::Unknown}, 30},
+  };
+
+  rpg::window::key_bitset pressed_{};
+  std::size_t step_{std::size(script_) - 1};
+  std::uint32_t ticks_left_{0};
+
+public:
+  void next() {
+    if (ticks_left_ == 0) {
+      step_ = (step_ + 1) % std::size(script_);
+      ticks_left_ = script_[step_].ticks;
+      pressed_ = {};
+      for (const auto key : script_[step_].keys) {
+        if (key != sf::Keyboard::Key::Unknown) {
+          pressed_.set(static_cast<std::size_t>(key));
+        }
+      }
+    }
+    --ticks_left_;
+  }
+
+  [[nodiscard]] const rpg::window::key_bitset &snapshot() const {
+    return pressed_;
+  }
+};
+
+// Key source for headless runs that plays back a recording, starting over
+// whenever it runs out.
+class replayed_keys {
+  std::vector<std::byte> data_;
+  std::optional<rpg::window::input_replay> replay_{};
+
+public:
+  explicit replayed_keys(std::vector<std::byte> data)
+      : data_(std::move(data)) {
+    replay_.emplace(data_);
+  }
+
+  replayed_keys(const replayed_keys &) = delete;
+  replayed_keys &operator=(const replayed_keys &) = delete;
+
+  void next() {
+    if (not replay_->next()) {
+      replay_.emplace(data_);
+      std::ignore = replay_->next();
+    }
+  }
+
+  [[nodiscard]] const rpg::window::key_bitset &snapshot() const {
+    return replay_->snapshot();
+  }
+};
+
+// Calls `action` every `period`, forever.
+struct repeating_action {
+  rpg::scheduler<rpg::guid_generator> *scheduler;
+  std::uint64_t *fired;
+  std::chrono::milliseconds period;
+
+  void operator()() const {
+    ++*fired;
+    std::ignore = scheduler->schedule(period, *this);
+  }
+};
+
+// Logs what was allocated per frame and in each allocation scope.
+void report_allocations(const rpg::allocations::frame_counter &allocations) {
+  const auto frames = static_cast<double>(std::max<std::uint64_t>(
+      allocations.frames(), 1));
+  spdlog::info("  {} allocations, {} bytes: {:.1f} allocations/frame, at "
+               "most {} in one frame",
+               allocations.overall().allocations, allocations.overall().bytes,
+               static_cast<double>(allocations.overall().allocations) / frames,
+               allocations.peak().allocations);
+  rpg::allocations::scope_table::instance().each(
+      [](const rpg::allocations::scope_totals &scope) {
+        spdlog::info("  {:<10} {:>10} allocations {:>12} bytes",
+                     scope.name, scope.counts.allocations, scope.counts.bytes);
+      });
+}
+
+// Runs input, movement and the scheduler for `args.ticks` fixed steps
+// without a window and reports how long each of them took. Each tick is a
+// frame graph: movement is split over `args.threads` threads and the
+// scheduler runs alongside it, since the two share nothing.
+template <class TKeys>
+auto run_headless(const cli_args &args, TKeys &keys) -> int {
+  using clock = std::chrono::steady_clock;
+
+  using input_type = rpg::window::bitset_input<TKeys>;
+  using movement_type = rpg::controllers::movement<input_type, detail::speed>;
+
+  input_type input{keys};
+  detail::speed speed{};
+  const auto bindings = load_bindings(args);
+  rpg::slot_map<sf::Transformable> transformables{};
+  transformables.reserve(args.entities);
+  std::vector<movement_type> movement_controllers{};
+  movement_controllers.reserve(args.entities);
+  for (std::uint32_t i = 0; i < args.entities; ++i) {
+    auto &movement_controller = movement_controllers.emplace_back(input, speed);
+    movement_controller.set_bindings(bindings);
+    movement_controller.attach(transformables, transformables.insert());
+  }
+
+  rpg::guid_generator guid{};
+  rpg::scheduler scheduler{guid};
+  scheduler.reserve(args.entities);
+  std::uint64_t fired = 0;
+  for (std::uint32_t i = 0; i < args.entities; ++i) {
+    const auto period = std::chrono::milliseconds{250 + i % 250};
+    std::ignore = scheduler.schedule(
+        period, repeating_action{.scheduler = &scheduler,
+                                 .fired = &fired,
+                                 .period = period});
+  }
+
+  const auto step = rpg::simulation_step(loop_settings(args));
+  clock::duration input_time{};
+  clock::duration movement_time{};
+  clock::duration scheduler_time{};
+  const auto timed = [](clock::duration &total, auto &&work) {
+    const auto start = clock::now();
+    work();
+    total += clock::now() - start;
+  };
+
+  rpg::jobs::thread_pool pool{args.threads - 1};
+  rpg::jobs::frame_graph graph{};
+  const auto keys_resource = graph.add_resource("input");
+  const auto transforms = graph.add_resource("transforms");
+  const auto timers = graph.add_resource("timers");
+  graph.add("input", {}, {keys_resource}, [&] {
+    RPG_PROFILE_ZONE("input");
+    RPG_ALLOCATION_SCOPE("input");
+    timed(input_time, [&] {
+      keys.next();
+      input.update(step);
+    });
+  });
+  graph.add("movement", {keys_resource}, {transforms}, [&] {
+    RPG_PROFILE_ZONE("movement");
+    RPG_ALLOCATION_SCOPE("movement");
+    timed(movement_time, [&] {
+      rpg::jobs::parallel_for(
+          pool, 0, std::size(movement_controllers), 1024,
+          [&](const std::size_t first, const std::size_t last) {
+            RPG_PROFILE_ZONE("movement range");
+            for (auto i = first; i < last; ++i) {
+              movement_controllers[i].update(step);
+            }
+          });
+    });
+  });
+  graph.add("scheduler", {}, {timers}, [&] {
+    RPG_PROFILE_ZONE("scheduler");
+    RPG_ALLOCATION_SCOPE("scheduler");
+    timed(scheduler_time, [&] { scheduler.update(step); });
+  });
+
+  rpg::allocations::frame_counter allocations{};
+  const auto start = clock::now();
+  for (std::uint64_t tick = 0; tick < args.ticks; ++tick) {
+    RPG_PROFILE_FRAME();
+    graph.run(pool);
+    allocations.mark();
+  }
+  const auto elapsed = std::chrono::duration<double>(clock::now() - start);
+
+  spdlog::info("simulated {} ticks of {} entities on {} threads in {:.3f} s: "
+               "{:.0f} ticks/sec",
+               args.ticks, args.entities, pool.concurrency(), elapsed.count(),
+               static_cast<double>(args.ticks) / elapsed.count());
+  const auto report = [&](const char *name, const clock::duration time) {
+    const auto milliseconds =
+        std::chrono::duration<double, std::milli>(time).count();
+    spdlog::info("  {:<10} {:>10.3f} ms {:>12.1f} ns/tick", name, milliseconds,
+                 milliseconds * 1e6 / static_cast<double>(args.ticks));
+  };
+  report("input", input_time);
+  report("movement", movement_time);
+  report("scheduler", scheduler_time);
+  spdlog::info("  {} scheduled actions fired", fired);
+#if defined(RPG_TRACK_ALLOCATIONS)
+  report_allocations(allocations);
+#endif
+  return 0;
+}
+
+[[nodiscard]] auto read_file(const std::string &path)
+    -> std::optional<std::vector<std::byte>> {
+  std::ifstream file{path, std::ios::binary};
+  if (not file) {
+    return std::nullopt;
+  }
+  const std::string contents{std::istreambuf_iterator<char>{file},
+                             std::istreambuf_iterator<char>{}};
+  const auto *begin = reinterpret_cast<const std::byte *>(std::data(contents));
+  return std::vector<std::byte>{begin, begin + std::size(contents)};
+}
+
+auto run_headless(const cli_args &args) -> int {
+  if (not args.replay) {
+    scripted_keys keys{};
+    return run_headless(args, keys);
+  }
+
+  auto data = read_file(*args.replay);
+  if (not data) {
+    spdlog::error("Failed to open input recording: `{}`", *args.replay);
+    return 1;
+  }
+  try {
+    replayed_keys keys{std::move(*data)};
+    return run_headless(args, keys);
+  } catch (const std::exception &error) {
+    spdlog::error("Failed to replay `{}`: {}", *args.replay, error.what());
+    return 1;
+  }
+}
+
+// Runs `write` on the --record recorder, if any, and stops recording with
+// an error once the recording can no longer be written.
+void keep_recording(std::optional<rpg::window::input_recorder> &recorder,
+                    auto &&write) {
+  if (not recorder) {
+    return;
+  }
+  try {
+    write(*recorder);
+  } catch (const std::runtime_error &error) {
+    spdlog::error("Stopped recording input: {}", error.what());
+    recorder.reset();
+  }
+}
+
+// Writes the zones the profiler still holds to the --trace file, if any.
+void write_trace(const cli_args &args) {
+  if (not args.trace) {
+    return;
+  }
+#if defined(RPG_PROFILE)
+  std::ofstream file{*args.trace};
+  rpg::profiler::instance().write_chrome_trace(file);
+  if (not file) {
+    spdlog::error("Failed to write trace: `{}`", *args.trace);
+  }
+#else
+  spdlog::warn("Not writing `{}`: zones are only recorded when built with "
+               "RPG_PROFILE=ON",
+               *args.trace);
+#endif
+}
+
 } // namespace detail
 
 int main(int argc, char **argv) {
-  const auto args = parse_cli_args(argc, argv);
+  cli_args args{};
+  try {
+    args = parse_cli_args(argc, argv);
+  } catch (const std::invalid_argument &error) {
+    spdlog::error("{}", error.what());
+    return 1;
+  }
+  if (args.headless) {
+    RPG_PROFILE_THREAD("main");
+    const auto status = detail::run_headless(args);
+    detail::write_trace(args);
+    return status;
+  }
+
   sf::RenderWindow window(sf::VideoMode(args.width, args.height),
                           "ImGui + SFML = <3");
   window.setFramerateLimit(args.frame_limit);
@@ -86,58 +485,166 @@ int main(int argc, char **argv) {
   ImGui::GetIO().FontGlobalScale = args.scale;
 
   sf::Clock deltaClock;
-  sf::Texture texture;
-
-  if (not texture.loadFromFile(rpg::texture_paths::survivor_idle_shotgun_0)) {
-    spdlog::error("Failed to load texture: `{}`",
-                  rpg::texture_paths::survivor_idle_shotgun_0);
+  // Declared before the texture manager, which decodes straight out of it.
+  std::optional<rpg::asset_archive> archive{};
+  try {
+    archive.emplace(rpg::texture_archive::path);
+  } catch (const std::exception &error) {
+    spdlog::warn("Failed to open texture archive `{}`, loading loose files: "
+                 "{}",
+                 rpg::texture_archive::path, error.what());
+  }
+  rpg::graphics::texture_manager textures{};
+  std::vector<rpg::graphics::texture_handle> pages{};
+  for (const auto *const page : rpg::texture_atlas::pages) {
+    const auto name = std::filesystem::path{page}.filename().string();
+    const auto bytes = archive ? archive->find(name) : std::nullopt;
+    pages.push_back(bytes ? textures.load(name, *bytes) : textures.load(page));
   }
+  bool reported_load = false;
 
-  sf::Sprite sprite(texture);
+  // Shows the placeholder until the page has loaded.
+  const auto &survivor = rpg::texture_atlas::survivor_idle_shotgun_0;
+  rpg::slot_map<sf::Sprite> sprites{};
+  const auto player =
+      sprites.insert(textures.get(pages[survivor.page]), survivor.rect());
+  // Only for setting it up: inserting into the pool can move it, so the
+  // loop goes through the handle.
+  auto &sprite = sprites.get(player);
   sprite.setOrigin(sprite.getTextureRect().width / 2.0,
                    sprite.getTextureRect().height / 2.0);
   spdlog::info(std::format("origin is {}, {}", sprite.getOrigin().x,
                            sprite.getOrigin().y));
 
-  rpg::window::keyboard_input keyboard_input{};
-  rpg::window::input input{keyboard_input};
+  rpg::window::event_input keyboard_input{};
+  rpg::window::bitset_input input{keyboard_input};
+  std::ofstream recording_file{};
+  std::optional<rpg::window::input_recorder> recorder{};
+  if (args.record) {
+    recording_file.open(*args.record, std::ios::binary);
+    if (recording_file) {
+      recorder.emplace(recording_file);
+    } else {
+      spdlog::error("Failed to open input recording: `{}`", *args.record);
+    }
+  }
   detail::speed speed{};
   rpg::controllers::movement movement_controller{input, speed};
-  movement_controller.attach(sprite);
-  movement_controller.map_action(rpg::action::move_forward,
-                                 sf::Keyboard::Key::W);
-  movement_controller.map_action(rpg::action::move_backward,
-                                 sf::Keyboard::Key::S);
-  movement_controller.map_action(rpg::action::move_left, sf::Keyboard::Key::A);
-  movement_controller.map_action(rpg::action::move_right, sf::Keyboard::Key::D);
-  movement_controller.map_action(rpg::action::rotate_right,
-                                 sf::Keyboard::Key::E);
-  movement_controller.map_action(rpg::action::rotate_left,
-                                 sf::Keyboard::Key::Q);
+  movement_controller.attach(sprites, player);
+  movement_controller.set_bindings(detail::load_bindings(args));
+
+  rpg::game_loop loop{detail::loop_settings(args)};
+  // The sprite is the simulated state; what gets drawn sits between its state
+  // before and after the last tick.
+  sf::Transformable previous_state{sprite};
+  sf::Sprite rendered_sprite{sprite};
+  RPG_PROFILE_THREAD("main");
+#if defined(RPG_PROFILE)
+  rpg::profiler_window profiler_window{};
+#endif
+
+  rpg::allocations::frame_counter allocations{};
 
   while (window.isOpen()) {
+    RPG_PROFILE_FRAME();
+    allocations.mark();
     sf::Event event;
     const auto delta_time = deltaClock.restart();
 
-    while (window.pollEvent(event)) {
-      ImGui::SFML::ProcessEvent(window, event);
+    {
+      RPG_PROFILE_ZONE("events");
+      while (window.pollEvent(event)) {
+        ImGui::SFML::ProcessEvent(window, event);
+        keyboard_input.process(event);
 
-      if (should_close(event)) {
-        window.close();
+        if (should_close(event)) {
+          window.close();
+        }
       }
     }
     ImGui::SFML::Update(window, delta_time);
-    input.update(delta_time);
-    movement_controller.update(delta_time);
+    {
+      RPG_PROFILE_ZONE("textures");
+      textures.update();
+    }
+    if (not reported_load and textures.stats().pending() == 0) {
+      reported_load = true;
+      for (const auto page : pages) {
+        if (textures.state(page) == rpg::graphics::texture_state::failed) {
+          spdlog::error("Failed to load texture: `{}`", textures.path(page));
+        }
+      }
+      spdlog::info("loaded {} textures in {} ms",
+                   textures.stats().loaded,
+                   textures.stats().last_load_time.asMilliseconds());
+    }
+#if defined(RPG_DEBUG)
+    ImGui::Begin("Textures");
+    ImGui::Text("Loaded: %zu/%zu, failed: %zu", textures.stats().loaded,
+                textures.stats().requested, textures.stats().failed);
+    ImGui::Text("Uploads this frame: %zu (%.3f ms, max %.3f ms)",
+                textures.stats().frame_uploads,
+                textures.stats().frame_upload_time.asSeconds() * 1000.0f,
+                textures.stats().max_frame_upload_time.asSeconds() * 1000.0f);
+    ImGui::Text("Load time: %d ms",
+                textures.stats().last_load_time.asMilliseconds());
+    ImGui::End();
+#endif
+#if defined(RPG_PROFILE)
+    profiler_window.draw();
+#endif
+#if defined(RPG_TRACK_ALLOCATIONS)
+    ImGui::Begin("Allocations");
+    ImGui::Text("Last frame: %llu allocations, %llu bytes",
+                static_cast<unsigned long long>(allocations.last().allocations),
+                static_cast<unsigned long long>(allocations.last().bytes));
+    ImGui::Text("Worst frame: %llu allocations, %llu bytes",
+                static_cast<unsigned long long>(allocations.peak().allocations),
+                static_cast<unsigned long long>(allocations.peak().bytes));
+    rpg::allocations::scope_table::instance().each(
+        [](const rpg::allocations::scope_totals &scope) {
+          ImGui::Text("%-10s %8llu allocations in %llu calls", scope.name,
+                      static_cast<unsigned long long>(
+                          scope.counts.allocations),
+                      static_cast<unsigned long long>(scope.calls));
+        });
+    ImGui::End();
+#endif
+    loop.advance(delta_time, [&](const sf::Time step) {
+      RPG_PROFILE_ZONE("simulate");
+      RPG_ALLOCATION_SCOPE("simulate");
+      previous_state = sprites.get(player);
+      input.update(step);
+      detail::keep_recording(recorder, [&](auto &into) {
+        into.record(step, keyboard_input.current());
+      });
+      movement_controller.update(step);
+    });
+    // Once per frame rather than per tick, so the window neither flickers
+    // nor repeats. Edits show straight away instead of easing in over the
+    // next tick.
+    if (movement_controller.draw_debug_window()) {
+      previous_state = sprites.get(player);
+    }
+    rpg::interpolate(previous_state, sprites.get(player), loop.alpha(),
+                     rendered_sprite);
 
-    window.clear();
-    window.draw(sprite);
-    ImGui::SFML::Render(window);
+    {
+      RPG_PROFILE_ZONE("draw");
+      window.clear();
+      window.draw(rendered_sprite);
+      ImGui::SFML::Render(window);
+    }
 
-    window.display();
+    {
+      RPG_PROFILE_ZONE("display");
+      window.display();
+    }
   }
 
   ImGui::SFML::Shutdown();
+  detail::keep_recording(recorder, [](auto &into) { into.flush(); });
+  detail::write_trace(args);
 
   return 0;
 }
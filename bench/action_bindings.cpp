@@ -0,0 +1,133 @@
+#include <rpg/action.hpp>
+#include <rpg/action_bindings.hpp>
+#include <rpg/window/key_bitset.hpp>
+#include <rpg/window/key_position.hpp>
+#include <rpg/window/key_state.hpp>
+
+#include <SFML/Window/Keyboard.hpp>
+#include <boost/container/flat_map.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <random>
+
+namespace {
+// Held keys answered the way rpg::window::bitset_input answers them, without
+// the per frame update, so only the action lookup is measured.
+struct held_keys {
+  rpg::window::key_bitset down{};
+
+  [[nodiscard]] rpg::window::key_state
+  get_key_state(const sf::Keyboard::Key key) const {
+    return {.position = down.test(static_cast<std::size_t>(key)) != 0
+                            ? rpg::window::key_position::down
+                            : rpg::window::key_position::up,
+            .seconds_in_current_position = 0};
+  }
+
+  [[nodiscard]] const rpg::window::key_bitset &down_keys() const {
+    return down;
+  }
+};
+
+// The same, but without down_keys(), so the bindings ask for each key.
+struct polled_keys {
+  held_keys keys{};
+
+  [[nodiscard]] rpg::window::key_state
+  get_key_state(const sf::Keyboard::Key key) const {
+    return keys.get_key_state(key);
+  }
+};
+
+constexpr std::array bound_keys{sf::Keyboard::Key::W, sf::Keyboard::Key::A,
+                                sf::Keyboard::Key::S, sf::Keyboard::Key::D,
+                                sf::Keyboard::Key::Q, sf::Keyboard::Key::E};
+
+// Frames of random combinations of the bound keys, plus some unbound ones.
+[[nodiscard]] auto make_frames() {
+  std::array<held_keys, 64> frames{};
+  std::mt19937 random{42};
+  std::bernoulli_distribution pressed{0.3};
+  for (auto &frame : frames) {
+    for (const auto key : bound_keys) {
+      if (pressed(random)) {
+        frame.down.set(static_cast<std::size_t>(key));
+      }
+    }
+    if (pressed(random)) {
+      frame.down.set(static_cast<std::size_t>(sf::Keyboard::Key::Space));
+    }
+  }
+  return frames;
+}
+
+// What rpg::controllers::movement did before action_bindings: one
+// flat_map find per action, then a key state query.
+void action_lookup_flat_map(benchmark::State &state) {
+  boost::container::flat_map<rpg::action, sf::Keyboard::Key> action_map{};
+  action_map[rpg::action::move_forward] = sf::Keyboard::Key::W;
+  action_map[rpg::action::move_backward] = sf::Keyboard::Key::S;
+  action_map[rpg::action::move_left] = sf::Keyboard::Key::A;
+  action_map[rpg::action::move_right] = sf::Keyboard::Key::D;
+  action_map[rpg::action::rotate_right] = sf::Keyboard::Key::E;
+  action_map[rpg::action::rotate_left] = sf::Keyboard::Key::Q;
+  const auto frames = make_frames();
+  for (auto _ : state) {
+    for (const auto &frame : frames) {
+      rpg::action_set actions = 0;
+      for (std::size_t action = 0; action < rpg::action_count; ++action) {
+        const auto iter = action_map.find(static_cast<rpg::action>(action));
+        if (iter != std::cend(action_map) and
+            rpg::window::is_down(frame.get_key_state(iter->second).position)) {
+          actions |= rpg::action_bit(static_cast<rpg::action>(action));
+        }
+      }
+      benchmark::DoNotOptimize(actions);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * std::size(frames));
+}
+
+void action_lookup_bindings_polled(benchmark::State &state) {
+  const auto bindings = rpg::default_action_bindings;
+  const auto frames = make_frames();
+  for (auto _ : state) {
+    for (const auto &frame : frames) {
+      benchmark::DoNotOptimize(bindings.actions(polled_keys{frame}));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * std::size(frames));
+}
+
+void action_lookup_bindings(benchmark::State &state) {
+  auto bindings = rpg::default_action_bindings;
+  // Keeps the bindings from being treated as constants.
+  benchmark::DoNotOptimize(bindings);
+  const auto frames = make_frames();
+  for (auto _ : state) {
+    for (const auto &frame : frames) {
+      benchmark::DoNotOptimize(bindings.actions(frame));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * std::size(frames));
+}
+
+void action_lookup_fixed(benchmark::State &state) {
+  const auto frames = make_frames();
+  for (auto _ : state) {
+    for (const auto &frame : frames) {
+      benchmark::DoNotOptimize(
+          rpg::fixed_actions<rpg::default_action_bindings>(frame.down));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * std::size(frames));
+}
+} // namespace
+
+BENCHMARK(action_lookup_flat_map);
+BENCHMARK(action_lookup_bindings_polled);
+BENCHMARK(action_lookup_bindings);
+BENCHMARK(action_lookup_fixed);
@@ -0,0 +1,222 @@
+#include <rpg/asset_archive.hpp>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Image.hpp>
+
+#include <benchmark/benchmark.h>
+
+#if not defined(RPG_OS_IS_WINDOWS)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Loading a set of textures as loose PNG files against loading them out of a
+// memory mapped asset archive. Cold runs evict the files from the page cache
+// before every iteration, so they include the disk reads; warm runs do not.
+// Eviction is not available on Windows, where the cold runs are skipped.
+//
+// The read benchmarks only fetch the bytes; the decode benchmarks also turn
+// them into sf::Images, which is what the game pays at startup.
+namespace {
+constexpr auto texture_count = 64;
+constexpr auto texture_size = 256u;
+
+class textures {
+  std::filesystem::path directory_{
+      std::filesystem::temp_directory_path() /
+      ("rpg_asset_archive_bench_" +
+       std::to_string(
+           std::chrono::steady_clock::now().time_since_epoch().count()))};
+
+  static void write_file_(const std::filesystem::path &path,
+                          const std::vector<std::byte> &bytes) {
+    std::ofstream file{path, std::ios::binary};
+    file.write(reinterpret_cast<const char *>(std::data(bytes)),
+               static_cast<std::streamsize>(std::size(bytes)));
+  }
+
+public:
+  std::vector<std::string> names{};
+  std::vector<std::filesystem::path> paths{};
+  std::filesystem::path archive{};
+
+  // Noise, so the PNGs are about as large as they can get.
+  textures() {
+    std::filesystem::create_directories(directory_);
+    std::mt19937 random{42};
+    std::uniform_int_distribution<int> channel{0, 255};
+    std::vector<std::vector<std::byte>> contents{};
+    std::vector<rpg::asset_archive_entry> entries{};
+    contents.reserve(texture_count);
+    for (auto i = 0; i < texture_count; ++i) {
+      sf::Image image{};
+      image.create(texture_size, texture_size);
+      for (auto y = 0u; y < texture_size; ++y) {
+        for (auto x = 0u; x < texture_size; ++x) {
+          image.setPixel(x, y,
+                         sf::Color(static_cast<std::uint8_t>(channel(random)),
+                                   static_cast<std::uint8_t>(channel(random)),
+                                   static_cast<std::uint8_t>(channel(random))));
+        }
+      }
+      std::vector<std::uint8_t> png{};
+      std::ignore = image.saveToMemory(png, "png");
+      const auto *begin = reinterpret_cast<const std::byte *>(std::data(png));
+      auto &bytes = contents.emplace_back(begin, begin + std::size(png));
+
+      names.push_back("texture_" + std::to_string(i) + ".png");
+      paths.push_back(directory_ / names.back());
+      write_file_(paths.back(), bytes);
+      entries.push_back({.name = names.back(), .bytes = bytes});
+    }
+    archive = directory_ / "textures.rpga";
+    write_file_(archive, rpg::pack_asset_archive(entries));
+  }
+
+  textures(const textures &) = delete;
+  textures &operator=(const textures &) = delete;
+
+  ~textures() { std::filesystem::remove_all(directory_); }
+};
+
+const textures &shared_textures() {
+  static const textures instance{};
+  return instance;
+}
+
+// Asks the OS to forget what it has cached of `path`. Returns false where
+// that is not possible.
+bool evict(const std::filesystem::path &path) {
+#if defined(RPG_OS_IS_WINDOWS)
+  std::ignore = path;
+  return false;
+#else
+  const auto file = ::open(path.c_str(), O_RDONLY);
+  if (file == -1) {
+    return false;
+  }
+  const auto evicted =
+      ::fdatasync(file) == 0 and
+      ::posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED) == 0;
+  ::close(file);
+  return evicted;
+#endif
+}
+
+// Evicts `paths` between iterations when the benchmark runs cold.
+bool prepare(benchmark::State &state,
+             const std::vector<std::filesystem::path> &paths) {
+  if (state.range(0) == 0) {
+    return true;
+  }
+  state.PauseTiming();
+  for (const auto &path : paths) {
+    if (not evict(path)) {
+      state.ResumeTiming();
+      state.SkipWithError("cannot evict files from the page cache");
+      return false;
+    }
+  }
+  state.ResumeTiming();
+  return true;
+}
+
+// One read of the whole file, as a loader that knows the size would do.
+[[nodiscard]] auto read_file(const std::filesystem::path &path) {
+  std::ifstream file{path, std::ios::binary | std::ios::ate};
+  std::vector<char> bytes(static_cast<std::size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(std::data(bytes), static_cast<std::streamsize>(std::size(bytes)));
+  return bytes;
+}
+
+// Touches one byte per page so every page of `bytes` is faulted in.
+[[nodiscard]] auto touch(const std::span<const std::byte> bytes) {
+  std::uint8_t sum = 0;
+  for (std::size_t i = 0; i < std::size(bytes); i += 4096) {
+    sum += static_cast<std::uint8_t>(bytes[i]);
+  }
+  return sum;
+}
+
+void set_items(benchmark::State &state) {
+  state.SetItemsProcessed(state.iterations() * texture_count);
+}
+} // namespace
+
+static void loose_files_read(benchmark::State &state) {
+  const auto &data = shared_textures();
+  for (auto _ : state) {
+    if (not prepare(state, data.paths)) {
+      break;
+    }
+    for (const auto &path : data.paths) {
+      benchmark::DoNotOptimize(read_file(path));
+    }
+  }
+  set_items(state);
+}
+
+BENCHMARK(loose_files_read)->ArgName("cold")->Arg(0)->Arg(1);
+
+static void archive_read(benchmark::State &state) {
+  const auto &data = shared_textures();
+  for (auto _ : state) {
+    if (not prepare(state, {data.archive})) {
+      break;
+    }
+    const rpg::asset_archive archive{data.archive};
+    for (const auto &name : data.names) {
+      benchmark::DoNotOptimize(touch(*archive.find(name)));
+    }
+  }
+  set_items(state);
+}
+
+BENCHMARK(archive_read)->ArgName("cold")->Arg(0)->Arg(1);
+
+static void loose_files_decode(benchmark::State &state) {
+  const auto &data = shared_textures();
+  for (auto _ : state) {
+    if (not prepare(state, data.paths)) {
+      break;
+    }
+    for (const auto &path : data.paths) {
+      sf::Image image{};
+      benchmark::DoNotOptimize(image.loadFromFile(path.string()));
+    }
+  }
+  set_items(state);
+}
+
+BENCHMARK(loose_files_decode)->ArgName("cold")->Arg(0)->Arg(1);
+
+static void archive_decode(benchmark::State &state) {
+  const auto &data = shared_textures();
+  for (auto _ : state) {
+    if (not prepare(state, {data.archive})) {
+      break;
+    }
+    const rpg::asset_archive archive{data.archive};
+    for (const auto &name : data.names) {
+      const auto bytes = *archive.find(name);
+      sf::Image image{};
+      benchmark::DoNotOptimize(
+          image.loadFromMemory(std::data(bytes), std::size(bytes)));
+    }
+  }
+  set_items(state);
+}
+
+BENCHMARK(archive_decode)->ArgName("cold")->Arg(0)->Arg(1);
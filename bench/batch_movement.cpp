@@ -0,0 +1,122 @@
+#include <rpg/action.hpp>
+#include <rpg/controllers/batch_movement.hpp>
+#include <rpg/controllers/movement.hpp>
+#include <rpg/window/key_position.hpp>
+#include <rpg/window/key_state.hpp>
+
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/Window/Keyboard.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+struct speed {
+  [[nodiscard]] float frontal_movement() const noexcept { return 500.0f; }
+  [[nodiscard]] float backward_movement() const noexcept { return 250.0f; }
+  [[nodiscard]] float lateral_movement() const noexcept { return 150.0f; }
+  [[nodiscard]] float rotational_movement() const noexcept { return 250.0f; }
+};
+
+// Holds W down, so every controller moves forward each frame.
+struct forward_input {
+  [[nodiscard]] rpg::window::key_state
+  get_key_state(const sf::Keyboard::Key key) const {
+    return {.position = key == sf::Keyboard::Key::W
+                            ? rpg::window::key_position::down
+                            : rpg::window::key_position::up,
+            .seconds_in_current_position = 0};
+  }
+
+  void subscribe(const sf::Keyboard::Key) {}
+  void unsubscribe(const sf::Keyboard::Key) {}
+};
+
+using controller = rpg::controllers::movement<forward_input, speed>;
+
+void movement_controllers_update(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  forward_input input{};
+  speed speed{};
+  std::vector<sf::Transformable> transformables(count);
+  std::vector<std::unique_ptr<controller>> controllers{};
+  controllers.reserve(count);
+  for (auto &transformable : transformables) {
+    auto &movement =
+        *controllers.emplace_back(std::make_unique<controller>(input, speed));
+    movement.map_action(rpg::action::move_forward, sf::Keyboard::Key::W);
+    movement.map_action(rpg::action::move_backward, sf::Keyboard::Key::S);
+    movement.map_action(rpg::action::move_left, sf::Keyboard::Key::A);
+    movement.map_action(rpg::action::move_right, sf::Keyboard::Key::D);
+    movement.map_action(rpg::action::rotate_right, sf::Keyboard::Key::E);
+    movement.map_action(rpg::action::rotate_left, sf::Keyboard::Key::Q);
+    movement.attach(transformable);
+  }
+
+  const auto frame = sf::milliseconds(16);
+  for (auto _ : state) {
+    for (auto &movement : controllers) {
+      movement->update(frame);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// `rotating_percent` of the entities rotate each frame, the rest move forward.
+// With `store` set the results are also written back to sf::Transformables,
+// which is the fair comparison with the controllers.
+void batch_movement_update(benchmark::State &state, const int rotating_percent,
+                           const bool store) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  std::vector<sf::Transformable> transformables(count);
+  rpg::controllers::batch_movement movement{};
+  movement.reserve(count);
+  std::mt19937 random{42};
+  std::uniform_int_distribution<int> percent{0, 99};
+  for (const auto &transformable : transformables) {
+    const auto index = movement.add(transformable, speed{});
+    movement.set_actions(
+        index, rpg::controllers::action_bit(
+                   percent(random) < rotating_percent
+                       ? rpg::action::rotate_right
+                       : rpg::action::move_forward));
+  }
+
+  const auto frame = sf::milliseconds(16);
+  for (auto _ : state) {
+    movement.update(frame);
+    if (store) {
+      movement.store(transformables);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+BENCHMARK(movement_controllers_update)
+    ->Arg(1'000)
+    ->Arg(100'000)
+    ->Arg(1'000'000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(batch_movement_update, forward, 0, false)
+    ->Arg(1'000)
+    ->Arg(100'000)
+    ->Arg(1'000'000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(batch_movement_update, forward_and_store, 0, true)
+    ->Arg(1'000)
+    ->Arg(100'000)
+    ->Arg(1'000'000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(batch_movement_update, ten_percent_rotating, 10, false)
+    ->Arg(1'000)
+    ->Arg(100'000)
+    ->Arg(1'000'000)
+    ->Unit(benchmark::kMicrosecond);
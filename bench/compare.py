@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""Compares Google Benchmark JSON results against a stored baseline.
+
+Both arguments are either a single file written with
+--benchmark_out_format=json or a directory of them, such as the
+bench-results directory the rpg-bench target fills. Benchmarks are matched
+by name; when a run has repetitions, its median is compared.
+
+Exits with 1 if any benchmark got slower than the threshold allows, so it
+can gate CI. Record a new baseline with the rpg-bench-baseline target.
+"""
+
+import argparse
+import json
+import pathlib
+import sys
+
+NANOSECONDS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path, metric):
+    """Maps each benchmark name to its time in nanoseconds."""
+    path = pathlib.Path(path)
+    files = sorted(path.glob("*.json")) if path.is_dir() else [path]
+    times = {}
+    medians = {}
+    for file in files:
+        with open(file, encoding="utf-8") as results:
+            benchmarks = json.load(results).get("benchmarks", [])
+        for benchmark in benchmarks:
+            if benchmark.get("error_occurred"):
+                continue
+            scale = NANOSECONDS[benchmark.get("time_unit", "ns")]
+            time = benchmark[metric] * scale
+            if benchmark.get("run_type") == "aggregate":
+                if benchmark.get("aggregate_name") == "median":
+                    medians[benchmark["run_name"]] = time
+            else:
+                times.setdefault(benchmark["name"], []).append(time)
+    merged = {name: sum(runs) / len(runs) for name, runs in times.items()}
+    merged.update(medians)
+    return merged
+
+
+def format_time(nanoseconds):
+    for unit in ("s", "ms", "us"):
+        if nanoseconds >= NANOSECONDS[unit]:
+            return f"{nanoseconds / NANOSECONDS[unit]:.3f} {unit}"
+    return f"{nanoseconds:.3f} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline", type=pathlib.Path)
+    parser.add_argument("current", type=pathlib.Path)
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.10,
+        help="slowdown that counts as a regression (default: 0.10)",
+    )
+    parser.add_argument(
+        "--metric",
+        choices=("real_time", "cpu_time"),
+        default="real_time",
+        help="time to compare (default: real_time, which multithreaded "
+        "benchmarks report)",
+    )
+    args = parser.parse_args()
+
+    if not args.baseline.exists():
+        print(f"no baseline at {args.baseline}; record one first")
+        return 0
+    baseline = load(args.baseline, args.metric)
+    current = load(args.current, args.metric)
+
+    width = max((len(name) for name in current), default=0)
+    regressions = []
+    for name, time in current.items():
+        if name not in baseline:
+            print(f"{name:<{width}}  {format_time(time):>12}  new")
+            continue
+        change = time / baseline[name] - 1.0
+        verdict = ""
+        if change > args.threshold:
+            verdict = "REGRESSION"
+            regressions.append(name)
+        elif change < -args.threshold:
+            verdict = "faster"
+        line = (
+            f"{name:<{width}}  {format_time(baseline[name]):>12} -> "
+            f"{format_time(time):>12}  {change:+7.1%}  {verdict}"
+        )
+        print(line.rstrip())
+    for name in baseline.keys() - current.keys():
+        print(f"{name:<{width}}  missing from the current results")
+
+    if regressions:
+        print(
+            f"\n{len(regressions)} of {len(current)} benchmarks are more "
+            f"than {args.threshold:.0%} slower than the baseline"
+        )
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
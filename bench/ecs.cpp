@@ -0,0 +1,176 @@
+#include <rpg/action.hpp>
+#include <rpg/controllers/batch_movement.hpp>
+#include <rpg/ecs/entity.hpp>
+#include <rpg/ecs/movement_system.hpp>
+#include <rpg/ecs/registry.hpp>
+#include <rpg/ecs/scheduled_action_system.hpp>
+
+#include <SFML/System/Time.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace {
+using registry =
+    rpg::ecs::registry<rpg::ecs::position, rpg::ecs::heading,
+                       rpg::ecs::movement_speed, rpg::ecs::movement_actions,
+                       rpg::ecs::scheduled_delay, rpg::ecs::scheduled_callback>;
+
+auto add_mover(registry &entities, std::mt19937 &random) {
+  std::uniform_int_distribution<int> action_sets{0, (1 << 6) - 1};
+  const auto id = entities.create();
+  entities.emplace<rpg::ecs::position>(id);
+  entities.emplace<rpg::ecs::heading>(id);
+  entities.emplace<rpg::ecs::movement_speed>(id, 500.0f, 250.0f, 150.0f,
+                                             250.0f);
+  entities.emplace<rpg::ecs::movement_actions>(
+      id, static_cast<rpg::controllers::action_set>(action_sets(random)));
+  return id;
+}
+
+auto fill(registry &entities, const std::size_t count) {
+  std::mt19937 random{42};
+  entities.reserve(count);
+  std::vector<rpg::ecs::entity> ids{};
+  ids.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    ids.push_back(add_mover(entities, random));
+  }
+  return ids;
+}
+} // namespace
+
+// Creates `count` entities with the four movement components and destroys
+// them all again.
+static void ecs_create_destroy(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  registry entities{};
+  std::mt19937 random{42};
+  std::vector<rpg::ecs::entity> ids(count);
+  for (auto _ : state) {
+    for (auto &id : ids) {
+      id = add_mover(entities, random);
+    }
+    for (const auto id : ids) {
+      std::ignore = entities.destroy(id);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(ecs_create_destroy)->Arg(10'000)->Arg(1'000'000);
+
+// With `count` entities alive, destroys a random 1% and creates as many new
+// ones each iteration.
+static void ecs_churn(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  registry entities{};
+  auto ids = fill(entities, count);
+  std::mt19937 random{7};
+  std::uniform_int_distribution<std::size_t> pick{0, count - 1};
+  const auto churn = count / 100;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < churn; ++i) {
+      auto &id = ids[pick(random)];
+      std::ignore = entities.destroy(id);
+      id = add_mover(entities, random);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(churn));
+}
+
+BENCHMARK(ecs_churn)->Arg(10'000)->Arg(1'000'000);
+
+// One movement update over `count` packed entities.
+static void ecs_movement_system_update(benchmark::State &state) {
+  registry entities{};
+  std::ignore = fill(entities, static_cast<std::size_t>(state.range(0)));
+  rpg::ecs::movement_system<> movement{};
+  const auto frame = sf::milliseconds(16);
+  for (auto _ : state) {
+    movement.update(entities, frame);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(ecs_movement_system_update)->Arg(10'000)->Arg(1'000'000);
+
+// The same update after 1% churn, so every frame pays for repacking.
+static void ecs_movement_system_update_with_churn(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  registry entities{};
+  auto ids = fill(entities, count);
+  rpg::ecs::movement_system<> movement{};
+  std::mt19937 random{7};
+  std::uniform_int_distribution<std::size_t> pick{0, count - 1};
+  const auto frame = sf::milliseconds(16);
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (std::size_t i = 0; i < count / 100; ++i) {
+      auto &id = ids[pick(random)];
+      std::ignore = entities.destroy(id);
+      id = add_mover(entities, random);
+    }
+    state.ResumeTiming();
+    movement.update(entities, frame);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(ecs_movement_system_update_with_churn)
+    ->Arg(10'000)
+    ->Arg(1'000'000);
+
+// Forward movement through registry::each instead of a group: one sparse
+// lookup per component per entity.
+static void ecs_each_forward(benchmark::State &state) {
+  registry entities{};
+  std::ignore = fill(entities, static_cast<std::size_t>(state.range(0)));
+  const auto seconds = sf::milliseconds(16).asSeconds();
+  for (auto _ : state) {
+    entities.each<rpg::ecs::position, rpg::ecs::heading,
+                  rpg::ecs::movement_speed>(
+        [seconds](const rpg::ecs::entity, rpg::ecs::position &position,
+                  const rpg::ecs::heading &heading,
+                  const rpg::ecs::movement_speed &speed) {
+          position.x += heading.x * speed.frontal * seconds;
+          position.y += heading.y * speed.frontal * seconds;
+        });
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(ecs_each_forward)->Arg(10'000)->Arg(1'000'000);
+
+// Counting down `count` scheduled actions that are all far in the future.
+static void ecs_scheduled_action_system_update(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  registry entities{};
+  entities.reserve(count);
+  std::uint64_t fired = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    rpg::ecs::scheduled_action_system::schedule(
+        entities, entities.create(), std::chrono::hours{24},
+        [&fired](const rpg::ecs::entity) { ++fired; });
+  }
+  rpg::ecs::scheduled_action_system scheduled{};
+  const auto frame = sf::milliseconds(16);
+  for (auto _ : state) {
+    scheduled.update(entities, frame);
+    benchmark::ClobberMemory();
+  }
+  benchmark::DoNotOptimize(fired);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(ecs_scheduled_action_system_update)->Arg(10'000)->Arg(1'000'000);
@@ -0,0 +1,35 @@
+#include <rpg/guid_generator.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace {
+void guid_generator_generate(benchmark::State &state) {
+  rpg::guid_generator generator{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(generator.generate());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Ids for `range(0)` new entities at once, crossing a block of the shared
+// sequence every 4096 ids.
+void guid_generator_generate_batch(benchmark::State &state) {
+  rpg::guid_generator generator{};
+  std::vector<rpg::guid> guids(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    for (auto &guid : guids) {
+      guid = generator.generate();
+    }
+    benchmark::DoNotOptimize(std::data(guids));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+BENCHMARK(guid_generator_generate)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(guid_generator_generate_batch)
+    ->RangeMultiplier(16)
+    ->Range(16, 65'536);
@@ -0,0 +1,136 @@
+#include <rpg/guid.hpp>
+#include <rpg/guid_generator.hpp>
+#include <rpg/guid_map.hpp>
+
+#include <boost/unordered/unordered_flat_map.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+using value_type = std::uint64_t;
+using std_map = std::unordered_map<rpg::guid, value_type, rpg::guid_hash>;
+using boost_map =
+    boost::unordered_flat_map<rpg::guid, value_type, rpg::guid_hash>;
+using rpg_map = rpg::guid_map<value_type>;
+
+template <class TMap>
+void insert(TMap &map, const rpg::guid &key, const value_type value) {
+  map.emplace(key, value);
+}
+
+void insert(rpg_map &map, const rpg::guid &key, const value_type value) {
+  std::ignore = map.try_emplace(key, value);
+}
+
+template <class TMap>
+[[nodiscard]] const value_type *lookup(const TMap &map, const rpg::guid &key) {
+  const auto iter = map.find(key);
+  return iter == std::cend(map) ? nullptr : &iter->second;
+}
+
+[[nodiscard]] const value_type *lookup(const rpg_map &map,
+                                       const rpg::guid &key) {
+  return map.find(key);
+}
+
+[[nodiscard]] auto make_keys(const std::size_t count) {
+  rpg::guid_generator generator{};
+  std::vector<rpg::guid> keys(count);
+  for (auto &key : keys) {
+    key = generator.generate();
+  }
+  return keys;
+}
+
+template <class TMap> void guid_map_insert(benchmark::State &state) {
+  const auto keys = make_keys(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    TMap map{};
+    for (std::size_t i = 0; i < std::size(keys); ++i) {
+      insert(map, keys[i], i);
+    }
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class TMap> void guid_map_find_hit(benchmark::State &state) {
+  auto keys = make_keys(static_cast<std::size_t>(state.range(0)));
+  TMap map{};
+  for (std::size_t i = 0; i < std::size(keys); ++i) {
+    insert(map, keys[i], i);
+  }
+  std::ranges::shuffle(keys, std::mt19937{42});
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lookup(map, keys[i]));
+    if (++i == std::size(keys)) {
+      i = 0;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class TMap> void guid_map_find_miss(benchmark::State &state) {
+  const auto keys = make_keys(static_cast<std::size_t>(state.range(0)));
+  const auto misses = make_keys(static_cast<std::size_t>(state.range(0)));
+  TMap map{};
+  for (std::size_t i = 0; i < std::size(keys); ++i) {
+    insert(map, keys[i], i);
+  }
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lookup(map, misses[i]));
+    if (++i == std::size(misses)) {
+      i = 0;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class TMap> void guid_map_erase_insert(benchmark::State &state) {
+  auto keys = make_keys(static_cast<std::size_t>(state.range(0)));
+  TMap map{};
+  for (std::size_t i = 0; i < std::size(keys); ++i) {
+    insert(map, keys[i], i);
+  }
+  rpg::guid_generator generator{};
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    map.erase(keys[i]);
+    keys[i] = generator.generate();
+    insert(map, keys[i], i);
+    if (++i == std::size(keys)) {
+      i = 0;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+} // namespace
+
+#define RPG_GUID_MAP_BENCHMARK(name)                                           \
+  BENCHMARK_TEMPLATE(name, std_map)                                            \
+      ->RangeMultiplier(10)                                                    \
+      ->Range(10'000, 10'000'000);                                             \
+  BENCHMARK_TEMPLATE(name, boost_map)                                          \
+      ->RangeMultiplier(10)                                                    \
+      ->Range(10'000, 10'000'000);                                             \
+  BENCHMARK_TEMPLATE(name, rpg_map)                                            \
+      ->RangeMultiplier(10)                                                    \
+      ->Range(10'000, 10'000'000)
+
+RPG_GUID_MAP_BENCHMARK(guid_map_insert)->Unit(benchmark::kMillisecond);
+RPG_GUID_MAP_BENCHMARK(guid_map_find_hit);
+RPG_GUID_MAP_BENCHMARK(guid_map_find_miss);
+RPG_GUID_MAP_BENCHMARK(guid_map_erase_insert);
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <rpg/guid.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+namespace rpg::bench {
+struct sequential_guid {
+  std::uint64_t next{0};
+
+  [[nodiscard]] rpg::guid generate() noexcept {
+    rpg::guid guid{};
+    ++next;
+    std::memcpy(std::data(guid) + sizeof(next), &next, sizeof(next));
+    return guid;
+  }
+};
+} // namespace rpg::bench
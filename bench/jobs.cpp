@@ -0,0 +1,152 @@
+#include <rpg/action.hpp>
+#include <rpg/controllers/batch_movement.hpp>
+#include <rpg/jobs/frame_graph.hpp>
+#include <rpg/jobs/thread_pool.hpp>
+#include <rpg/scheduler.hpp>
+
+#include <rpg/bench/sequential_guid.hpp>
+
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <thread>
+#include <tuple>
+
+namespace {
+struct speed {
+  [[nodiscard]] float frontal_movement() const noexcept { return 500.0f; }
+  [[nodiscard]] float backward_movement() const noexcept { return 250.0f; }
+  [[nodiscard]] float lateral_movement() const noexcept { return 150.0f; }
+  [[nodiscard]] float rotational_movement() const noexcept { return 250.0f; }
+};
+
+// Grain for movement ranges: big enough that handing out a chunk costs
+// nothing next to updating it, small enough to balance across threads.
+constexpr std::size_t movement_grain = 16'384;
+
+// 10% of the entities rotate, the rest move forward.
+auto make_movement(const std::size_t count) {
+  rpg::controllers::batch_movement movement{};
+  movement.reserve(count);
+  std::mt19937 random{42};
+  std::uniform_int_distribution<int> percent{0, 99};
+  const sf::Transformable transformable{};
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto index = movement.add(transformable, speed{});
+    movement.set_actions(index, rpg::controllers::action_bit(
+                                    percent(random) < 10
+                                        ? rpg::action::rotate_right
+                                        : rpg::action::move_forward));
+  }
+  return movement;
+}
+
+// Calls `action` every `period`, forever.
+struct repeating_action {
+  rpg::scheduler<rpg::bench::sequential_guid> *scheduler;
+  std::chrono::milliseconds period;
+
+  void operator()() const { std::ignore = scheduler->schedule(period, *this); }
+};
+
+// Thread counts from 1 up to every core, doubling, plus every core itself.
+void thread_counts(benchmark::internal::Benchmark *benchmark) {
+  const auto cores =
+      static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u));
+  for (auto threads = 1; threads < cores; threads *= 2) {
+    benchmark->Arg(threads);
+  }
+  benchmark->Arg(cores);
+}
+
+// Submitting and waiting for `range(0)` empty tasks on every core.
+void thread_pool_submit_wait(benchmark::State &state) {
+  rpg::jobs::thread_pool pool{};
+  std::deque<rpg::jobs::task> tasks(static_cast<std::size_t>(state.range(0)));
+  for (auto &task : tasks) {
+    task.work = [] {};
+  }
+  for (auto _ : state) {
+    rpg::jobs::task_counter counter{};
+    for (auto &task : tasks) {
+      pool.submit(task, counter);
+    }
+    pool.wait(counter);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// One batch_movement update of a million entities on `range(0)` threads.
+void parallel_batch_movement_update(benchmark::State &state) {
+  constexpr std::size_t count = 1'000'000;
+  rpg::jobs::thread_pool pool{static_cast<std::size_t>(state.range(0)) - 1};
+  auto movement = make_movement(count);
+  const auto frame = sf::milliseconds(16);
+  for (auto _ : state) {
+    rpg::jobs::parallel_for(
+        pool, 0, count, movement_grain,
+        [&](const std::size_t first, const std::size_t last) {
+          movement.update(frame, first, last);
+        });
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+// A frame of a million moving entities and ten thousand repeating scheduled
+// actions on `range(0)` threads. The scheduler runs alongside movement since
+// the two share nothing.
+void frame_graph_movement_and_scheduler(benchmark::State &state) {
+  constexpr std::size_t count = 1'000'000;
+  constexpr auto action_count = 10'000;
+  rpg::jobs::thread_pool pool{static_cast<std::size_t>(state.range(0)) - 1};
+  auto movement = make_movement(count);
+  rpg::bench::sequential_guid guid{};
+  rpg::scheduler scheduler{guid};
+  scheduler.reserve(action_count);
+  for (auto i = 0; i < action_count; ++i) {
+    const auto period = std::chrono::milliseconds{250 + i % 250};
+    std::ignore = scheduler.schedule(
+        period, repeating_action{.scheduler = &scheduler, .period = period});
+  }
+
+  const auto frame = sf::milliseconds(16);
+  rpg::jobs::frame_graph graph{};
+  const auto transforms = graph.add_resource("transforms");
+  const auto timers = graph.add_resource("timers");
+  graph.add("movement", {}, {transforms}, [&] {
+    rpg::jobs::parallel_for(
+        pool, 0, count, movement_grain,
+        [&](const std::size_t first, const std::size_t last) {
+          movement.update(frame, first, last);
+        });
+  });
+  graph.add("scheduler", {}, {timers}, [&] { scheduler.update(frame); });
+
+  for (auto _ : state) {
+    graph.run(pool);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+} // namespace
+
+BENCHMARK(thread_pool_submit_wait)->Arg(64)->Arg(1'024)->UseRealTime();
+BENCHMARK(parallel_batch_movement_update)
+    ->Apply(thread_counts)
+    ->ArgName("threads")
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(frame_graph_movement_and_scheduler)
+    ->Apply(thread_counts)
+    ->ArgName("threads")
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
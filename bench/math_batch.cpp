@@ -0,0 +1,147 @@
+#include <rpg/math.hpp>
+#include <rpg/math/batch.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+[[nodiscard]] auto random_values(const std::size_t count, const float min,
+                                 const float max) {
+  std::mt19937 random{42};
+  std::uniform_real_distribution<float> values{min, max};
+  std::vector<float> result(count);
+  for (auto &value : result) {
+    value = values(random);
+  }
+  return result;
+}
+
+// rpg::math::rotate_vector one angle at a time, as the controllers do today.
+void math_rotate_vector(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const auto degrees = random_values(count, 0.0f, 360.0f);
+  std::vector<float> x(count);
+  std::vector<float> y(count);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto direction = rpg::math::rotate_vector(degrees[i]);
+      x[i] = direction.x;
+      y[i] = direction.y;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void batch_rotate_vector(benchmark::State &state,
+                         const rpg::math::batch::isa isa) {
+  if (rpg::math::batch::detect_isa() < isa) {
+    state.SkipWithError("not supported by this CPU");
+    return;
+  }
+  const auto &kernels = rpg::math::batch::kernels_for(isa);
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const auto degrees = random_values(count, 0.0f, 360.0f);
+  std::vector<float> x(count);
+  std::vector<float> y(count);
+  for (auto _ : state) {
+    kernels.rotate_vector(std::data(degrees), std::data(x), std::data(y),
+                          count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void math_left(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const auto x = random_values(count, -1.0f, 1.0f);
+  const auto y = random_values(count, -1.0f, 1.0f);
+  std::vector<float> left_x(count);
+  std::vector<float> left_y(count);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto left = rpg::math::left(sf::Vector2f{x[i], y[i]});
+      left_x[i] = left.x;
+      left_y[i] = left.y;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void batch_left(benchmark::State &state, const rpg::math::batch::isa isa) {
+  if (rpg::math::batch::detect_isa() < isa) {
+    state.SkipWithError("not supported by this CPU");
+    return;
+  }
+  const auto &kernels = rpg::math::batch::kernels_for(isa);
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const auto x = random_values(count, -1.0f, 1.0f);
+  const auto y = random_values(count, -1.0f, 1.0f);
+  std::vector<float> left_x(count);
+  std::vector<float> left_y(count);
+  for (auto _ : state) {
+    kernels.left(std::data(x), std::data(y), std::data(left_x),
+                 std::data(left_y), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void math_degrees_to_radians(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const auto degrees = random_values(count, 0.0f, 360.0f);
+  std::vector<float> radians(count);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < count; ++i) {
+      radians[i] =
+          static_cast<float>(rpg::math::degrees_to_radians(degrees[i]));
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void batch_degrees_to_radians(benchmark::State &state,
+                              const rpg::math::batch::isa isa) {
+  if (rpg::math::batch::detect_isa() < isa) {
+    state.SkipWithError("not supported by this CPU");
+    return;
+  }
+  const auto &kernels = rpg::math::batch::kernels_for(isa);
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const auto degrees = random_values(count, 0.0f, 360.0f);
+  std::vector<float> radians(count);
+  for (auto _ : state) {
+    kernels.scale(std::data(degrees),
+                  rpg::math::batch::detail::radians_per_degree,
+                  std::data(radians), count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+#define RPG_MATH_BATCH_BENCHMARK(name)                                         \
+  BENCHMARK(math_##name)->Arg(1'000)->Arg(64'000)->Arg(1'000'000);             \
+  BENCHMARK_CAPTURE(batch_##name, scalar, rpg::math::batch::isa::scalar)       \
+      ->Arg(1'000)                                                             \
+      ->Arg(64'000)                                                            \
+      ->Arg(1'000'000);                                                        \
+  BENCHMARK_CAPTURE(batch_##name, sse2, rpg::math::batch::isa::sse2)           \
+      ->Arg(1'000)                                                             \
+      ->Arg(64'000)                                                            \
+      ->Arg(1'000'000);                                                        \
+  BENCHMARK_CAPTURE(batch_##name, avx2, rpg::math::batch::isa::avx2)           \
+      ->Arg(1'000)                                                             \
+      ->Arg(64'000)                                                            \
+      ->Arg(1'000'000)
+
+RPG_MATH_BATCH_BENCHMARK(rotate_vector);
+RPG_MATH_BATCH_BENCHMARK(left);
+RPG_MATH_BATCH_BENCHMARK(degrees_to_radians);
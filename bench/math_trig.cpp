@@ -0,0 +1,38 @@
+#include <rpg/math/trig.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+template <class TTrig> void rotate_vector(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  std::mt19937 random{42};
+  std::uniform_real_distribution<float> angles{0.0f, 360.0f};
+  std::vector<float> degrees(count);
+  for (auto &angle : degrees) {
+    angle = angles(random);
+  }
+  std::vector<float> x(count);
+  std::vector<float> y(count);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto direction = TTrig::rotate_vector(degrees[i]);
+      x[i] = direction.x;
+      y[i] = direction.y;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+BENCHMARK_TEMPLATE(rotate_vector, rpg::math::std_trig)->Arg(1'000)->Arg(64'000);
+BENCHMARK_TEMPLATE(rotate_vector, rpg::math::sincos_table<256>)
+    ->Arg(1'000)
+    ->Arg(64'000);
+BENCHMARK_TEMPLATE(rotate_vector, rpg::math::sincos_table<4096>)
+    ->Arg(1'000)
+    ->Arg(64'000);
@@ -0,0 +1,72 @@
+#define RPG_PROFILE 1
+#include <rpg/profiler.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace {
+// What the loop costs without a zone in it.
+void empty_scope(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::ClobberMemory();
+  }
+}
+
+void profile_clock_now(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rpg::profile_clock::now());
+  }
+}
+
+void steady_clock_now(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::chrono::steady_clock::now());
+  }
+}
+
+// A whole zone: two timestamps and a slot written into the thread's ring.
+void profile_zone(benchmark::State &state) {
+  for (auto _ : state) {
+    RPG_PROFILE_ZONE("zone");
+    benchmark::ClobberMemory();
+  }
+}
+
+void nested_profile_zones(benchmark::State &state) {
+  for (auto _ : state) {
+    RPG_PROFILE_ZONE("outer");
+    {
+      RPG_PROFILE_ZONE("inner");
+      benchmark::ClobberMemory();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+
+// Copying out a full ring, which the timeline does every frame.
+void profiler_collect(benchmark::State &state) {
+  auto &profiler = rpg::profiler::instance();
+  profiler.clear();
+  for (std::size_t i = 0; i < rpg::profiler::ring_size; ++i) {
+    RPG_PROFILE_ZONE("zone");
+  }
+  std::vector<rpg::profile_zone> zones{};
+  for (auto _ : state) {
+    zones.clear();
+    profiler.collect(zones);
+    benchmark::DoNotOptimize(std::data(zones));
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(std::size(zones)));
+}
+} // namespace
+
+BENCHMARK(empty_scope);
+BENCHMARK(profile_clock_now);
+BENCHMARK(steady_clock_now);
+BENCHMARK(profile_zone);
+BENCHMARK(nested_profile_zones);
+BENCHMARK(profiler_collect)->Unit(benchmark::kMicrosecond);
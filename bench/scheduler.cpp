@@ -0,0 +1,85 @@
+#include <rpg/scheduled_action.hpp>
+#include <rpg/scheduler.hpp>
+
+#include <rpg/bench/sequential_guid.hpp>
+
+#include <SFML/System/Time.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+// Pending actions are spread over a day, a month out, so that no benchmark run
+// gets far enough to fire them and every iteration measures pure tick cost.
+auto far_future(std::mt19937 &random) {
+  std::uniform_int_distribution<std::int64_t> seconds{0, 24 * 60 * 60};
+  return std::chrono::days{30} + std::chrono::seconds{seconds(random)};
+}
+
+void scheduler_update_with_pending_actions(benchmark::State &state) {
+  rpg::bench::sequential_guid guid{};
+  rpg::scheduler scheduler{guid};
+  std::mt19937 random{42};
+  for (auto i = 0; i < state.range(0); ++i) {
+    std::ignore = scheduler.schedule(far_future(random), [] {});
+  }
+
+  const auto frame = sf::milliseconds(16);
+  for (auto _ : state) {
+    scheduler.update(frame);
+  }
+  state.counters["pending"] = static_cast<double>(scheduler.size());
+}
+
+void scheduler_update_firing_per_frame(benchmark::State &state) {
+  rpg::bench::sequential_guid guid{};
+  rpg::scheduler scheduler{guid};
+  std::mt19937 random{42};
+  for (auto i = 0; i < state.range(0); ++i) {
+    std::ignore = scheduler.schedule(far_future(random), [] {});
+  }
+
+  constexpr auto fired_per_frame = 64;
+  const auto frame = sf::milliseconds(16);
+  std::int64_t fired = 0;
+  for (auto _ : state) {
+    for (auto i = 0; i < fired_per_frame; ++i) {
+      std::ignore = scheduler.schedule(std::chrono::milliseconds{16 - i % 16},
+                                       [&fired] { ++fired; });
+    }
+    scheduler.update(frame);
+  }
+  benchmark::DoNotOptimize(fired);
+  state.SetItemsProcessed(fired);
+}
+
+void scheduled_action_polling(benchmark::State &state) {
+  rpg::bench::sequential_guid guid{};
+  std::mt19937 random{42};
+  const auto action = [] {};
+  std::vector<rpg::scheduled_action<decltype(action)>> actions{};
+  actions.reserve(static_cast<std::size_t>(state.range(0)));
+  for (auto i = 0; i < state.range(0); ++i) {
+    actions.emplace_back(guid, far_future(random), auto{action});
+  }
+
+  const auto frame = sf::milliseconds(16);
+  for (auto _ : state) {
+    for (auto &scheduled : actions) {
+      scheduled.update(frame);
+    }
+  }
+}
+} // namespace
+
+BENCHMARK(scheduler_update_with_pending_actions)
+    ->RangeMultiplier(10)
+    ->Range(100, 1'000'000);
+BENCHMARK(scheduler_update_firing_per_frame)
+    ->RangeMultiplier(10)
+    ->Range(100, 1'000'000);
+BENCHMARK(scheduled_action_polling)->RangeMultiplier(10)->Range(100, 1'000'000);
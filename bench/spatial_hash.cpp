@@ -0,0 +1,211 @@
+#include <rpg/spatial_hash.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace {
+constexpr auto cell_size = 64.0f;
+constexpr auto radius = 32.0f;
+constexpr std::size_t query_count = 1024;
+
+// Spreads `count` points over a square sized for about four points per
+// cell whatever the count, so only the number of points changes.
+auto random_points(const std::size_t count, const unsigned seed) {
+  const auto extent =
+      std::sqrt(static_cast<float>(count) / 4.0f) * cell_size;
+  std::mt19937 random{seed};
+  std::uniform_real_distribution<float> coordinate{0.0f, extent};
+  std::vector<sf::Vector2f> points(count);
+  for (auto &point : points) {
+    point = {coordinate(random), coordinate(random)};
+  }
+  return points;
+}
+
+auto make_grid(const std::span<const sf::Vector2f> points) {
+  rpg::spatial_hash grid{{.cell_size = cell_size,
+                          .bucket_count = static_cast<std::uint32_t>(
+                              std::size(points) / 2)}};
+  grid.reserve(std::size(points));
+  for (std::size_t id = 0; id < std::size(points); ++id) {
+    grid.insert(static_cast<std::uint32_t>(id), points[id]);
+  }
+  return grid;
+}
+
+auto within(const sf::Vector2f a, const sf::Vector2f b) {
+  const auto offset = a - b;
+  return offset.x * offset.x + offset.y * offset.y <= radius * radius;
+}
+
+// Every pair of points checked against every other: the O(N^2) baseline.
+void brute_force_pairs(benchmark::State &state) {
+  const auto points = random_points(static_cast<std::size_t>(state.range(0)),
+                                    42);
+  for (auto _ : state) {
+    std::size_t pairs = 0;
+    for (std::size_t first = 0; first < std::size(points); ++first) {
+      for (auto second = first + 1; second < std::size(points); ++second) {
+        pairs += within(points[first], points[second]) ? 1 : 0;
+      }
+    }
+    benchmark::DoNotOptimize(pairs);
+    state.counters["pairs"] = static_cast<double>(pairs);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void spatial_hash_pairs(benchmark::State &state) {
+  const auto points = random_points(static_cast<std::size_t>(state.range(0)),
+                                    42);
+  const auto grid = make_grid(points);
+  for (auto _ : state) {
+    std::size_t pairs = 0;
+    grid.each_pair(radius, [&pairs](std::uint32_t, std::uint32_t) {
+      ++pairs;
+    });
+    benchmark::DoNotOptimize(pairs);
+    state.counters["pairs"] = static_cast<double>(pairs);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// query_count radius queries spread over the same area as the points, each
+// scanning every point.
+void brute_force_queries(benchmark::State &state) {
+  const auto points = random_points(static_cast<std::size_t>(state.range(0)),
+                                    42);
+  auto centers = random_points(static_cast<std::size_t>(state.range(0)), 7);
+  centers.resize(query_count);
+  std::vector<std::uint32_t> ids{};
+  for (auto _ : state) {
+    ids.clear();
+    for (const auto center : centers) {
+      for (std::size_t id = 0; id < std::size(points); ++id) {
+        if (within(points[id], center)) {
+          ids.push_back(static_cast<std::uint32_t>(id));
+        }
+      }
+    }
+    benchmark::DoNotOptimize(std::data(ids));
+  }
+  state.SetItemsProcessed(state.iterations() * query_count);
+}
+
+// The same queries as one batch against the grid.
+void spatial_hash_queries(benchmark::State &state) {
+  const auto points = random_points(static_cast<std::size_t>(state.range(0)),
+                                    42);
+  auto centers = random_points(static_cast<std::size_t>(state.range(0)), 7);
+  centers.resize(query_count);
+  const auto grid = make_grid(points);
+  std::vector<std::uint32_t> ids{};
+  std::vector<std::size_t> offsets{};
+  for (auto _ : state) {
+    grid.query_radius(centers, radius, ids, offsets);
+    benchmark::DoNotOptimize(std::data(ids));
+  }
+  state.SetItemsProcessed(state.iterations() * query_count);
+}
+
+// One tick of every point moving 8 pixels, what a character at 500 pixels
+// per second covers in a 60 Hz frame. Points go back and forth so the grid
+// settles into a steady state, and only those crossing into another cell
+// change buckets.
+void spatial_hash_update(benchmark::State &state) {
+  auto points = random_points(static_cast<std::size_t>(state.range(0)), 42);
+  auto grid = make_grid(points);
+  std::mt19937 random{3};
+  std::uniform_real_distribution<float> angle{0.0f, 6.2831853f};
+  std::vector<sf::Vector2f> velocities(std::size(points));
+  for (auto &velocity : velocities) {
+    const auto direction = angle(random);
+    velocity = {8.0f * std::cos(direction), 8.0f * std::sin(direction)};
+  }
+  const auto tick = [&] {
+    for (std::size_t i = 0; i < std::size(points); ++i) {
+      points[i] += velocities[i];
+      velocities[i] = -velocities[i];
+    }
+  };
+  for (auto warm_up = 0; warm_up < 2; ++warm_up) {
+    tick();
+    grid.update(points);
+  }
+
+  std::ignore = grid.take_rebucketed();
+  for (auto _ : state) {
+    state.PauseTiming();
+    tick();
+    state.ResumeTiming();
+    grid.update(points);
+  }
+  state.counters["rebucketed"] =
+      benchmark::Counter(static_cast<double>(grid.take_rebucketed()) /
+                             static_cast<double>(std::size(points)),
+                         benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Rebuilding the grid from scratch each tick instead.
+void spatial_hash_rebuild(benchmark::State &state) {
+  const auto points =
+      random_points(static_cast<std::size_t>(state.range(0)), 42);
+  auto grid = make_grid(points);
+  for (auto _ : state) {
+    grid.clear();
+    for (std::size_t id = 0; id < std::size(points); ++id) {
+      grid.insert(static_cast<std::uint32_t>(id), points[id]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+// 500k points would be 1.25e11 pair checks, over a minute per iteration, so
+// brute force pairs stop at 100k.
+BENCHMARK(brute_force_pairs)
+    ->Arg(10'000)
+    ->Arg(50'000)
+    ->Arg(100'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(spatial_hash_pairs)
+    ->Arg(10'000)
+    ->Arg(50'000)
+    ->Arg(100'000)
+    ->Arg(500'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(brute_force_queries)
+    ->Arg(10'000)
+    ->Arg(50'000)
+    ->Arg(100'000)
+    ->Arg(500'000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(spatial_hash_queries)
+    ->Arg(10'000)
+    ->Arg(50'000)
+    ->Arg(100'000)
+    ->Arg(500'000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(spatial_hash_update)
+    ->Arg(10'000)
+    ->Arg(50'000)
+    ->Arg(100'000)
+    ->Arg(500'000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(spatial_hash_rebuild)
+    ->Arg(10'000)
+    ->Arg(50'000)
+    ->Arg(100'000)
+    ->Arg(500'000)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,169 @@
+#include <rpg/graphics/sprite_batch.hpp>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+// The draw benchmarks render into an offscreen sf::RenderTexture, so they
+// only need an OpenGL context, not a visible window. On a Linux box without a
+// GPU they run on Mesa's llvmpipe rasteriser with
+//
+//   xvfb-run env LIBGL_ALWAYS_SOFTWARE=1 ./sprite_batch_bench
+//
+// The update benchmarks do not touch OpenGL at all.
+namespace {
+constexpr auto width = 1920u;
+constexpr auto height = 1080u;
+constexpr auto texture_count = 4;
+const sf::IntRect sprite_rect{0, 0, 32, 32};
+
+// `count` positions scattered over the render target.
+[[nodiscard]] auto scatter(const std::size_t count) {
+  std::mt19937 random{42};
+  std::uniform_real_distribution<float> x{0.0f, width};
+  std::uniform_real_distribution<float> y{0.0f, height};
+  std::uniform_real_distribution<float> rotation{0.0f, 360.0f};
+  std::vector<sf::Transformable> transformables(count);
+  for (auto &transformable : transformables) {
+    transformable.setPosition(x(random), y(random));
+    transformable.setRotation(rotation(random));
+    transformable.setOrigin(16.0f, 16.0f);
+  }
+  return transformables;
+}
+
+// Moves the first `percent` of the entities by a pixel.
+[[nodiscard]] auto moving_count(const benchmark::State &state) {
+  return static_cast<std::size_t>(state.range(0) * state.range(1) / 100);
+}
+
+struct scene {
+  sf::RenderTexture target{};
+  std::array<sf::Texture, texture_count> textures{};
+
+  [[nodiscard]] bool create() {
+    if (not target.create(width, height)) {
+      return false;
+    }
+    for (auto &texture : textures) {
+      if (not texture.create(32, 32)) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+void sprite_batch_update(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const auto moving = moving_count(state);
+  const std::array<sf::Texture, texture_count> textures{};
+  auto transformables = scatter(count);
+  rpg::graphics::sprite_batch batch{};
+  std::vector<rpg::graphics::sprite_handle> handles{};
+  handles.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    handles.push_back(batch.add(textures[i % texture_count], sprite_rect,
+                                transformables[i]));
+  }
+  batch.update();
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < moving; ++i) {
+      transformables[i].move(1.0f, 0.0f);
+      batch.mark_dirty(handles[i]);
+    }
+    batch.update();
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void draw_sprites_individually(benchmark::State &state) {
+  scene scene{};
+  if (not scene.create()) {
+    state.SkipWithError("could not create an OpenGL render texture");
+    return;
+  }
+  const auto moving = moving_count(state);
+  const auto transformables = scatter(static_cast<std::size_t>(state.range(0)));
+  std::vector<sf::Sprite> sprites{};
+  sprites.reserve(std::size(transformables));
+  for (std::size_t i = 0; i < std::size(transformables); ++i) {
+    auto &sprite = sprites.emplace_back(scene.textures[i % texture_count],
+                                        sprite_rect);
+    sprite.setPosition(transformables[i].getPosition());
+    sprite.setRotation(transformables[i].getRotation());
+    sprite.setOrigin(16.0f, 16.0f);
+  }
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < moving; ++i) {
+      sprites[i].move(1.0f, 0.0f);
+    }
+    scene.target.clear();
+    for (const auto &sprite : sprites) {
+      scene.target.draw(sprite);
+    }
+    scene.target.display();
+  }
+  state.counters["draw_calls"] = static_cast<double>(std::size(sprites));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void draw_sprite_batch(benchmark::State &state) {
+  scene scene{};
+  if (not scene.create()) {
+    state.SkipWithError("could not create an OpenGL render texture");
+    return;
+  }
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const auto moving = moving_count(state);
+  auto transformables = scatter(count);
+  rpg::graphics::sprite_batch batch{};
+  std::vector<rpg::graphics::sprite_handle> handles{};
+  handles.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    handles.push_back(batch.add(scene.textures[i % texture_count],
+                                sprite_rect, transformables[i]));
+  }
+  batch.update();
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < moving; ++i) {
+      transformables[i].move(1.0f, 0.0f);
+      batch.mark_dirty(handles[i]);
+    }
+    batch.update();
+    scene.target.clear();
+    scene.target.draw(batch);
+    scene.target.display();
+  }
+  state.counters["draw_calls"] = static_cast<double>(batch.draw_calls());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+// Arguments are the sprite count and the percentage of sprites that move
+// each frame.
+BENCHMARK(sprite_batch_update)
+    ->Args({50'000, 0})
+    ->Args({50'000, 10})
+    ->Args({50'000, 100})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(draw_sprites_individually)
+    ->Args({50'000, 10})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(draw_sprite_batch)
+    ->Args({50'000, 10})
+    ->Args({50'000, 100})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,127 @@
+#include <rpg/window/bitset_input.hpp>
+#include <rpg/window/event_input.hpp>
+#include <rpg/window/input.hpp>
+#include <rpg/window/key_position.hpp>
+
+#include <SFML/System/Time.hpp>
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Keyboard.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+// Stands in for sf::Keyboard so the benchmark measures bookkeeping rather than
+// the system key query both backends share.
+struct fake_keyboard {
+  std::array<bool, sf::Keyboard::KeyCount> pressed{};
+
+  [[nodiscard]] bool is_key_pressed(const sf::Keyboard::Key key) const {
+    return pressed[key];
+  }
+};
+
+[[nodiscard]] auto make_keyboard() {
+  fake_keyboard keyboard{};
+  std::mt19937 random{42};
+  std::bernoulli_distribution pressed{0.5};
+  for (auto &key : keyboard.pressed) {
+    key = pressed(random);
+  }
+  return keyboard;
+}
+
+template <template <class> class TWindowInput>
+void window_input_update(benchmark::State &state) {
+  auto keyboard = make_keyboard();
+  TWindowInput<fake_keyboard> input{keyboard};
+  for (auto key = 0; key < state.range(0); ++key) {
+    input.subscribe(static_cast<sf::Keyboard::Key>(key));
+  }
+
+  const auto frame = sf::milliseconds(16);
+  benchmark::DoNotOptimize(input);
+  auto i = 0;
+  for (auto _ : state) {
+    keyboard.pressed[i] = not keyboard.pressed[i];
+    i = i + 1 == state.range(0) ? 0 : i + 1;
+    input.update(frame);
+    benchmark::ClobberMemory();
+  }
+}
+
+// Same as window_input_update but fed from key events, one of which arrives
+// per frame.
+void window_input_update_from_events(benchmark::State &state) {
+  rpg::window::event_input events{};
+  rpg::window::bitset_input input{events};
+  for (auto key = 0; key < state.range(0); ++key) {
+    input.subscribe(static_cast<sf::Keyboard::Key>(key));
+  }
+
+  const auto frame = sf::milliseconds(16);
+  benchmark::DoNotOptimize(input);
+  sf::Event event{};
+  auto i = 0;
+  for (auto _ : state) {
+    event.type = events.is_key_pressed(static_cast<sf::Keyboard::Key>(i))
+                     ? sf::Event::KeyReleased
+                     : sf::Event::KeyPressed;
+    event.key.code = static_cast<sf::Keyboard::Key>(i);
+    events.process(event);
+    i = i + 1 == state.range(0) ? 0 : i + 1;
+    input.update(frame);
+    benchmark::ClobberMemory();
+  }
+}
+
+template <template <class> class TWindowInput>
+void window_input_get_key_state(benchmark::State &state) {
+  auto keyboard = make_keyboard();
+  TWindowInput<fake_keyboard> input{keyboard};
+  for (auto key = 0; key < state.range(0); ++key) {
+    input.subscribe(static_cast<sf::Keyboard::Key>(key));
+  }
+  input.update(sf::milliseconds(16));
+
+  std::vector<sf::Keyboard::Key> queries(1024);
+  std::mt19937 random{42};
+  std::uniform_int_distribution<int> key{0,
+                                         static_cast<int>(state.range(0)) - 1};
+  for (auto &query : queries) {
+    query = static_cast<sf::Keyboard::Key>(key(random));
+  }
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        rpg::window::is_down(input.get_key_state(queries[i]).position));
+    i = (i + 1) & (std::size(queries) - 1);
+  }
+}
+} // namespace
+
+BENCHMARK_TEMPLATE(window_input_update, rpg::window::input)
+    ->Arg(6)
+    ->Arg(32)
+    ->Arg(sf::Keyboard::KeyCount);
+BENCHMARK_TEMPLATE(window_input_update, rpg::window::bitset_input)
+    ->Arg(6)
+    ->Arg(32)
+    ->Arg(sf::Keyboard::KeyCount);
+BENCHMARK(window_input_update_from_events)
+    ->Arg(6)
+    ->Arg(32)
+    ->Arg(sf::Keyboard::KeyCount);
+BENCHMARK_TEMPLATE(window_input_get_key_state, rpg::window::input)
+    ->Arg(6)
+    ->Arg(32)
+    ->Arg(sf::Keyboard::KeyCount);
+BENCHMARK_TEMPLATE(window_input_get_key_state, rpg::window::bitset_input)
+    ->Arg(6)
+    ->Arg(32)
+    ->Arg(sf::Keyboard::KeyCount);
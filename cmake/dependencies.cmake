@@ -40,6 +40,17 @@ FetchContent_Declare(
 
 FetchContent_MakeAvailable(googletest)
 
+FetchContent_Declare(
+  benchmark
+  GIT_REPOSITORY https://github.com/google/benchmark
+  GIT_TAG v1.8.3)
+
+set(BENCHMARK_ENABLE_TESTING OFF)
+set(BENCHMARK_ENABLE_GTEST_TESTS OFF)
+set(BENCHMARK_ENABLE_INSTALL OFF)
+
+FetchContent_MakeAvailable(benchmark)
+
 if (${RPG_OS_IS_WINDOWS})
   find_package(spdlog CONFIG REQUIRED)
   add_library(vcpkg_pkgs INTERFACE)
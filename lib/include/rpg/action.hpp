@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 namespace rpg {
 enum class action : std::uint8_t {
@@ -9,4 +10,13 @@ enum class action : std::uint8_t {
   rotate_right,
   rotate_left
 };
-}
\ No newline at end of file
+
+inline constexpr std::size_t action_count = 6;
+
+// Set of rpg::action values, one bit per action.
+using action_set = std::uint8_t;
+
+[[nodiscard]] constexpr action_set action_bit(const rpg::action action) {
+  return static_cast<action_set>(1u << static_cast<unsigned>(action));
+}
+} // namespace rpg
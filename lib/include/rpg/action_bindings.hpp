@@ -0,0 +1,454 @@
+#pragma once
+
+#include <rpg/action.hpp>
+#include <rpg/window/key_bitset.hpp>
+#include <rpg/window/key_position.hpp>
+
+#include <SFML/Window/Keyboard.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace rpg {
+// Keys that all have to be down together, one bit per sf::Keyboard::Key.
+using key_chord = window::key_bitset;
+
+// Which keys trigger which actions. Each action has up to `max_chords`
+// chords, in a fixed array indexed by the action, and is active while any
+// one of them is fully held down. A single key is a chord of one.
+//
+// Everything is constexpr, so a binding set known up front can be built at
+// compile time and handed to fixed_actions below.
+class action_bindings {
+public:
+  static constexpr std::size_t max_chords = 4;
+
+private:
+  std::array<std::array<key_chord, max_chords>, action_count> chords_{};
+  std::array<std::uint8_t, action_count> counts_{};
+
+  [[nodiscard]] static constexpr auto index_(const rpg::action action) {
+    return static_cast<std::size_t>(action);
+  }
+
+  [[nodiscard]] static constexpr bool
+  holds_(const key_chord &chord, const window::key_bitset &down) noexcept {
+    for (std::size_t i = 0; i < key_chord::word_count; ++i) {
+      if ((down.words[i] & chord.words[i]) != chord.words[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+public:
+  // Calls `visit(key)` for every key in `keys`.
+  static constexpr void each_key(const window::key_bitset &keys,
+                                 auto &&visit) {
+    for (std::size_t i = 0; i < window::key_bitset::word_count; ++i) {
+      for (auto remaining = keys.words[i]; remaining != 0;
+           remaining &= remaining - 1) {
+        visit(static_cast<sf::Keyboard::Key>(
+            i * window::key_bitset::word_bits +
+            static_cast<std::size_t>(std::countr_zero(remaining))));
+      }
+    }
+  }
+
+  [[nodiscard]] static constexpr bool is_bindable(const sf::Keyboard::Key key) {
+    return key >= 0 and key < sf::Keyboard::KeyCount;
+  }
+
+  // Adds `chord` as another way of triggering `action`.
+  constexpr void bind(const rpg::action action, const key_chord &chord) {
+    auto &count = counts_[index_(action)];
+    if (count == max_chords) {
+      throw std::invalid_argument{"action already has the most chords"};
+    }
+    if (chord.words == key_chord{}.words) {
+      throw std::invalid_argument{"chord has no keys"};
+    }
+    chords_[index_(action)][count++] = chord;
+  }
+
+  // Adds the chord of `key` and `keys` as another way of triggering
+  // `action`.
+  constexpr void bind(const rpg::action action, const sf::Keyboard::Key key,
+                      const std::same_as<sf::Keyboard::Key> auto... keys) {
+    key_chord chord{};
+    for (const auto chord_key : {key, keys...}) {
+      if (not is_bindable(chord_key)) {
+        throw std::invalid_argument{"key cannot be bound"};
+      }
+      chord.set(static_cast<std::size_t>(chord_key));
+    }
+    bind(action, chord);
+  }
+
+  // Unbinds `action` and returns the keys it leaves bound to nothing.
+  constexpr auto clear(const rpg::action action) -> window::key_bitset {
+    auto released = keys(action);
+    chords_[index_(action)] = {};
+    counts_[index_(action)] = 0;
+    const auto still_bound = keys();
+    for (std::size_t i = 0; i < window::key_bitset::word_count; ++i) {
+      released.words[i] &= ~still_bound.words[i];
+    }
+    return released;
+  }
+
+  [[nodiscard]] constexpr auto chords(const rpg::action action) const
+      -> std::span<const key_chord> {
+    return std::span{chords_[index_(action)]}.first(counts_[index_(action)]);
+  }
+
+  // Every key `action` is bound to.
+  [[nodiscard]] constexpr auto keys(const rpg::action action) const
+      -> window::key_bitset {
+    window::key_bitset keys{};
+    for (const auto &chord : chords(action)) {
+      for (std::size_t i = 0; i < key_chord::word_count; ++i) {
+        keys.words[i] |= chord.words[i];
+      }
+    }
+    return keys;
+  }
+
+  // Every key any action is bound to, for subscribing to them.
+  [[nodiscard]] constexpr auto keys() const -> window::key_bitset {
+    window::key_bitset keys{};
+    for (std::size_t action = 0; action < action_count; ++action) {
+      const auto bound = this->keys(static_cast<rpg::action>(action));
+      for (std::size_t i = 0; i < key_chord::word_count; ++i) {
+        keys.words[i] |= bound.words[i];
+      }
+    }
+    return keys;
+  }
+
+  // Calls `visit(key)` for every key in keys().
+  constexpr void each_key(auto &&visit) const { each_key(keys(), visit); }
+
+  // Whether `action` is active given `down`, either a key_bitset of the keys
+  // held down or an input. Inputs that can hand over their held keys as a
+  // key_bitset through `down_keys()`, like rpg::window::bitset_input, are
+  // tested a word at a time; others are asked for each key's state.
+  template <class TDown>
+  [[nodiscard]] constexpr bool is_active(const rpg::action action,
+                                         const TDown &down) const {
+    if constexpr (std::same_as<TDown, window::key_bitset>) {
+      for (const auto &chord : chords(action)) {
+        if (holds_(chord, down)) {
+          return true;
+        }
+      }
+      return false;
+    } else if constexpr (requires { down.down_keys(); }) {
+      return is_active(action, down.down_keys());
+    } else {
+      for (const auto &chord : chords(action)) {
+        auto held = true;
+        each_key(chord, [&](const sf::Keyboard::Key key) {
+          held = held and window::is_down(down.get_key_state(key).position);
+        });
+        if (held) {
+          return true;
+        }
+      }
+      return false;
+    }
+  }
+
+  // Every action active given `down`, see is_active.
+  template <class TDown>
+  [[nodiscard]] constexpr auto actions(const TDown &down) const
+      -> action_set {
+    action_set active = 0;
+    for (std::size_t action = 0; action < action_count; ++action) {
+      if (is_active(static_cast<rpg::action>(action), down)) {
+        active |= action_bit(static_cast<rpg::action>(action));
+      }
+    }
+    return active;
+  }
+};
+
+// The bindings rpg-game uses without a bindings file.
+inline constexpr auto default_action_bindings = [] {
+  action_bindings bindings{};
+  bindings.bind(action::move_forward, sf::Keyboard::Key::W);
+  bindings.bind(action::move_backward, sf::Keyboard::Key::S);
+  bindings.bind(action::move_left, sf::Keyboard::Key::A);
+  bindings.bind(action::move_right, sf::Keyboard::Key::D);
+  bindings.bind(action::rotate_right, sf::Keyboard::Key::E);
+  bindings.bind(action::rotate_left, sf::Keyboard::Key::Q);
+  return bindings;
+}();
+
+namespace detail {
+template <const action_bindings &Bindings, std::size_t Action,
+          std::size_t Chord>
+[[nodiscard]] constexpr bool chord_held(const window::key_bitset &down) {
+  constexpr auto chord =
+      Bindings.chords(static_cast<action>(Action))[Chord];
+  return [&]<std::size_t... Words>(std::index_sequence<Words...>) {
+    // Words the chord has no keys in are dropped at compile time.
+    return ((chord.words[Words] == 0 or
+             (down.words[Words] & chord.words[Words]) == chord.words[Words]) and
+            ...);
+  }(std::make_index_sequence<key_chord::word_count>{});
+}
+
+template <const action_bindings &Bindings, std::size_t Action>
+[[nodiscard]] constexpr auto action_held(const window::key_bitset &down)
+    -> action_set {
+  constexpr auto chords =
+      std::size(Bindings.chords(static_cast<action>(Action)));
+  const auto held = [&]<std::size_t... Chords>(
+                        std::index_sequence<Chords...>) {
+    return (chord_held<Bindings, Action, Chords>(down) or ...);
+  }(std::make_index_sequence<chords>{});
+  return held ? action_bit(static_cast<action>(Action)) : action_set{0};
+}
+} // namespace detail
+
+// action_bindings::actions for a binding set fixed at compile time. Every
+// chord is unrolled into masks known to the compiler, so finding the active
+// actions comes down to a handful of AND and compare instructions on the
+// words of `down`, with no loops or table reads.
+template <const action_bindings &Bindings>
+[[nodiscard]] constexpr auto fixed_actions(const window::key_bitset &down)
+    -> action_set {
+  return [&]<std::size_t... Actions>(std::index_sequence<Actions...>) {
+    return static_cast<action_set>(
+        (detail::action_held<Bindings, Actions>(down) | ...));
+  }(std::make_index_sequence<action_count>{});
+}
+
+// Names used for actions and keys in bindings files, which are the
+// enumerators' own names.
+inline constexpr std::array<std::string_view, action_count> action_names{
+    "move_forward", "move_backward", "move_right",
+    "move_left",    "rotate_right",  "rotate_left"};
+
+struct key_name {
+  std::string_view name;
+  sf::Keyboard::Key key;
+};
+
+inline constexpr std::array<key_name, sf::Keyboard::KeyCount> key_names{{
+    {"A", sf::Keyboard::A},
+    {"B", sf::Keyboard::B},
+    {"C", sf::Keyboard::C},
+    {"D", sf::Keyboard::D},
+    {"E", sf::Keyboard::E},
+    {"F", sf::Keyboard::F},
+    {"G", sf::Keyboard::G},
+    {"H", sf::Keyboard::H},
+    {"I", sf::Keyboard::I},
+    {"J", sf::Keyboard::J},
+    {"K", sf::Keyboard::K},
+    {"L", sf::Keyboard::L},
+    {"M", sf::Keyboard::M},
+    {"N", sf::Keyboard::N},
+    {"O", sf::Keyboard::O},
+    {"P", sf::Keyboard::P},
+    {"Q", sf::Keyboard::Q},
+    {"R", sf::Keyboard::R},
+    {"S", sf::Keyboard::S},
+    {"T", sf::Keyboard::T},
+    {"U", sf::Keyboard::U},
+    {"V", sf::Keyboard::V},
+    {"W", sf::Keyboard::W},
+    {"X", sf::Keyboard::X},
+    {"Y", sf::Keyboard::Y},
+    {"Z", sf::Keyboard::Z},
+    {"Num0", sf::Keyboard::Num0},
+    {"Num1", sf::Keyboard::Num1},
+    {"Num2", sf::Keyboard::Num2},
+    {"Num3", sf::Keyboard::Num3},
+    {"Num4", sf::Keyboard::Num4},
+    {"Num5", sf::Keyboard::Num5},
+    {"Num6", sf::Keyboard::Num6},
+    {"Num7", sf::Keyboard::Num7},
+    {"Num8", sf::Keyboard::Num8},
+    {"Num9", sf::Keyboard::Num9},
+    {"Escape", sf::Keyboard::Escape},
+    {"LControl", sf::Keyboard::LControl},
+    {"LShift", sf::Keyboard::LShift},
+    {"LAlt", sf::Keyboard::LAlt},
+    {"LSystem", sf::Keyboard::LSystem},
+    {"RControl", sf::Keyboard::RControl},
+    {"RShift", sf::Keyboard::RShift},
+    {"RAlt", sf::Keyboard::RAlt},
+    {"RSystem", sf::Keyboard::RSystem},
+    {"Menu", sf::Keyboard::Menu},
+    {"LBracket", sf::Keyboard::LBracket},
+    {"RBracket", sf::Keyboard::RBracket},
+    {"Semicolon", sf::Keyboard::Semicolon},
+    {"Comma", sf::Keyboard::Comma},
+    {"Period", sf::Keyboard::Period},
+    {"Apostrophe", sf::Keyboard::Apostrophe},
+    {"Slash", sf::Keyboard::Slash},
+    {"Backslash", sf::Keyboard::Backslash},
+    {"Grave", sf::Keyboard::Grave},
+    {"Equal", sf::Keyboard::Equal},
+    {"Hyphen", sf::Keyboard::Hyphen},
+    {"Space", sf::Keyboard::Space},
+    {"Enter", sf::Keyboard::Enter},
+    {"Backspace", sf::Keyboard::Backspace},
+    {"Tab", sf::Keyboard::Tab},
+    {"PageUp", sf::Keyboard::PageUp},
+    {"PageDown", sf::Keyboard::PageDown},
+    {"End", sf::Keyboard::End},
+    {"Home", sf::Keyboard::Home},
+    {"Insert", sf::Keyboard::Insert},
+    {"Delete", sf::Keyboard::Delete},
+    {"Add", sf::Keyboard::Add},
+    {"Subtract", sf::Keyboard::Subtract},
+    {"Multiply", sf::Keyboard::Multiply},
+    {"Divide", sf::Keyboard::Divide},
+    {"Left", sf::Keyboard::Left},
+    {"Right", sf::Keyboard::Right},
+    {"Up", sf::Keyboard::Up},
+    {"Down", sf::Keyboard::Down},
+    {"Numpad0", sf::Keyboard::Numpad0},
+    {"Numpad1", sf::Keyboard::Numpad1},
+    {"Numpad2", sf::Keyboard::Numpad2},
+    {"Numpad3", sf::Keyboard::Numpad3},
+    {"Numpad4", sf::Keyboard::Numpad4},
+    {"Numpad5", sf::Keyboard::Numpad5},
+    {"Numpad6", sf::Keyboard::Numpad6},
+    {"Numpad7", sf::Keyboard::Numpad7},
+    {"Numpad8", sf::Keyboard::Numpad8},
+    {"Numpad9", sf::Keyboard::Numpad9},
+    {"F1", sf::Keyboard::F1},
+    {"F2", sf::Keyboard::F2},
+    {"F3", sf::Keyboard::F3},
+    {"F4", sf::Keyboard::F4},
+    {"F5", sf::Keyboard::F5},
+    {"F6", sf::Keyboard::F6},
+    {"F7", sf::Keyboard::F7},
+    {"F8", sf::Keyboard::F8},
+    {"F9", sf::Keyboard::F9},
+    {"F10", sf::Keyboard::F10},
+    {"F11", sf::Keyboard::F11},
+    {"F12", sf::Keyboard::F12},
+    {"F13", sf::Keyboard::F13},
+    {"F14", sf::Keyboard::F14},
+    {"F15", sf::Keyboard::F15},
+    {"Pause", sf::Keyboard::Pause},
+}};
+
+namespace detail {
+[[nodiscard]] inline auto trim(std::string_view text) {
+  constexpr std::string_view blanks = " \t\r";
+  const auto first = text.find_first_not_of(blanks);
+  if (first == std::string_view::npos) {
+    return std::string_view{};
+  }
+  return text.substr(first, text.find_last_not_of(blanks) - first + 1);
+}
+
+[[noreturn]] inline void bindings_error(const std::size_t line,
+                                        const std::string_view message) {
+  throw std::runtime_error{"action bindings line " + std::to_string(line) +
+                           ": " + std::string{message}};
+}
+} // namespace detail
+
+// Reads bindings written one per line as `action = key`, or
+// `action = key + key` for a chord, using the names in action_names and
+// key_names. An action may appear on several lines to bind it to several
+// chords. Everything after a `#` is a comment.
+//
+//   # Arrow keys as well as WASD
+//   move_forward = W
+//   move_forward = Up
+//   rotate_left = LShift + A
+//
+// Throws std::runtime_error naming the line of the first mistake.
+[[nodiscard]] inline auto parse_action_bindings(const std::string_view text)
+    -> action_bindings {
+  action_bindings bindings{};
+  std::size_t line_number = 0;
+  for (std::size_t start = 0; start < std::size(text);) {
+    auto end = text.find('\n', start);
+    if (end == std::string_view::npos) {
+      end = std::size(text);
+    }
+    auto line = text.substr(start, end - start);
+    start = end + 1;
+    ++line_number;
+
+    line = detail::trim(line.substr(0, line.find('#')));
+    if (std::empty(line)) {
+      continue;
+    }
+    const auto equals = line.find('=');
+    if (equals == std::string_view::npos) {
+      detail::bindings_error(line_number, "expected `action = keys`");
+    }
+
+    const auto action_name = detail::trim(line.substr(0, equals));
+    const auto *const action = std::ranges::find(action_names, action_name);
+    if (action == std::end(action_names)) {
+      detail::bindings_error(line_number, "unknown action `" +
+                                              std::string{action_name} + "`");
+    }
+
+    key_chord chord{};
+    for (auto keys = line.substr(equals + 1);;) {
+      const auto plus = keys.find('+');
+      const auto key_name = detail::trim(keys.substr(0, plus));
+      const auto *const key = std::ranges::find(key_names, key_name,
+                                                &rpg::key_name::name);
+      if (key == std::end(key_names)) {
+        detail::bindings_error(line_number, "unknown key `" +
+                                                std::string{key_name} + "`");
+      }
+      chord.set(static_cast<std::size_t>(key->key));
+      if (plus == std::string_view::npos) {
+        break;
+      }
+      keys = keys.substr(plus + 1);
+    }
+
+    try {
+      bindings.bind(static_cast<rpg::action>(std::distance(
+                        std::begin(action_names), action)),
+                    chord);
+    } catch (const std::invalid_argument &error) {
+      detail::bindings_error(line_number, error.what());
+    }
+  }
+  return bindings;
+}
+
+// parse_action_bindings on the contents of the file at `path`.
+[[nodiscard]] inline auto load_action_bindings(
+    const std::filesystem::path &path) -> action_bindings {
+  std::ifstream file{path};
+  if (not file) {
+    throw std::runtime_error{"failed to open action bindings `" +
+                             path.string() + "`"};
+  }
+  std::ostringstream contents{};
+  contents << file.rdbuf();
+  return parse_action_bindings(contents.view());
+}
+
+} // namespace rpg
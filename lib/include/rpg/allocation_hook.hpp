@@ -0,0 +1,68 @@
+#pragma once
+
+// Replaces the global allocation functions to count heap allocations into
+// rpg/allocations.hpp. Include from exactly one translation unit of an
+// executable.
+
+#include <rpg/allocations.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+void *operator new(std::size_t size) {
+  rpg::allocations::record(size);
+  if (auto *pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc{};
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  rpg::allocations::record(size);
+  const auto align = static_cast<std::size_t>(alignment);
+  // aligned_alloc may return nullptr for zero bytes, like malloc may.
+  const auto bytes = size == 0 ? 1 : size;
+#if defined(RPG_OS_IS_WINDOWS)
+  if (auto *pointer = _aligned_malloc(bytes, align)) {
+#else
+  if (auto *pointer =
+          std::aligned_alloc(align, (bytes + align - 1) / align * align)) {
+#endif
+    return pointer;
+  }
+  throw std::bad_alloc{};
+}
+
+// The replacements pair operator new with free(), which GCC flags once it
+// can see both bodies.
+#if defined(__GNUC__) and not defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept {
+#if defined(RPG_OS_IS_WINDOWS)
+  _aligned_free(pointer);
+#else
+  std::free(pointer);
+#endif
+}
+
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept {
+#if defined(RPG_OS_IS_WINDOWS)
+  _aligned_free(pointer);
+#else
+  std::free(pointer);
+#endif
+}
+
+#if defined(__GNUC__) and not defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
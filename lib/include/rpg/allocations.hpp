@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace rpg {
+struct allocation_counts {
+  std::uint64_t allocations{0};
+  std::uint64_t bytes{0};
+
+  friend auto operator-(const allocation_counts &after,
+                        const allocation_counts &before) noexcept
+      -> allocation_counts {
+    return {.allocations = after.allocations - before.allocations,
+            .bytes = after.bytes - before.bytes};
+  }
+
+  friend bool operator==(const allocation_counts &,
+                         const allocation_counts &) = default;
+};
+
+// Heap allocation counters, fed by the global operator new replacements in
+// rpg/allocation_hook.hpp. Without the hook included somewhere in the
+// program, every count stays at zero.
+namespace allocations {
+inline std::atomic<std::uint64_t> total_allocations_{0};
+inline std::atomic<std::uint64_t> total_bytes_{0};
+// Constant initialized, so reading it never allocates from inside the hook.
+inline thread_local allocation_counts thread_counts_{};
+
+// Called by the hook for every allocation.
+inline void record(const std::size_t bytes) noexcept {
+  total_allocations_.fetch_add(1, std::memory_order_relaxed);
+  total_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+  ++thread_counts_.allocations;
+  thread_counts_.bytes += bytes;
+}
+
+// Allocations made by every thread so far.
+[[nodiscard]] inline auto total() noexcept -> allocation_counts {
+  return {.allocations = total_allocations_.load(std::memory_order_relaxed),
+          .bytes = total_bytes_.load(std::memory_order_relaxed)};
+}
+
+// Allocations made by the calling thread so far.
+[[nodiscard]] inline auto this_thread() noexcept -> allocation_counts {
+  return thread_counts_;
+}
+
+// What the allocation scopes with a given name have added up to.
+struct scope_totals {
+  const char *name;
+  allocation_counts counts;
+  std::uint64_t calls;
+};
+
+// Totals per scope name, in a fixed table so that adding to them never
+// allocates. Names are compared by address, so use string literals.
+class scope_table {
+public:
+  static constexpr std::size_t capacity = 64;
+
+private:
+  struct entry {
+    std::atomic<const char *> name{nullptr};
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> bytes{0};
+    std::atomic<std::uint64_t> calls{0};
+  };
+
+  std::array<entry, capacity> entries_{};
+
+public:
+  [[nodiscard]] static auto instance() -> scope_table & {
+    static scope_table table{};
+    return table;
+  }
+
+  // Adds `counts` to the scope called `name`. Names beyond the first
+  // `capacity` are dropped.
+  void add(const char *const name, const allocation_counts counts) noexcept {
+    for (auto &slot : entries_) {
+      const char *expected = nullptr;
+      if (slot.name.load(std::memory_order_acquire) == name or
+          slot.name.compare_exchange_strong(expected, name,
+                                            std::memory_order_acq_rel) or
+          expected == name) {
+        slot.allocations.fetch_add(counts.allocations,
+                                   std::memory_order_relaxed);
+        slot.bytes.fetch_add(counts.bytes, std::memory_order_relaxed);
+        slot.calls.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+  }
+
+  // Calls `visit(scope_totals)` for every scope seen so far.
+  void each(auto &&visit) const {
+    for (const auto &slot : entries_) {
+      const auto *const name = slot.name.load(std::memory_order_acquire);
+      if (name == nullptr) {
+        return;
+      }
+      visit(scope_totals{
+          .name = name,
+          .counts = {.allocations =
+                         slot.allocations.load(std::memory_order_relaxed),
+                     .bytes = slot.bytes.load(std::memory_order_relaxed)},
+          .calls = slot.calls.load(std::memory_order_relaxed)});
+    }
+  }
+
+  // Zeroes every total, keeping the names.
+  void reset() noexcept {
+    for (auto &slot : entries_) {
+      slot.allocations.store(0, std::memory_order_relaxed);
+      slot.bytes.store(0, std::memory_order_relaxed);
+      slot.calls.store(0, std::memory_order_relaxed);
+    }
+  }
+};
+
+// Adds whatever the calling thread allocates from its construction to its
+// destruction to the scope called `name`.
+class scope {
+  const char *name_;
+  allocation_counts start_;
+
+public:
+  explicit scope(const char *const name) noexcept
+      : name_(name), start_(this_thread()) {}
+
+  scope(const scope &) = delete;
+  scope &operator=(const scope &) = delete;
+
+  ~scope() { scope_table::instance().add(name_, this_thread() - start_); }
+};
+
+// What every thread allocated per frame: the last frame, the worst one and
+// all of them together. Call mark() once at the start of every frame.
+class frame_counter {
+  allocation_counts start_{total()};
+  allocation_counts last_{};
+  allocation_counts peak_{};
+  std::uint64_t frames_{0};
+  allocation_counts first_{start_};
+
+public:
+  void mark() noexcept {
+    const auto now = total();
+    last_ = now - start_;
+    start_ = now;
+    peak_.allocations = std::max(peak_.allocations, last_.allocations);
+    peak_.bytes = std::max(peak_.bytes, last_.bytes);
+    ++frames_;
+  }
+
+  [[nodiscard]] auto last() const noexcept { return last_; }
+  [[nodiscard]] auto peak() const noexcept { return peak_; }
+  [[nodiscard]] auto frames() const noexcept { return frames_; }
+
+  // Everything allocated over the frames marked so far.
+  [[nodiscard]] auto overall() const noexcept { return start_ - first_; }
+};
+} // namespace allocations
+
+} // namespace rpg
+
+#define RPG_ALLOCATIONS_CONCAT_(a, b) a##b
+#define RPG_ALLOCATIONS_CONCAT(a, b) RPG_ALLOCATIONS_CONCAT_(a, b)
+
+// Scopes are only counted when built with RPG_TRACK_ALLOCATIONS, which also
+// installs the hook in rpg-game; otherwise the macro expands to nothing.
+#if defined(RPG_TRACK_ALLOCATIONS)
+#define RPG_ALLOCATION_SCOPE(name)                                             \
+  const ::rpg::allocations::scope RPG_ALLOCATIONS_CONCAT(                      \
+      rpg_allocation_scope_, __LINE__) {                                       \
+    name                                                                       \
+  }
+#else
+#define RPG_ALLOCATION_SCOPE(name) static_cast<void>(0)
+#endif
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <rpg/mapped_file.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rpg {
+namespace asset_archive_format {
+// Binary layout shared by rpg::pack_asset_archive and
+// rpg::asset_archive_view. Integers are little endian.
+//
+//   header  "RPGA", u32 version, u32 entry count, u32 reserved (zero)
+//   toc     per entry: u64 name hash, u64 offset, u64 size, sorted by hash
+//   blobs   each starting on a 16 byte boundary, measured from the start of
+//           the archive
+//
+// Names themselves are not stored; two names with the same hash are refused
+// when packing.
+inline constexpr std::array<std::byte, 4> magic{std::byte{'R'}, std::byte{'P'},
+                                                std::byte{'G'}, std::byte{'A'}};
+inline constexpr std::uint32_t version{1};
+inline constexpr std::size_t alignment{16};
+inline constexpr std::size_t header_size{16};
+inline constexpr std::size_t toc_entry_size{24};
+
+static_assert(std::endian::native == std::endian::little,
+              "asset archives are read in place as little endian");
+
+// 64-bit FNV-1a.
+[[nodiscard]] constexpr auto hash(const std::string_view name) noexcept
+    -> std::uint64_t {
+  std::uint64_t result = 0xcbf29ce484222325;
+  for (const auto character : name) {
+    result ^= static_cast<unsigned char>(character);
+    result *= 0x100000001b3;
+  }
+  return result;
+}
+
+[[nodiscard]] constexpr auto aligned(const std::size_t offset) noexcept {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+template <class T>
+[[nodiscard]] auto read(const std::span<const std::byte> bytes,
+                        const std::size_t offset) noexcept -> T {
+  T value{};
+  std::memcpy(&value, std::data(bytes) + offset, sizeof(T));
+  return value;
+}
+
+template <class T>
+void write(std::vector<std::byte> &bytes, const std::size_t offset,
+           const T value) noexcept {
+  std::memcpy(std::data(bytes) + offset, &value, sizeof(T));
+}
+} // namespace asset_archive_format
+
+struct asset_archive_entry {
+  std::string name;
+  std::span<const std::byte> bytes;
+};
+
+// Lays `entries` out as an asset archive. Throws std::invalid_argument if two
+// names hash the same, which includes the same name twice.
+[[nodiscard]] inline auto
+pack_asset_archive(const std::span<const asset_archive_entry> entries)
+    -> std::vector<std::byte> {
+  namespace format = asset_archive_format;
+
+  struct placed {
+    std::uint64_t hash;
+    const asset_archive_entry *entry;
+  };
+  std::vector<placed> order{};
+  order.reserve(std::size(entries));
+  for (const auto &entry : entries) {
+    order.push_back({.hash = format::hash(entry.name), .entry = &entry});
+  }
+  std::ranges::sort(order, {}, &placed::hash);
+  if (std::ranges::adjacent_find(order, {}, &placed::hash) !=
+      std::end(order)) {
+    throw std::invalid_argument{"asset names collide"};
+  }
+
+  auto offset = format::aligned(format::header_size +
+                                std::size(order) * format::toc_entry_size);
+  std::vector<std::uint64_t> offsets{};
+  offsets.reserve(std::size(order));
+  for (const auto &item : order) {
+    offsets.push_back(offset);
+    offset = format::aligned(offset + std::size(item.entry->bytes));
+  }
+
+  std::vector<std::byte> bytes(offset);
+  std::ranges::copy(format::magic, std::begin(bytes));
+  format::write(bytes, 4, format::version);
+  format::write(bytes, 8, static_cast<std::uint32_t>(std::size(order)));
+  for (std::size_t i = 0; i < std::size(order); ++i) {
+    const auto toc = format::header_size + i * format::toc_entry_size;
+    const auto &blob = order[i].entry->bytes;
+    format::write(bytes, toc, order[i].hash);
+    format::write(bytes, toc + 8, offsets[i]);
+    format::write(bytes, toc + 16, std::uint64_t{std::size(blob)});
+    std::ranges::copy(blob, std::next(std::begin(bytes),
+                                      static_cast<std::ptrdiff_t>(offsets[i])));
+  }
+  return bytes;
+}
+
+// Looks assets up in an archive made by rpg::pack_asset_archive without
+// copying them. The view reads straight out of `bytes`, which must outlive
+// it. The whole table of contents is checked up front, so lookups never
+// fail on a malformed archive.
+class asset_archive_view {
+  std::span<const std::byte> bytes_{};
+  std::size_t size_{0};
+
+  [[nodiscard]] auto hash_at_(const std::size_t index) const noexcept {
+    return asset_archive_format::read<std::uint64_t>(
+        bytes_, asset_archive_format::header_size +
+                    index * asset_archive_format::toc_entry_size);
+  }
+
+public:
+  asset_archive_view() = default;
+
+  explicit asset_archive_view(const std::span<const std::byte> bytes)
+      : bytes_(bytes) {
+    namespace format = asset_archive_format;
+    if (std::size(bytes_) < format::header_size or
+        not std::equal(std::cbegin(format::magic), std::cend(format::magic),
+                       std::cbegin(bytes_))) {
+      throw std::runtime_error{"not an asset archive"};
+    }
+    if (format::read<std::uint32_t>(bytes_, 4) != format::version) {
+      throw std::runtime_error{"unsupported asset archive version"};
+    }
+    size_ = format::read<std::uint32_t>(bytes_, 8);
+    if ((std::size(bytes_) - format::header_size) / format::toc_entry_size <
+        size_) {
+      throw std::runtime_error{"asset archive is truncated"};
+    }
+    for (std::size_t i = 0; i < size_; ++i) {
+      const auto toc = format::header_size + i * format::toc_entry_size;
+      const auto offset = format::read<std::uint64_t>(bytes_, toc + 8);
+      const auto size = format::read<std::uint64_t>(bytes_, toc + 16);
+      if (offset % format::alignment != 0 or offset > std::size(bytes_) or
+          size > std::size(bytes_) - offset) {
+        throw std::runtime_error{"asset archive has an invalid blob"};
+      }
+      if (i > 0 and hash_at_(i - 1) >= hash_at_(i)) {
+        throw std::runtime_error{"asset archive is not sorted"};
+      }
+    }
+  }
+
+  // The bytes stored under `hash`, or nothing if there are none. Binary
+  // searches the table of contents.
+  [[nodiscard]] auto find(const std::uint64_t hash) const noexcept
+      -> std::optional<std::span<const std::byte>> {
+    namespace format = asset_archive_format;
+    std::size_t first = 0;
+    std::size_t count = size_;
+    while (count > 0) {
+      const auto half = count / 2;
+      if (hash_at_(first + half) < hash) {
+        first += half + 1;
+        count -= half + 1;
+      } else {
+        count = half;
+      }
+    }
+    if (first == size_ or hash_at_(first) != hash) {
+      return std::nullopt;
+    }
+    const auto toc = format::header_size + first * format::toc_entry_size;
+    return bytes_.subspan(format::read<std::uint64_t>(bytes_, toc + 8),
+                          format::read<std::uint64_t>(bytes_, toc + 16));
+  }
+
+  [[nodiscard]] auto find(const std::string_view name) const noexcept {
+    return find(asset_archive_format::hash(name));
+  }
+
+  [[nodiscard]] auto size() const noexcept { return size_; }
+};
+
+// An asset archive mapped in from disk. Assets are read lazily by the OS as
+// they are touched.
+class asset_archive {
+  mapped_file file_;
+  asset_archive_view view_;
+
+public:
+  // Throws std::system_error if the file cannot be mapped and
+  // std::runtime_error if it is not a valid archive.
+  explicit asset_archive(const std::filesystem::path &path)
+      : file_(path), view_(file_.bytes()) {}
+
+  [[nodiscard]] auto find(const std::string_view name) const noexcept {
+    return view_.find(name);
+  }
+
+  [[nodiscard]] auto size() const noexcept { return view_.size(); }
+
+  [[nodiscard]] auto bytes() const noexcept { return file_.bytes(); }
+};
+
+} // namespace rpg
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace rpg {
+// Where a texture ended up in a texture atlas. The generated
+// rpg/texture_atlas.hpp has one of these per file in textures/.
+struct atlas_region {
+  std::uint32_t page{0};
+  int left{0};
+  int top{0};
+  int width{0};
+  int height{0};
+
+  [[nodiscard]] auto rect() const -> sf::IntRect {
+    return {left, top, width, height};
+  }
+};
+
+struct atlas_size {
+  int width{0};
+  int height{0};
+};
+
+// Packs rectangles into one square page with the skyline bottom-left
+// heuristic. The skyline is the outline of the top edges of everything
+// placed so far; each rectangle goes wherever along it its top edge ends up
+// lowest, with ties broken by the leftmost spot.
+class skyline_packer {
+  struct segment {
+    int x;
+    int y;
+    int width;
+  };
+
+  int size_;
+  std::vector<segment> skyline_;
+
+  // Lowest y at which a rectangle `width` wide fits starting at segment
+  // `index`, if it fits at all.
+  [[nodiscard]] auto fit_(const std::size_t index, const int width,
+                          const int height) const -> std::optional<int> {
+    const auto x = skyline_[index].x;
+    if (x + width > size_) {
+      return std::nullopt;
+    }
+    auto y = 0;
+    auto remaining = width;
+    for (auto i = index; remaining > 0; ++i) {
+      y = std::max(y, skyline_[i].y);
+      if (y + height > size_) {
+        return std::nullopt;
+      }
+      remaining -= skyline_[i].width;
+    }
+    return y;
+  }
+
+  void place_(const std::size_t index, const int x, const int y,
+              const int width) {
+    skyline_.insert(std::next(std::begin(skyline_),
+                              static_cast<std::ptrdiff_t>(index)),
+                    segment{.x = x, .y = y, .width = width});
+    // Trim whatever the new segment now covers.
+    auto i = index + 1;
+    while (i < std::size(skyline_)) {
+      const auto covered = x + width - skyline_[i].x;
+      if (covered <= 0) {
+        break;
+      }
+      if (covered < skyline_[i].width) {
+        skyline_[i].x += covered;
+        skyline_[i].width -= covered;
+        break;
+      }
+      skyline_.erase(std::next(std::begin(skyline_),
+                               static_cast<std::ptrdiff_t>(i)));
+    }
+    // Merge neighbours at the same height.
+    for (std::size_t j = 0; j + 1 < std::size(skyline_);) {
+      if (skyline_[j].y == skyline_[j + 1].y) {
+        skyline_[j].width += skyline_[j + 1].width;
+        skyline_.erase(std::next(std::begin(skyline_),
+                                 static_cast<std::ptrdiff_t>(j + 1)));
+      } else {
+        ++j;
+      }
+    }
+  }
+
+public:
+  explicit skyline_packer(const int size)
+      : size_(size), skyline_{{.x = 0, .y = 0, .width = size}} {}
+
+  // Finds room for a `width` x `height` rectangle and claims it. Returns the
+  // top left corner, or nothing if the page has no room left for it.
+  [[nodiscard]] auto insert(const int width, const int height)
+      -> std::optional<sf::Vector2i> {
+    auto best_index = std::size(skyline_);
+    auto best_top = std::numeric_limits<int>::max();
+    auto best_y = 0;
+    for (std::size_t i = 0; i < std::size(skyline_); ++i) {
+      const auto y = fit_(i, width, height);
+      if (y and *y + height < best_top) {
+        best_index = i;
+        best_top = *y + height;
+        best_y = *y;
+      }
+    }
+    if (best_index == std::size(skyline_)) {
+      return std::nullopt;
+    }
+    const auto x = skyline_[best_index].x;
+    place_(best_index, x, best_top, width);
+    return sf::Vector2i{x, best_y};
+  }
+};
+
+// Packs `sizes` into as many `page_size` square pages as needed, leaving
+// `padding` pixels between neighbours so filtering does not bleed one
+// texture into the next. Returns one region per size, in the same order.
+// Taller rectangles are placed first, which packs much tighter.
+[[nodiscard]] inline auto pack_atlas(const std::span<const atlas_size> sizes,
+                                     const int page_size, const int padding)
+    -> std::vector<atlas_region> {
+  std::vector<std::size_t> order(std::size(sizes));
+  std::iota(std::begin(order), std::end(order), std::size_t{0});
+  std::stable_sort(std::begin(order), std::end(order),
+                   [&](const std::size_t lhs, const std::size_t rhs) {
+                     return sizes[lhs].height != sizes[rhs].height
+                                ? sizes[lhs].height > sizes[rhs].height
+                                : sizes[lhs].width > sizes[rhs].width;
+                   });
+
+  std::vector<skyline_packer> pages{};
+  std::vector<atlas_region> regions(std::size(sizes));
+  for (const auto index : order) {
+    const auto size = sizes[index];
+    const auto width = size.width + padding;
+    const auto height = size.height + padding;
+    if (width > page_size or height > page_size) {
+      throw std::invalid_argument{"texture does not fit on an atlas page"};
+    }
+    std::optional<sf::Vector2i> corner{};
+    std::size_t page = 0;
+    for (; page < std::size(pages); ++page) {
+      if (corner = pages[page].insert(width, height); corner) {
+        break;
+      }
+    }
+    if (not corner) {
+      corner = pages.emplace_back(page_size).insert(width, height);
+    }
+    regions[index] = {.page = static_cast<std::uint32_t>(page),
+                      .left = corner->x,
+                      .top = corner->y,
+                      .width = size.width,
+                      .height = size.height};
+  }
+  return regions;
+}
+
+} // namespace rpg
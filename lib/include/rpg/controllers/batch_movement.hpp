@@ -0,0 +1,198 @@
+#pragma once
+
+#include <rpg/action.hpp>
+#include <rpg/math.hpp>
+
+#include <SFML/Graphics/Transformable.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace rpg::controllers {
+using rpg::action_bit;
+using rpg::action_set;
+
+// Applies the rules of rpg::controllers::movement to many entities at once.
+// Every piece of per entity state lives in its own contiguous array and the
+// actions to perform each frame are given as an action_set per entity rather
+// than looked up through an input, so update is a couple of passes over the
+// arrays.
+//
+// The arithmetic is done in the same order as movement and sf::Transformable
+// so that, given the same actions, each entity ends up bit for bit where a
+// movement controller would have put it.
+class batch_movement {
+  std::vector<float> position_x_{};
+  std::vector<float> position_y_{};
+  std::vector<float> rotation_{};
+  std::vector<float> direction_x_{};
+  std::vector<float> direction_y_{};
+  std::vector<float> frontal_movement_{};
+  std::vector<float> backward_movement_{};
+  std::vector<float> lateral_movement_{};
+  std::vector<float> rotational_movement_{};
+  std::vector<action_set> actions_{};
+
+  [[nodiscard]] static float select_(const action_set actions,
+                                     const action_set mask) {
+    return (actions & mask) != 0 ? 1.0f : 0.0f;
+  }
+
+public:
+  void reserve(const std::size_t count) {
+    position_x_.reserve(count);
+    position_y_.reserve(count);
+    rotation_.reserve(count);
+    direction_x_.reserve(count);
+    direction_y_.reserve(count);
+    frontal_movement_.reserve(count);
+    backward_movement_.reserve(count);
+    lateral_movement_.reserve(count);
+    rotational_movement_.reserve(count);
+    actions_.reserve(count);
+  }
+
+  // Starts tracking `transformable`'s position and rotation. Like
+  // movement::attach the entity starts out facing (1, 0). Returns the entity's
+  // index.
+  auto add(const sf::Transformable &transformable, const auto &speed)
+      -> std::size_t {
+    position_x_.push_back(transformable.getPosition().x);
+    position_y_.push_back(transformable.getPosition().y);
+    rotation_.push_back(transformable.getRotation());
+    direction_x_.push_back(1.0f);
+    direction_y_.push_back(0.0f);
+    frontal_movement_.push_back(speed.frontal_movement());
+    backward_movement_.push_back(speed.backward_movement());
+    lateral_movement_.push_back(speed.lateral_movement());
+    rotational_movement_.push_back(speed.rotational_movement());
+    actions_.push_back(0);
+    return size() - 1;
+  }
+
+  // Removes the entity at `index` by moving the last entity into its place.
+  void swap_remove(const std::size_t index) {
+    const auto remove = [index](auto &values) {
+      values[index] = values.back();
+      values.pop_back();
+    };
+    remove(position_x_);
+    remove(position_y_);
+    remove(rotation_);
+    remove(direction_x_);
+    remove(direction_y_);
+    remove(frontal_movement_);
+    remove(backward_movement_);
+    remove(lateral_movement_);
+    remove(rotational_movement_);
+    remove(actions_);
+  }
+
+  void set_actions(const std::size_t index, const action_set actions) {
+    actions_[index] = actions;
+  }
+
+  [[nodiscard]] auto actions() noexcept { return std::span{actions_}; }
+
+  void update(const auto &delta_time) { update(delta_time, 0, size()); }
+
+  // Updates entities [first, last) only. Disjoint ranges touch disjoint
+  // memory, so they can be updated on different threads at the same time.
+  void update(const auto &delta_time, const std::size_t first,
+              const std::size_t last) {
+    constexpr auto rotate =
+        action_bit(action::rotate_right) | action_bit(action::rotate_left);
+    constexpr auto lateral =
+        action_bit(action::move_right) | action_bit(action::move_left);
+
+    const auto seconds = delta_time.asSeconds();
+
+    // Movement first, for every entity. Movement that does not apply adds a
+    // zero, which leaves the position unchanged, so this loop has no branches
+    // and can be vectorised.
+    for (auto i = first; i < last; ++i) {
+      // Rotating entities do not move, and moving sideways rules out moving
+      // forward or backward.
+      const auto sideways = (actions_[i] & rotate) != 0 ? 0 : actions_[i];
+      const auto frontal = (sideways & lateral) != 0 ? 0 : sideways;
+      const auto right = select_(sideways, action_bit(action::move_right));
+      const auto left = select_(sideways, action_bit(action::move_left));
+      const auto forward = select_(frontal, action_bit(action::move_forward));
+      const auto backward = select_(frontal, action_bit(action::move_backward));
+
+      const auto direction_x = direction_x_[i];
+      const auto direction_y = direction_y_[i];
+      const auto lateral_speed = lateral_movement_[i];
+      const auto frontal_speed = frontal_movement_[i];
+      const auto backward_speed = -backward_movement_[i];
+
+      auto x = position_x_[i];
+      auto y = position_y_[i];
+      // right(direction) is (-y, x) and left(direction) is (y, -x).
+      x = x + -direction_y * lateral_speed * seconds * right;
+      y = y + direction_x * lateral_speed * seconds * right;
+      x = x + direction_y * lateral_speed * seconds * left;
+      y = y + -direction_x * lateral_speed * seconds * left;
+      x = x + direction_x * frontal_speed * seconds * forward;
+      y = y + direction_y * frontal_speed * seconds * forward;
+      x = x + direction_x * backward_speed * seconds * backward;
+      y = y + direction_y * backward_speed * seconds * backward;
+      position_x_[i] = x;
+      position_y_[i] = y;
+    }
+
+    // Then rotation, which needs trig and is only paid for by the entities
+    // that rotate.
+    for (auto i = first; i < last; ++i) {
+      const auto actions = actions_[i];
+      if ((actions & rotate) == 0) {
+        continue;
+      }
+      auto rotation = rotation_[i];
+      if ((actions & action_bit(action::rotate_right)) != 0) {
+        rotation =
+            math::wrap_degrees(rotation + rotational_movement_[i] * seconds);
+      }
+      if ((actions & action_bit(action::rotate_left)) != 0) {
+        rotation =
+            math::wrap_degrees(rotation + -rotational_movement_[i] * seconds);
+      }
+      rotation_[i] = rotation;
+      const auto direction = math::rotate_vector(rotation);
+      direction_x_[i] = direction.x;
+      direction_y_[i] = direction.y;
+    }
+  }
+
+  // Writes position and rotation back to `transformables`, where entity i
+  // corresponds to transformables[i]. A rotation that rounded up to exactly
+  // 360 degrees is stored as 0 since that is what setRotation makes of it.
+  void store(std::span<sf::Transformable> transformables) const {
+    for (std::size_t i = 0; i < std::size(transformables); ++i) {
+      store(i, transformables[i]);
+    }
+  }
+
+  void store(const std::size_t index, sf::Transformable &transformable) const {
+    transformable.setPosition(position_x_[index], position_y_[index]);
+    transformable.setRotation(rotation_[index]);
+  }
+
+  [[nodiscard]] auto size() const noexcept { return std::size(actions_); }
+
+  [[nodiscard]] auto position(const std::size_t index) const {
+    return sf::Vector2f{position_x_[index], position_y_[index]};
+  }
+
+  [[nodiscard]] auto rotation(const std::size_t index) const {
+    return rotation_[index];
+  }
+
+  [[nodiscard]] auto direction(const std::size_t index) const {
+    return sf::Vector2f{direction_x_[index], direction_y_[index]};
+  }
+};
+
+} // namespace rpg::controllers
@@ -1,74 +1,150 @@
 #pragma once
 
 #include <rpg/action.hpp>
+#include <rpg/action_bindings.hpp>
 #include <rpg/math.hpp>
+#include <rpg/math/trig.hpp>
+#include <rpg/slot_map.hpp>
 #include <rpg/window/key_position.hpp>
 
 #include <SFML/Graphics/Transformable.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Window/Keyboard.hpp>
-#include <boost/container/flat_map.hpp>
 #include <imgui-SFML.h>
 #include <imgui.h>
 
-#if defined(RPG_DEBUG) and not defined(RPG_TESTING)
-#include <format>
-#endif
+#include <concepts>
+#include <cstddef>
 #include <functional>
-#include <optional>
 
 namespace rpg::controllers {
 
-template <class TInput, class TSpeed> class movement {
+// `TTrig` turns the rotation into a direction, see rpg/math/trig.hpp.
+template <class TInput, class TSpeed, class TTrig = math::std_trig>
+class movement {
 
   std::reference_wrapper<TInput> input_;
   std::reference_wrapper<const TSpeed> speed_;
-  std::optional<std::reference_wrapper<sf::Transformable>> transformable_;
+  // What the controller moves, looked up on every update so that it can
+  // live in a slot_map that moves its values around. `resolve_` turns
+  // `target_` and `handle_` back into the transformable, or nullptr once the
+  // handle has gone stale.
+  void *target_{nullptr};
+  slot_handle handle_{};
+  sf::Transformable *(*resolve_)(void *, slot_handle) noexcept {nullptr};
   sf::Vector2f direction_;
-  boost::container::flat_map<rpg::action, sf::Keyboard::Key> action_map_;
+  // Whether the last update moved or rotated the transformable.
+  bool moved_{false};
+  action_bindings bindings_{};
 
   bool should_do_action(const auto action) const {
-    if (const auto iter = action_map_.find(action);
-        iter != std::cend(action_map_)) {
-      return window::is_down(input_.get().get_key_state(iter->second).position);
-    }
-    return false;
+    return bindings_.is_active(action, input_.get());
   }
 
-public:
-  movement(TInput &input, const TSpeed &speed) : input_(input), speed_(speed) {}
+  [[nodiscard]] sf::Transformable *resolve_target_() const noexcept {
+    return resolve_ == nullptr ? nullptr : resolve_(target_, handle_);
+  }
 
-  auto attach(auto &transformable) {
-    transformable_ = transformable;
+  void face_forward_() noexcept {
     direction_.x = 1.0f;
     direction_.y = 0.0f;
   }
 
-  auto detach() { transformable_.reset(); }
+public:
+  movement(TInput &input, const TSpeed &speed) : input_(input), speed_(speed) {}
+
+  // Moves `transformable`, which has to outlive the attachment and stay put.
+  auto attach(sf::Transformable &transformable) {
+    target_ = &transformable;
+    handle_ = null_slot_handle;
+    resolve_ = [](void *target, slot_handle) noexcept {
+      return static_cast<sf::Transformable *>(target);
+    };
+    face_forward_();
+  }
+
+  // Moves the value `handle` refers to in `pool`, wherever the pool has put
+  // it. Erasing it from the pool detaches the controller.
+  template <std::derived_from<sf::Transformable> T>
+  auto attach(slot_map<T> &pool, const slot_handle handle) {
+    target_ = &pool;
+    handle_ = handle;
+    resolve_ = [](void *target, const slot_handle held) noexcept
+        -> sf::Transformable * {
+      return static_cast<slot_map<T> *>(target)->try_get(held);
+    };
+    face_forward_();
+  }
+
+  auto detach() {
+    target_ = nullptr;
+    handle_ = null_slot_handle;
+    resolve_ = nullptr;
+  }
+
+  // False once the pool handle attached to has gone stale.
   [[nodiscard]] auto is_attached() const noexcept {
-    return transformable_.has_value();
+    return resolve_target_() != nullptr;
   }
 
+  // The handle attached to, or null_slot_handle when attached to a
+  // transformable directly.
+  [[nodiscard]] auto handle() const noexcept { return handle_; }
+
+  // Binds `action` to `key` alone, replacing the chords it had. A key that
+  // cannot be bound, like sf::Keyboard::Unknown, leaves it unbound. Keys the
+  // old chords leave bound to nothing are unsubscribed.
   auto map_action(const rpg::action action, const auto key) {
-    action_map_[action] = key;
     auto &input = input_.get();
-    input.subscribe(key);
+    auto released = bindings_.clear(action);
+    if (action_bindings::is_bindable(key)) {
+      bindings_.bind(action, key);
+      input.subscribe(key);
+      released.reset(static_cast<std::size_t>(key));
+    }
+    action_bindings::each_key(
+        released,
+        [&](const sf::Keyboard::Key unused) { input.unsubscribe(unused); });
+  }
+
+  // Adds the chord of `keys` as another way of triggering `action`.
+  auto bind_action(const rpg::action action, const auto... keys) {
+    bindings_.bind(action, keys...);
+    auto &input = input_.get();
+    (input.subscribe(keys), ...);
   }
 
+  // Unbinds `action`, unsubscribing from the keys no other action uses.
   auto clear_action(const rpg::action action) {
-    if (const auto iter = action_map_.find(action);
-        iter != std::end(action_map_)) {
-      auto &input = input_.get();
-      input.unsubscribe(iter->second);
-      action_map_.erase(iter);
-    }
+    auto &input = input_.get();
+    action_bindings::each_key(
+        bindings_.clear(action),
+        [&](const sf::Keyboard::Key key) { input.unsubscribe(key); });
+  }
+
+  // Replaces every binding with `bindings`.
+  auto set_bindings(const action_bindings &bindings) {
+    auto &input = input_.get();
+    bindings_.each_key(
+        [&](const sf::Keyboard::Key key) { input.unsubscribe(key); });
+    bindings_ = bindings;
+    bindings_.each_key(
+        [&](const sf::Keyboard::Key key) { input.subscribe(key); });
+  }
+
+  [[nodiscard]] auto bindings() const noexcept -> const action_bindings & {
+    return bindings_;
   }
 
+  [[nodiscard]] auto moved() const noexcept { return moved_; }
+
   auto update(const auto &delta_time) {
-    if (not transformable_) {
+    moved_ = false;
+    auto *const target = resolve_target_();
+    if (target == nullptr) {
       return;
     }
-    auto &transformable = (*transformable_).get();
+    auto &transformable = *target;
     auto &speed = speed_.get();
 
     bool rotation_movement_performed = false;
@@ -76,18 +152,19 @@ public:
     if (should_do_action(action::rotate_right)) {
       transformable.rotate(speed.rotational_movement() *
                            delta_time.asSeconds());
-      direction_ = math::rotate_vector(transformable.getRotation());
+      direction_ = TTrig::rotate_vector(transformable.getRotation());
       rotation_movement_performed = true;
     }
 
     if (should_do_action(action::rotate_left)) {
       transformable.rotate(-speed.rotational_movement() *
                            delta_time.asSeconds());
-      direction_ = math::rotate_vector(transformable.getRotation());
+      direction_ = TTrig::rotate_vector(transformable.getRotation());
       rotation_movement_performed = true;
     }
 
     if (rotation_movement_performed) {
+      moved_ = true;
       return;
     }
 
@@ -106,6 +183,7 @@ public:
     }
 
     if (lateral_movement_performed) {
+      moved_ = true;
       return;
     }
 
@@ -113,40 +191,64 @@ public:
         should_do_action(action::move_forward)) {
       transformable.move(direction_ * speed.frontal_movement() *
                          delta_time.asSeconds());
+      moved_ = true;
     }
 
     if (not lateral_movement_performed and
         should_do_action(action::move_backward)) {
       transformable.move(direction_ * -speed.backward_movement() *
                          delta_time.asSeconds());
+      moved_ = true;
     }
+  }
 
+  // Draws the "Movement" window, which can edit the attached transformable
+  // directly. Call it once per rendered frame, outside the fixed tick, so
+  // the window is submitted exactly once however many ticks the frame ran.
+  // Returns whether the transformable was edited. Does nothing unless built
+  // with RPG_DEBUG.
+  auto draw_debug_window() -> bool {
 #if defined(RPG_DEBUG) and not defined(RPG_TESTING)
+    auto *const target = resolve_target_();
+    // Headless runs have no ImGui context to draw into.
+    if (target == nullptr or ImGui::GetCurrentContext() == nullptr) {
+      return false;
+    }
+    auto &transformable = *target;
+    auto edited = false;
     ImGui::Begin("Movement");
 
-    const auto text =
-        std::format("direction is ({}, {})", direction_.x, direction_.y);
-    ImGui::TextUnformatted(text.c_str());
+    ImGui::Text("direction is (%f, %f)", direction_.x, direction_.y);
 
     float rotation = transformable.getRotation();
-    ImGui::InputFloat("Rotation", &rotation);
-    transformable.setRotation(rotation);
-    direction_ = math::rotate_vector(transformable.getRotation());
+    if (ImGui::InputFloat("Rotation", &rotation)) {
+      transformable.setRotation(rotation);
+      direction_ = TTrig::rotate_vector(transformable.getRotation());
+      edited = true;
+    }
 
     {
       float vector[] = {transformable.getPosition().x,
                         transformable.getPosition().y};
-      ImGui::InputFloat2("Position", vector);
-      transformable.setPosition(vector[0], vector[1]);
+      if (ImGui::InputFloat2("Position", vector)) {
+        transformable.setPosition(vector[0], vector[1]);
+        edited = true;
+      }
     }
 
     {
       float vector[] = {transformable.getScale().x, transformable.getScale().y};
-      ImGui::InputFloat2("Scale", vector);
-      transformable.setScale(vector[0], vector[1]);
+      if (ImGui::InputFloat2("Scale", vector)) {
+        transformable.setScale(vector[0], vector[1]);
+        edited = true;
+      }
     }
 
     ImGui::End();
+    moved_ = moved_ or edited;
+    return edited;
+#else
+    return false;
 #endif
   }
 };
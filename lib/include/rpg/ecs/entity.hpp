@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace rpg::ecs {
+// An entity is an index into the registry plus the generation that index was
+// on when the entity was created. Destroying an entity bumps the generation,
+// so ids held on to after that no longer match and are rejected instead of
+// silently referring to whatever reuses the index.
+struct entity {
+  std::uint32_t index{std::numeric_limits<std::uint32_t>::max()};
+  std::uint32_t generation{0};
+
+  friend bool operator==(entity, entity) = default;
+};
+
+inline constexpr entity null_entity{};
+
+} // namespace rpg::ecs
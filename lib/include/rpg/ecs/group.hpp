@@ -0,0 +1,84 @@
+#pragma once
+
+#include <rpg/ecs/entity.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+
+namespace rpg::ecs {
+// Keeps the entities that have all of `TOwned` at the front of each of those
+// pools, in the same order. Component i of every owned pool then belongs to
+// the same entity, so a system can walk them as plain parallel arrays, which
+// the compiler is free to vectorise.
+//
+// refresh repacks the pools if any of them changed since the last call and
+// costs nothing otherwise. Repacking is a pass over the first owned pool.
+// Two groups sharing a pool undo each other's packing, so each component
+// type should be owned by at most one group.
+template <class... TOwned> class group {
+  using lead = std::tuple_element_t<0, std::tuple<TOwned...>>;
+
+  std::array<std::uint64_t, sizeof...(TOwned)> versions_{};
+  std::size_t size_{0};
+  bool packed_{false};
+
+  template <class TRegistry>
+  [[nodiscard]] static auto versions_of_(const TRegistry &registry) {
+    return std::array{registry.template storage<TOwned>().version()...};
+  }
+
+public:
+  // Packs the owned pools if needed. Returns the number of entities in the
+  // group.
+  template <class TRegistry> auto refresh(TRegistry &registry) -> std::size_t {
+    if (packed_ and versions_of_(registry) == versions_) {
+      return size_;
+    }
+
+    size_ = 0;
+    const auto entities = registry.template storage<lead>().entities();
+    for (std::size_t i = 0; i < std::size(entities); ++i) {
+      const auto id = entities[i];
+      if (registry.template has<TOwned...>(id)) {
+        (registry.template storage<TOwned>().swap(
+             registry.template storage<TOwned>().position(id), size_),
+         ...);
+        ++size_;
+      }
+    }
+    versions_ = versions_of_(registry);
+    packed_ = true;
+    return size_;
+  }
+
+  // Entities in the group as of the last refresh.
+  [[nodiscard]] auto size() const noexcept { return size_; }
+
+  template <class T, class TRegistry>
+  [[nodiscard]] auto components(TRegistry &registry) const -> std::span<T> {
+    return registry.template storage<T>().components().first(size_);
+  }
+
+  template <class TRegistry>
+  [[nodiscard]] auto entities(const TRegistry &registry) const
+      -> std::span<const entity> {
+    return registry.template storage<lead>().entities().first(size_);
+  }
+
+  // Calls `function(entity, components...)` for every entity in the group.
+  // `function` must not add or remove any of `TOwned`.
+  template <class TRegistry> void each(TRegistry &registry, auto &&function) {
+    refresh(registry);
+    const auto ids = entities(registry);
+    const auto components =
+        std::tuple{this->template components<TOwned>(registry)...};
+    for (std::size_t i = 0; i < size_; ++i) {
+      function(ids[i], std::get<std::span<TOwned>>(components)[i]...);
+    }
+  }
+};
+
+} // namespace rpg::ecs
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <rpg/action.hpp>
+#include <rpg/action_bindings.hpp>
+#include <rpg/controllers/batch_movement.hpp>
+#include <rpg/ecs/entity.hpp>
+#include <rpg/ecs/group.hpp>
+#include <rpg/math.hpp>
+#include <rpg/math/trig.hpp>
+
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Window/Keyboard.hpp>
+
+#include <cstddef>
+#include <functional>
+
+namespace rpg::ecs {
+struct position {
+  float x{0.0f};
+  float y{0.0f};
+};
+
+// Rotation in degrees and the direction it faces. New entities face (1, 0)
+// like a freshly attached rpg::controllers::movement.
+struct heading {
+  float rotation{0.0f};
+  float x{1.0f};
+  float y{0.0f};
+};
+
+struct movement_speed {
+  float frontal{0.0f};
+  float backward{0.0f};
+  float lateral{0.0f};
+  float rotational{0.0f};
+};
+
+// What an entity is asked to do this frame.
+struct movement_actions {
+  controllers::action_set actions{0};
+};
+
+// Marks entities whose movement_actions come from the keyboard.
+struct input_controlled {};
+
+// Turns key presses into movement_actions for every input_controlled entity,
+// with the same action to key mapping as rpg::controllers::movement.
+template <class TInput> class input_system {
+  std::reference_wrapper<TInput> input_;
+  action_bindings bindings_{};
+
+public:
+  explicit input_system(TInput &input) : input_(input) {}
+
+  // Same as rpg::controllers::movement::map_action.
+  void map_action(const rpg::action action, const sf::Keyboard::Key key) {
+    auto released = bindings_.clear(action);
+    if (action_bindings::is_bindable(key)) {
+      bindings_.bind(action, key);
+      input_.get().subscribe(key);
+      released.reset(static_cast<std::size_t>(key));
+    }
+    action_bindings::each_key(
+        released,
+        [this](const sf::Keyboard::Key unused) {
+          input_.get().unsubscribe(unused);
+        });
+  }
+
+  void clear_action(const rpg::action action) {
+    action_bindings::each_key(
+        bindings_.clear(action),
+        [this](const sf::Keyboard::Key key) { input_.get().unsubscribe(key); });
+  }
+
+  // Replaces every binding with `bindings`.
+  void set_bindings(const action_bindings &bindings) {
+    bindings_.each_key(
+        [this](const sf::Keyboard::Key key) { input_.get().unsubscribe(key); });
+    bindings_ = bindings;
+    bindings_.each_key(
+        [this](const sf::Keyboard::Key key) { input_.get().subscribe(key); });
+  }
+
+  // The actions whose chords are held, read once for all entities.
+  [[nodiscard]] auto actions() const -> controllers::action_set {
+    return bindings_.actions(input_.get());
+  }
+
+  template <class TRegistry> void update(TRegistry &registry) {
+    const auto pressed = actions();
+    registry.template each<input_controlled, movement_actions>(
+        [pressed](const entity, const input_controlled &,
+                  movement_actions &actions) { actions.actions = pressed; });
+  }
+};
+
+// rpg::controllers::movement as a system: moves and turns every entity with
+// a position, heading, movement_speed and movement_actions. The rules, and
+// the order the arithmetic is done in, are those of
+// rpg::controllers::batch_movement, so results match a movement controller
+// bit for bit. The system owns those four pools through a group.
+template <class TTrig = math::std_trig> class movement_system {
+  group<position, heading, movement_speed, movement_actions> group_{};
+
+  [[nodiscard]] static float select_(const controllers::action_set actions,
+                                     const controllers::action_set mask) {
+    return (actions & mask) != 0 ? 1.0f : 0.0f;
+  }
+
+public:
+  template <class TRegistry>
+  void update(TRegistry &registry, const auto &delta_time) {
+    using controllers::action_bit;
+    constexpr auto rotate =
+        action_bit(action::rotate_right) | action_bit(action::rotate_left);
+    constexpr auto lateral =
+        action_bit(action::move_right) | action_bit(action::move_left);
+
+    const auto count = group_.refresh(registry);
+    const auto positions = group_.template components<position>(registry);
+    const auto headings = group_.template components<heading>(registry);
+    const auto speeds = group_.template components<movement_speed>(registry);
+    const auto actions =
+        group_.template components<movement_actions>(registry);
+    const auto seconds = delta_time.asSeconds();
+
+    // Movement first, without branches, as in batch_movement.
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto requested = actions[i].actions;
+      const auto sideways = (requested & rotate) != 0 ? 0 : requested;
+      const auto frontal = (sideways & lateral) != 0 ? 0 : sideways;
+      const auto right = select_(sideways, action_bit(action::move_right));
+      const auto left = select_(sideways, action_bit(action::move_left));
+      const auto forward = select_(frontal, action_bit(action::move_forward));
+      const auto backward = select_(frontal, action_bit(action::move_backward));
+
+      const auto direction_x = headings[i].x;
+      const auto direction_y = headings[i].y;
+      const auto lateral_speed = speeds[i].lateral;
+      const auto frontal_speed = speeds[i].frontal;
+      const auto backward_speed = -speeds[i].backward;
+
+      auto x = positions[i].x;
+      auto y = positions[i].y;
+      x = x + -direction_y * lateral_speed * seconds * right;
+      y = y + direction_x * lateral_speed * seconds * right;
+      x = x + direction_y * lateral_speed * seconds * left;
+      y = y + -direction_x * lateral_speed * seconds * left;
+      x = x + direction_x * frontal_speed * seconds * forward;
+      y = y + direction_y * frontal_speed * seconds * forward;
+      x = x + direction_x * backward_speed * seconds * backward;
+      y = y + direction_y * backward_speed * seconds * backward;
+      positions[i].x = x;
+      positions[i].y = y;
+    }
+
+    // Then rotation, only for the entities that rotate.
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto requested = actions[i].actions;
+      if ((requested & rotate) == 0) {
+        continue;
+      }
+      auto rotation = headings[i].rotation;
+      if ((requested & action_bit(action::rotate_right)) != 0) {
+        rotation =
+            math::wrap_degrees(rotation + speeds[i].rotational * seconds);
+      }
+      if ((requested & action_bit(action::rotate_left)) != 0) {
+        rotation =
+            math::wrap_degrees(rotation + -speeds[i].rotational * seconds);
+      }
+      headings[i].rotation = rotation;
+      const auto direction = TTrig::rotate_vector(rotation);
+      headings[i].x = direction.x;
+      headings[i].y = direction.y;
+    }
+  }
+
+  // Entities the last update went over.
+  [[nodiscard]] auto size() const noexcept { return group_.size(); }
+};
+
+// Copies an entity's position and rotation onto `transformable`, e.g. the
+// sprite drawing it.
+inline void store(const position &where, const heading &facing,
+                  sf::Transformable &transformable) {
+  transformable.setPosition(where.x, where.y);
+  transformable.setRotation(facing.rotation);
+}
+
+} // namespace rpg::ecs
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <rpg/ecs/entity.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace rpg::ecs {
+// Sparse set holding the `T` component of every entity that has one. The
+// components are packed into one contiguous array, in the same order as the
+// entities owning them, and a sparse array indexed by entity index finds an
+// entity's position in O(1). Removing moves the last component into the
+// hole, so the arrays never have gaps.
+template <class T> class pool {
+  static constexpr auto npos = std::numeric_limits<std::uint32_t>::max();
+
+  std::vector<std::uint32_t> sparse_{};
+  std::vector<entity> entities_{};
+  std::vector<T> components_{};
+  // Bumped whenever a component is added, removed or moved, so groups can
+  // tell whether their packing still holds.
+  std::uint64_t version_{0};
+
+public:
+  void reserve(const std::size_t count) {
+    entities_.reserve(count);
+    components_.reserve(count);
+  }
+
+  [[nodiscard]] bool contains(const entity id) const noexcept {
+    return id.index < std::size(sparse_) and
+           sparse_[id.index] != npos and
+           entities_[sparse_[id.index]] == id;
+  }
+
+  // Gives `id` a `T` made from `args`, replacing the one it has, if any.
+  template <class... Args> T &emplace(const entity id, Args &&...args) {
+    if (contains(id)) {
+      return components_[sparse_[id.index]] =
+                 T{std::forward<Args>(args)...};
+    }
+    if (id.index >= std::size(sparse_)) {
+      sparse_.resize(id.index + std::size_t{1}, npos);
+    }
+    sparse_[id.index] = static_cast<std::uint32_t>(std::size(entities_));
+    entities_.push_back(id);
+    components_.push_back(T{std::forward<Args>(args)...});
+    ++version_;
+    return components_.back();
+  }
+
+  // Returns whether `id` had a `T` to remove.
+  bool remove(const entity id) {
+    if (not contains(id)) {
+      return false;
+    }
+    const auto position = sparse_[id.index];
+    const auto last = entities_.back();
+    entities_[position] = last;
+    components_[position] = std::move(components_.back());
+    sparse_[last.index] = position;
+    entities_.pop_back();
+    components_.pop_back();
+    sparse_[id.index] = npos;
+    ++version_;
+    return true;
+  }
+
+  // Exchanges the entities, and their components, at two positions.
+  void swap(const std::size_t lhs, const std::size_t rhs) {
+    if (lhs == rhs) {
+      return;
+    }
+    using std::swap;
+    swap(entities_[lhs], entities_[rhs]);
+    swap(components_[lhs], components_[rhs]);
+    sparse_[entities_[lhs].index] = static_cast<std::uint32_t>(lhs);
+    sparse_[entities_[rhs].index] = static_cast<std::uint32_t>(rhs);
+    ++version_;
+  }
+
+  // Position of `id` in entities() and components(). It must have a `T`.
+  [[nodiscard]] auto position(const entity id) const noexcept
+      -> std::size_t {
+    return sparse_[id.index];
+  }
+
+  // `id` must have a `T`.
+  [[nodiscard]] T &get(const entity id) noexcept {
+    return components_[sparse_[id.index]];
+  }
+
+  [[nodiscard]] const T &get(const entity id) const noexcept {
+    return components_[sparse_[id.index]];
+  }
+
+  [[nodiscard]] T *try_get(const entity id) noexcept {
+    return contains(id) ? &get(id) : nullptr;
+  }
+
+  [[nodiscard]] auto entities() const noexcept {
+    return std::span<const entity>{entities_};
+  }
+
+  [[nodiscard]] auto components() noexcept { return std::span<T>{components_}; }
+
+  [[nodiscard]] auto components() const noexcept {
+    return std::span<const T>{components_};
+  }
+
+  [[nodiscard]] auto size() const noexcept { return std::size(entities_); }
+
+  [[nodiscard]] auto version() const noexcept { return version_; }
+};
+
+} // namespace rpg::ecs
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <rpg/ecs/entity.hpp>
+#include <rpg/ecs/pool.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace rpg::ecs {
+// Creates entities and owns one rpg::ecs::pool per component type in
+// `TComponents`. The component types are fixed at compile time, so finding a
+// pool is a std::get rather than a lookup.
+template <class... TComponents> class registry {
+  static constexpr auto retired = std::numeric_limits<std::uint32_t>::max();
+
+  std::vector<std::uint32_t> generations_{};
+  std::vector<std::uint32_t> free_{};
+  std::size_t size_{0};
+  std::tuple<pool<TComponents>...> pools_{};
+
+  // Entities of the smallest of the pools of `TFirst` and `TRest`.
+  template <class TFirst, class... TRest>
+  [[nodiscard]] auto smallest_() const noexcept -> std::span<const entity> {
+    auto smallest = storage<TFirst>().entities();
+    ((smallest = std::size(storage<TRest>()) < std::size(smallest)
+                     ? storage<TRest>().entities()
+                     : smallest),
+     ...);
+    return smallest;
+  }
+
+public:
+  void reserve(const std::size_t count) {
+    generations_.reserve(count);
+    (std::get<pool<TComponents>>(pools_).reserve(count), ...);
+  }
+
+  // Reuses the index of a destroyed entity if there is one.
+  [[nodiscard]] auto create() -> entity {
+    ++size_;
+    if (not free_.empty()) {
+      const auto index = free_.back();
+      free_.pop_back();
+      return {.index = index, .generation = generations_[index]};
+    }
+    generations_.push_back(0);
+    return {.index = static_cast<std::uint32_t>(std::size(generations_) - 1),
+            .generation = 0};
+  }
+
+  // Removes every component of `id` and invalidates it. Returns false if it
+  // was already invalid.
+  bool destroy(const entity id) {
+    if (not valid(id)) {
+      return false;
+    }
+    (std::get<pool<TComponents>>(pools_).remove(id), ...);
+    --size_;
+    // An index whose generation would wrap back to one that may still be
+    // held somewhere is never reused.
+    if (++generations_[id.index] != retired) {
+      free_.push_back(id.index);
+    }
+    return true;
+  }
+
+  [[nodiscard]] bool valid(const entity id) const noexcept {
+    return id.index < std::size(generations_) and
+           generations_[id.index] == id.generation;
+  }
+
+  // Entities created and not yet destroyed.
+  [[nodiscard]] auto size() const noexcept { return size_; }
+
+  template <class T> [[nodiscard]] auto &storage() noexcept {
+    return std::get<pool<T>>(pools_);
+  }
+
+  template <class T> [[nodiscard]] const auto &storage() const noexcept {
+    return std::get<pool<T>>(pools_);
+  }
+
+  // `id` must be valid.
+  template <class T, class... Args>
+  T &emplace(const entity id, Args &&...args) {
+    return storage<T>().emplace(id, std::forward<Args>(args)...);
+  }
+
+  template <class T> bool remove(const entity id) {
+    return storage<T>().remove(id);
+  }
+
+  template <class... T> [[nodiscard]] bool has(const entity id) const {
+    return (storage<T>().contains(id) and ...);
+  }
+
+  // `id` must have a `T`.
+  template <class T> [[nodiscard]] T &get(const entity id) noexcept {
+    return storage<T>().get(id);
+  }
+
+  template <class T> [[nodiscard]] T *try_get(const entity id) noexcept {
+    return storage<T>().try_get(id);
+  }
+
+  // Calls `function(entity, components...)` for every entity with all of
+  // `TRequired`, walking the smallest of their pools. `function` must not
+  // add or remove any of `TRequired`. For hot loops over the same set of
+  // components, rpg::ecs::group packs them so they can be walked as arrays.
+  template <class... TRequired> void each(auto &&function) {
+    const auto entities = smallest_<TRequired...>();
+    for (std::size_t i = 0; i < std::size(entities); ++i) {
+      const auto id = entities[i];
+      if (has<TRequired...>(id)) {
+        function(id, storage<TRequired>().get(id)...);
+      }
+    }
+  }
+};
+
+} // namespace rpg::ecs
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <rpg/ecs/entity.hpp>
+#include <rpg/ecs/group.hpp>
+#include <rpg/inplace_function.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace rpg::ecs {
+// How long until an entity's scheduled_callback runs. Like
+// rpg::scheduled_action, time only counts while it is not paused.
+struct scheduled_delay {
+  float seconds_to_wait{0.0f};
+  float seconds_elapsed_waiting{0.0f};
+  bool paused{false};
+};
+
+// Kept apart from the delay so the countdown loop only streams through the
+// small scheduled_delay array.
+struct scheduled_callback {
+  rpg::inplace_function<void(entity)> action{};
+};
+
+// rpg::scheduled_action as a system. Every entity with a scheduled_delay and
+// a scheduled_callback counts down, and once it has waited long enough the
+// two components are removed and the action is called with the entity. The
+// actions run after the countdown, so they are free to schedule again or
+// destroy entities; actions of entities destroyed that way are dropped.
+class scheduled_action_system {
+  group<scheduled_delay, scheduled_callback> group_{};
+  std::vector<std::pair<entity, rpg::inplace_function<void(entity)>>>
+      firing_{};
+
+public:
+  template <class TRegistry>
+  void update(TRegistry &registry, const auto &delta_time) {
+    const auto count = group_.refresh(registry);
+    const auto delays = group_.template components<scheduled_delay>(registry);
+    const auto callbacks =
+        group_.template components<scheduled_callback>(registry);
+    const auto ids = group_.entities(registry);
+    const auto seconds = delta_time.asSeconds();
+
+    for (std::size_t i = 0; i < count; ++i) {
+      delays[i].seconds_elapsed_waiting += delays[i].paused ? 0.0f : seconds;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      if (not delays[i].paused and
+          delays[i].seconds_elapsed_waiting >= delays[i].seconds_to_wait) {
+        firing_.emplace_back(ids[i], std::move(callbacks[i].action));
+      }
+    }
+
+    for (const auto &[id, action] : firing_) {
+      cancel(registry, id);
+    }
+    for (auto &[id, action] : firing_) {
+      // An action that ran before this one may have destroyed the entity.
+      if (registry.valid(id)) {
+        action(id);
+      }
+    }
+    firing_.clear();
+  }
+
+  // Runs `action` on `id` once `time_to_wait` has passed, replacing whatever
+  // was scheduled for it.
+  template <class TRegistry>
+  static void schedule(TRegistry &registry, const entity id,
+                       const auto time_to_wait,
+                       rpg::inplace_function<void(entity)> action) {
+    registry.template emplace<scheduled_delay>(
+        id, std::chrono::duration<float>(time_to_wait).count());
+    registry.template emplace<scheduled_callback>(id, std::move(action));
+  }
+
+  template <class TRegistry>
+  static void cancel(TRegistry &registry, const entity id) {
+    registry.template remove<scheduled_delay>(id);
+    registry.template remove<scheduled_callback>(id);
+  }
+
+  template <class TRegistry>
+  static void pause(TRegistry &registry, const entity id) {
+    if (auto *const delay = registry.template try_get<scheduled_delay>(id)) {
+      delay->paused = true;
+    }
+  }
+
+  template <class TRegistry>
+  static void resume(TRegistry &registry, const entity id) {
+    if (auto *const delay = registry.template try_get<scheduled_delay>(id)) {
+      delay->paused = false;
+    }
+  }
+};
+
+} // namespace rpg::ecs
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+namespace rpg {
+struct frame_arena_settings {
+  // Bytes each of the two frame buffers starts with. A frame that needs more
+  // still gets its memory, from the heap, and the buffer grows to fit when it
+  // comes round again.
+  std::size_t capacity{std::size_t{1} << 20};
+};
+
+// Bump allocator for data that only lives for a frame or two, such as
+// batched quads or query results. Allocating moves a pointer forward and
+// freeing does nothing; everything is released at once when the buffer is
+// reused, without running destructors, so only put trivially destructible
+// data or pmr containers in it.
+//
+// There are two buffers that take turns: what is allocated during a frame
+// stays valid through the next one, so the next frame can still read it,
+// and is reclaimed when next_frame() starts the frame after. Not thread
+// safe; give each thread that needs one its own arena.
+//
+// Containers use it through memory_resource() or frame_allocator below.
+class frame_arena {
+  struct overflow_block {
+    void *pointer;
+    std::size_t alignment;
+  };
+
+  struct buffer {
+    std::unique_ptr<std::byte[]> memory;
+    std::size_t capacity;
+    std::size_t used{0};
+    // Allocations that did not fit, freed when the buffer is reset.
+    std::vector<overflow_block> overflow{};
+    std::size_t overflow_bytes{0};
+  };
+
+  // Lets pmr containers allocate from the arena's current buffer.
+  class resource final : public std::pmr::memory_resource {
+    frame_arena *arena_;
+
+    void *do_allocate(const std::size_t bytes,
+                      const std::size_t alignment) override {
+      return arena_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+
+    [[nodiscard]] bool
+    do_is_equal(const std::pmr::memory_resource &other) const noexcept
+        override {
+      return this == &other;
+    }
+
+  public:
+    explicit resource(frame_arena &arena) : arena_(&arena) {}
+  };
+
+  std::array<buffer, 2> buffers_;
+  std::size_t current_{0};
+  resource resource_{*this};
+
+  [[nodiscard]] static auto make_buffer_(const std::size_t capacity) {
+    return buffer{.memory = std::make_unique_for_overwrite<std::byte[]>(
+                      capacity),
+                  .capacity = capacity};
+  }
+
+  [[nodiscard]] static void *overflow_(buffer &into, const std::size_t bytes,
+                                       const std::size_t alignment) {
+    into.overflow.reserve(std::size(into.overflow) + 1);
+    auto *const pointer = ::operator new(bytes, std::align_val_t{alignment});
+    into.overflow.push_back({.pointer = pointer, .alignment = alignment});
+    into.overflow_bytes += bytes + alignment;
+    return pointer;
+  }
+
+  static void reset_(buffer &recycled) {
+    if (not std::empty(recycled.overflow)) {
+      for (const auto block : recycled.overflow) {
+        ::operator delete(block.pointer, std::align_val_t{block.alignment});
+      }
+      recycled = make_buffer_(
+          std::bit_ceil(recycled.used + recycled.overflow_bytes));
+      return;
+    }
+    recycled.used = 0;
+  }
+
+public:
+  explicit frame_arena(const frame_arena_settings settings = {})
+      : buffers_{make_buffer_(std::max<std::size_t>(settings.capacity, 1)),
+                 make_buffer_(std::max<std::size_t>(settings.capacity, 1))} {}
+
+  frame_arena(const frame_arena &) = delete;
+  frame_arena &operator=(const frame_arena &) = delete;
+
+  ~frame_arena() {
+    for (auto &held : buffers_) {
+      for (const auto block : held.overflow) {
+        ::operator delete(block.pointer, std::align_val_t{block.alignment});
+      }
+    }
+  }
+
+  // `bytes` of uninitialised memory aligned to `alignment`, a power of two,
+  // that stays valid until next_frame() has been called twice.
+  [[nodiscard]] void *allocate(const std::size_t bytes,
+                               const std::size_t alignment =
+                                   alignof(std::max_align_t)) {
+    auto &into = buffers_[current_];
+    const auto base = reinterpret_cast<std::uintptr_t>(into.memory.get());
+    const auto offset =
+        ((base + into.used + alignment - 1) & ~(alignment - 1)) - base;
+    if (offset + bytes > into.capacity) {
+      return overflow_(into, bytes, alignment);
+    }
+    into.used = offset + bytes;
+    return into.memory.get() + offset;
+  }
+
+  // Starts a frame, reclaiming everything allocated the frame before last.
+  // Constant time unless that frame outgrew its buffer.
+  void next_frame() {
+    current_ ^= 1;
+    reset_(buffers_[current_]);
+  }
+
+  // For pmr containers, such as std::pmr::vector, that only live this frame
+  // and the next.
+  [[nodiscard]] auto memory_resource() noexcept
+      -> std::pmr::memory_resource * {
+    return &resource_;
+  }
+
+  // Bytes allocated this frame, counting those that did not fit.
+  [[nodiscard]] auto used() const noexcept {
+    const auto &held = buffers_[current_];
+    return held.used + held.overflow_bytes;
+  }
+
+  [[nodiscard]] auto capacity() const noexcept {
+    return buffers_[current_].capacity;
+  }
+
+  // Allocations this frame that did not fit in the buffer.
+  [[nodiscard]] auto overflow_count() const noexcept {
+    return std::size(buffers_[current_].overflow);
+  }
+};
+
+// Standard allocator over a frame_arena, for containers that only live this
+// frame and the next. It calls the arena's allocate directly rather than
+// through the pmr resource's virtual do_allocate, so allocating inlines down
+// to the pointer bump.
+template <class T> class frame_allocator {
+  template <class> friend class frame_allocator;
+
+  frame_arena *arena_;
+
+public:
+  using value_type = T;
+
+  explicit frame_allocator(frame_arena &arena) noexcept : arena_(&arena) {}
+
+  template <class U>
+  frame_allocator(const frame_allocator<U> &other) noexcept
+      : arena_(other.arena_) {}
+
+  [[nodiscard]] T *allocate(const std::size_t count) {
+    return static_cast<T *>(arena_->allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *, std::size_t) noexcept {}
+
+  template <class U>
+  friend bool operator==(const frame_allocator &first,
+                         const frame_allocator<U> &second) noexcept {
+    return first.arena_ == second.arena_;
+  }
+};
+
+} // namespace rpg
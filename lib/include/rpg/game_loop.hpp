@@ -0,0 +1,107 @@
+#pragma once
+
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace rpg {
+struct game_loop_settings {
+  // A tick has to last at least the microsecond sf::Time counts in.
+  static constexpr std::uint32_t max_simulation_rate = 1'000'000;
+
+  // Simulation ticks per second, from 1 to max_simulation_rate.
+  std::uint32_t simulation_rate{120};
+  // Most ticks one call to advance may run. Whatever time is left over after
+  // that is dropped, so a slow frame makes the game run slower for a moment
+  // instead of making every following frame slower still. At least 1.
+  std::uint32_t max_ticks_per_frame{8};
+};
+
+// The length of one tick at `settings.simulation_rate`. Throws
+// std::invalid_argument if the settings could never tick.
+[[nodiscard]] inline auto simulation_step(const game_loop_settings &settings)
+    -> sf::Time {
+  if (settings.simulation_rate == 0 or
+      settings.simulation_rate > game_loop_settings::max_simulation_rate) {
+    throw std::invalid_argument{
+        "simulation rate must be between 1 and 1000000 ticks per second"};
+  }
+  if (settings.max_ticks_per_frame == 0) {
+    throw std::invalid_argument{"max ticks per frame must be at least 1"};
+  }
+  return sf::microseconds(1'000'000 / settings.simulation_rate);
+}
+
+// Runs the simulation at a fixed rate no matter how often it is called.
+// Every call to advance adds the real time that passed to an accumulator and
+// runs as many whole ticks as fit in it; the remainder carries over to the
+// next call. alpha says how far the loop is between the last tick and the
+// next one, which is what rendering should interpolate with.
+//
+// Nothing here knows about windows, so the same loop drives the game at any
+// frame rate, or with no rendering at all.
+class game_loop {
+  sf::Time step_;
+  std::uint32_t max_ticks_per_frame_;
+  sf::Time accumulator_{sf::Time::Zero};
+  sf::Time dropped_{sf::Time::Zero};
+  std::uint64_t ticks_{0};
+
+public:
+  explicit game_loop(const game_loop_settings &settings)
+      : step_(simulation_step(settings)),
+        max_ticks_per_frame_(settings.max_ticks_per_frame) {}
+
+  // Calls `simulate(step)` once per tick that is due and returns how many
+  // ticks ran.
+  auto advance(const sf::Time elapsed, auto &&simulate) -> std::uint32_t {
+    accumulator_ += elapsed;
+    std::uint32_t ticks = 0;
+    while (accumulator_ >= step_ and ticks < max_ticks_per_frame_) {
+      simulate(step_);
+      accumulator_ -= step_;
+      ++ticks;
+    }
+    ticks_ += ticks;
+    if (accumulator_ >= step_) {
+      const auto keep = accumulator_ % step_;
+      dropped_ += accumulator_ - keep;
+      accumulator_ = keep;
+    }
+    return ticks;
+  }
+
+  // How far between the last tick and the next one the loop is, in [0, 1).
+  [[nodiscard]] auto alpha() const noexcept -> float {
+    return accumulator_ / step_;
+  }
+
+  [[nodiscard]] auto step() const noexcept { return step_; }
+  [[nodiscard]] auto ticks() const noexcept { return ticks_; }
+
+  // Total time thrown away because a frame had more ticks due than
+  // max_ticks_per_frame.
+  [[nodiscard]] auto dropped_time() const noexcept { return dropped_; }
+};
+
+// Sets `result` to the state `alpha` of the way from `previous` to `current`.
+// Rotation turns the short way round, so 350 to 10 degrees goes through 0.
+inline void interpolate(const sf::Transformable &previous,
+                        const sf::Transformable &current, const float alpha,
+                        sf::Transformable &result) {
+  result.setPosition(previous.getPosition() +
+                     (current.getPosition() - previous.getPosition()) * alpha);
+  result.setScale(previous.getScale() +
+                  (current.getScale() - previous.getScale()) * alpha);
+  auto turn = current.getRotation() - previous.getRotation();
+  if (turn > 180.0f) {
+    turn -= 360.0f;
+  } else if (turn < -180.0f) {
+    turn += 360.0f;
+  }
+  result.setRotation(previous.getRotation() + turn * alpha);
+}
+
+} // namespace rpg
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace rpg::graphics {
+struct sprite_handle {
+  std::uint32_t batch{0};
+  std::uint32_t index{0};
+};
+
+// Draws any number of textured quads with one draw call per texture. Every
+// sprite sharing a texture lives in the same sf::VertexArray, as the two
+// triangles an sf::Sprite with the same texture rect and transform would
+// draw.
+//
+// Quads are only rebuilt for sprites marked dirty, so a frame in which
+// nothing moved costs nothing but the draw calls. The transformables are
+// referenced, not copied, and must outlive the batch.
+class sprite_batch final : public sf::Drawable {
+  static constexpr std::size_t vertices_per_sprite = 6;
+
+  struct batch {
+    std::reference_wrapper<const sf::Texture> texture;
+    sf::VertexArray vertices{sf::Triangles};
+    std::vector<std::reference_wrapper<const sf::Transformable>>
+        transformables{};
+    std::vector<sf::IntRect> texture_rects{};
+    std::vector<std::uint8_t> is_dirty{};
+    std::vector<std::uint32_t> dirty{};
+  };
+
+  std::vector<batch> batches_{};
+  std::size_t rebuilt_{0};
+  mutable std::size_t draw_calls_{0};
+
+  [[nodiscard]] auto find_or_add_batch_(const sf::Texture &texture)
+      -> std::uint32_t {
+    for (std::size_t i = 0; i < std::size(batches_); ++i) {
+      if (&batches_[i].texture.get() == &texture) {
+        return static_cast<std::uint32_t>(i);
+      }
+    }
+    batches_.push_back(batch{.texture = texture});
+    return static_cast<std::uint32_t>(std::size(batches_) - 1);
+  }
+
+  // Same corners and texture coordinates as sf::Sprite.
+  static void build_quad_(const sf::Transformable &transformable,
+                          const sf::IntRect &texture_rect,
+                          sf::Vertex *const vertices) {
+    const auto width = static_cast<float>(std::abs(texture_rect.width));
+    const auto height = static_cast<float>(std::abs(texture_rect.height));
+    const auto left = static_cast<float>(texture_rect.left);
+    const auto top = static_cast<float>(texture_rect.top);
+    const auto right = left + static_cast<float>(texture_rect.width);
+    const auto bottom = top + static_cast<float>(texture_rect.height);
+
+    const auto &transform = transformable.getTransform();
+    const sf::Vertex top_left{transform.transformPoint(0.0f, 0.0f),
+                              {left, top}};
+    const sf::Vertex bottom_left{transform.transformPoint(0.0f, height),
+                                 {left, bottom}};
+    const sf::Vertex top_right{transform.transformPoint(width, 0.0f),
+                               {right, top}};
+    const sf::Vertex bottom_right{transform.transformPoint(width, height),
+                                  {right, bottom}};
+    vertices[0] = top_left;
+    vertices[1] = bottom_left;
+    vertices[2] = top_right;
+    vertices[3] = top_right;
+    vertices[4] = bottom_left;
+    vertices[5] = bottom_right;
+  }
+
+  void draw(sf::RenderTarget &target, sf::RenderStates states) const override {
+    draw_calls_ = 0;
+    for (const auto &batch : batches_) {
+      if (batch.vertices.getVertexCount() == 0) {
+        continue;
+      }
+      states.texture = &batch.texture.get();
+      target.draw(batch.vertices, states);
+      ++draw_calls_;
+    }
+  }
+
+public:
+  // Adds a sprite showing `texture_rect` of `texture`, placed by
+  // `transformable`. It starts out dirty.
+  auto add(const sf::Texture &texture, const sf::IntRect &texture_rect,
+           const sf::Transformable &transformable) -> sprite_handle {
+    const auto batch_index = find_or_add_batch_(texture);
+    auto &batch = batches_[batch_index];
+    const auto index = static_cast<std::uint32_t>(std::size(batch.is_dirty));
+    batch.transformables.push_back(transformable);
+    batch.texture_rects.push_back(texture_rect);
+    batch.is_dirty.push_back(0);
+    batch.vertices.resize(batch.vertices.getVertexCount() +
+                          vertices_per_sprite);
+    const sprite_handle handle{.batch = batch_index, .index = index};
+    mark_dirty(handle);
+    return handle;
+  }
+
+  auto add(const sf::Texture &texture, const sf::Transformable &transformable)
+      -> sprite_handle {
+    const auto size = texture.getSize();
+    return add(texture,
+               sf::IntRect{0, 0, static_cast<int>(size.x),
+                           static_cast<int>(size.y)},
+               transformable);
+  }
+
+  // Queues the sprite's quad to be rebuilt by the next update. Marking a
+  // sprite more than once before update is harmless.
+  void mark_dirty(const sprite_handle handle) {
+    auto &batch = batches_[handle.batch];
+    if (batch.is_dirty[handle.index] == 0) {
+      batch.is_dirty[handle.index] = 1;
+      batch.dirty.push_back(handle.index);
+    }
+  }
+
+  void set_texture_rect(const sprite_handle handle,
+                        const sf::IntRect &texture_rect) {
+    batches_[handle.batch].texture_rects[handle.index] = texture_rect;
+    mark_dirty(handle);
+  }
+
+  // Rebuilds the quads of every dirty sprite from its transformable's
+  // current state.
+  void update() {
+    rebuilt_ = 0;
+    for (auto &batch : batches_) {
+      for (const auto index : batch.dirty) {
+        build_quad_(batch.transformables[index], batch.texture_rects[index],
+                    &batch.vertices[index * vertices_per_sprite]);
+        batch.is_dirty[index] = 0;
+      }
+      rebuilt_ += std::size(batch.dirty);
+      batch.dirty.clear();
+    }
+  }
+
+  [[nodiscard]] auto size() const noexcept {
+    std::size_t size = 0;
+    for (const auto &batch : batches_) {
+      size += std::size(batch.transformables);
+    }
+    return size;
+  }
+
+  [[nodiscard]] auto batch_count() const noexcept {
+    return std::size(batches_);
+  }
+
+  [[nodiscard]] const sf::VertexArray &
+  vertices(const std::uint32_t batch) const {
+    return batches_[batch].vertices;
+  }
+
+  // Quads rebuilt by the last update.
+  [[nodiscard]] auto rebuilt() const noexcept { return rebuilt_; }
+
+  // Draw calls issued by the last draw.
+  [[nodiscard]] auto draw_calls() const noexcept { return draw_calls_; }
+};
+
+} // namespace rpg::graphics
@@ -0,0 +1,305 @@
+#pragma once
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rpg::graphics {
+struct texture_handle {
+  std::uint32_t index{0};
+
+  friend bool operator==(texture_handle, texture_handle) = default;
+};
+
+enum class texture_state : std::uint8_t { loading, loaded, failed };
+
+struct texture_manager_settings {
+  // Threads decoding images. Zero picks one less than the hardware has.
+  std::uint32_t workers{0};
+  // Upload time each update may spend, on top of the one upload it always
+  // does so loading keeps moving however small the budget.
+  sf::Time upload_budget{sf::milliseconds(2)};
+  // Side of the checkerboard shown until a texture has loaded.
+  std::uint32_t placeholder_size{8};
+};
+
+struct texture_manager_stats {
+  std::size_t requested{0};
+  std::size_t loaded{0};
+  std::size_t failed{0};
+  // Uploads done and time spent uploading by the last update.
+  std::size_t frame_uploads{0};
+  sf::Time frame_upload_time{};
+  sf::Time max_frame_upload_time{};
+  // Time from the first request after being idle until everything requested
+  // had been uploaded or had failed. The first of these is the startup time.
+  sf::Time last_load_time{};
+
+  [[nodiscard]] auto pending() const noexcept {
+    return requested - loaded - failed;
+  }
+};
+
+// Loads textures without stalling the frame. Images are decoded on a pool of
+// worker threads; update uploads the decoded ones on the calling thread,
+// which must be the one owning the GL context, until the upload budget is
+// spent.
+//
+// load hands back a handle right away. The texture it refers to lives as
+// long as the manager, never moves, and shows a repeating checkerboard until
+// the image is uploaded into it, so sprites can be pointed at it straight
+// away. Images that fail to decode keep the checkerboard.
+template <class TTexture = sf::Texture, class TImage = sf::Image>
+class texture_manager {
+  struct slot {
+    std::string path;
+    TTexture texture;
+    texture_state state{texture_state::loading};
+  };
+
+  struct job {
+    std::uint32_t index;
+    std::string path;
+    std::optional<std::span<const std::byte>> bytes;
+  };
+
+  struct decoded {
+    std::uint32_t index;
+    std::optional<TImage> image;
+  };
+
+  texture_manager_settings settings_;
+  TTexture placeholder_{};
+  std::deque<slot> slots_{};
+  std::unordered_map<std::string, std::uint32_t> indices_{};
+  texture_manager_stats stats_{};
+  sf::Clock load_clock_{};
+
+  std::mutex jobs_mutex_{};
+  std::condition_variable_any jobs_available_{};
+  std::deque<job> jobs_{};
+
+  std::mutex decoded_mutex_{};
+  std::condition_variable decoded_available_{};
+  std::vector<decoded> decoded_{};
+  std::vector<decoded> uploading_{};
+
+  // Declared last so the workers stop before anything they use goes away.
+  std::vector<std::jthread> workers_{};
+
+  void work_(const std::stop_token stop) {
+    while (true) {
+      job next{};
+      {
+        std::unique_lock lock{jobs_mutex_};
+        // wait returns true once stop is requested if jobs are still queued,
+        // so check for the stop itself; whatever is left is dropped.
+        std::ignore = jobs_available_.wait(lock, stop,
+                                           [&] { return not jobs_.empty(); });
+        if (stop.stop_requested()) {
+          return;
+        }
+        next = std::move(jobs_.front());
+        jobs_.pop_front();
+      }
+
+      decoded result{.index = next.index, .image = std::optional<TImage>{}};
+      result.image.emplace();
+      const auto decoded_image =
+          next.bytes ? result.image->loadFromMemory(std::data(*next.bytes),
+                                                    std::size(*next.bytes))
+                     : result.image->loadFromFile(next.path);
+      if (not decoded_image) {
+        result.image.reset();
+      }
+      {
+        const std::lock_guard lock{decoded_mutex_};
+        decoded_.push_back(std::move(result));
+      }
+      decoded_available_.notify_one();
+    }
+  }
+
+  void make_placeholder_() {
+    const auto size = std::max(settings_.placeholder_size, std::uint32_t{2});
+    TImage image{};
+    image.create(size, size, sf::Color::Black);
+    for (std::uint32_t y = 0; y < size; ++y) {
+      for (std::uint32_t x = 0; x < size; ++x) {
+        if ((x < size / 2) != (y < size / 2)) {
+          image.setPixel(x, y, sf::Color::Magenta);
+        }
+      }
+    }
+    std::ignore = placeholder_.loadFromImage(image);
+    placeholder_.setRepeated(true);
+  }
+
+  void upload_(decoded &result) {
+    auto &slot = slots_[result.index];
+    if (result.image and slot.texture.loadFromImage(*result.image)) {
+      slot.texture.setRepeated(false);
+      slot.state = texture_state::loaded;
+      ++stats_.loaded;
+    } else {
+      slot.state = texture_state::failed;
+      ++stats_.failed;
+    }
+    result.image.reset();
+  }
+
+  void finish_upload_(const sf::Time upload_time) {
+    stats_.frame_upload_time = upload_time;
+    stats_.max_frame_upload_time =
+        std::max(stats_.max_frame_upload_time, upload_time);
+    if (stats_.frame_uploads > 0 and stats_.pending() == 0) {
+      stats_.last_load_time = load_clock_.getElapsedTime();
+    }
+  }
+
+  [[nodiscard]] auto
+  queue_(const std::string &path,
+         const std::optional<std::span<const std::byte>> bytes)
+      -> texture_handle {
+    if (const auto found = indices_.find(path); found != std::end(indices_)) {
+      return {found->second};
+    }
+
+    if (stats_.pending() == 0) {
+      load_clock_.restart();
+    }
+    const auto index = static_cast<std::uint32_t>(std::size(slots_));
+    auto &slot = slots_.emplace_back(path, placeholder_);
+    indices_.emplace(slot.path, index);
+    ++stats_.requested;
+    {
+      const std::lock_guard lock{jobs_mutex_};
+      jobs_.push_back({.index = index, .path = path, .bytes = bytes});
+    }
+    jobs_available_.notify_one();
+    return {index};
+  }
+
+public:
+  explicit texture_manager(const texture_manager_settings settings = {})
+      : settings_(settings) {
+    make_placeholder_();
+    auto workers = settings_.workers;
+    if (workers == 0) {
+      workers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    }
+    workers_.reserve(workers);
+    for (std::uint32_t i = 0; i < workers; ++i) {
+      workers_.emplace_back(
+          [this](const std::stop_token stop) { work_(stop); });
+    }
+  }
+
+  texture_manager(const texture_manager &) = delete;
+  texture_manager &operator=(const texture_manager &) = delete;
+
+  // Queues the file at `path` to be loaded. Loading the same path twice
+  // gives the same handle.
+  [[nodiscard]] auto load(const std::string &path) -> texture_handle {
+    return queue_(path, std::nullopt);
+  }
+
+  // Queues an encoded image already in memory, such as an asset in a mapped
+  // rpg::asset_archive, to be decoded in place. `bytes` must stay valid until
+  // the texture has loaded. `name` identifies it like a path would.
+  [[nodiscard]] auto load(const std::string &name,
+                          const std::span<const std::byte> bytes)
+      -> texture_handle {
+    return queue_(name, bytes);
+  }
+
+  // Uploads decoded images until the upload budget is spent. Call once a
+  // frame from the thread owning the GL context.
+  void update() {
+    stats_.frame_uploads = 0;
+    {
+      const std::lock_guard lock{decoded_mutex_};
+      if (uploading_.empty()) {
+        std::swap(uploading_, decoded_);
+      }
+    }
+
+    sf::Clock clock{};
+    auto uploaded = std::begin(uploading_);
+    while (uploaded != std::end(uploading_)) {
+      upload_(*uploaded);
+      ++uploaded;
+      ++stats_.frame_uploads;
+      if (clock.getElapsedTime() >= settings_.upload_budget) {
+        break;
+      }
+    }
+    uploading_.erase(std::begin(uploading_), uploaded);
+    finish_upload_(clock.getElapsedTime());
+  }
+
+  // Blocks until everything requested so far is uploaded, ignoring the
+  // budget. For tools and tests that need the real textures before going
+  // on.
+  void finish() {
+    stats_.frame_uploads = 0;
+    sf::Clock clock{};
+    while (stats_.pending() > 0) {
+      if (uploading_.empty()) {
+        std::unique_lock lock{decoded_mutex_};
+        decoded_available_.wait(lock, [&] { return not decoded_.empty(); });
+        std::swap(uploading_, decoded_);
+      }
+      for (auto &result : uploading_) {
+        upload_(result);
+        ++stats_.frame_uploads;
+      }
+      uploading_.clear();
+    }
+    finish_upload_(clock.getElapsedTime());
+  }
+
+  [[nodiscard]] const TTexture &get(const texture_handle handle) const {
+    return slots_[handle.index].texture;
+  }
+
+  [[nodiscard]] auto state(const texture_handle handle) const {
+    return slots_[handle.index].state;
+  }
+
+  [[nodiscard]] const std::string &path(const texture_handle handle) const {
+    return slots_[handle.index].path;
+  }
+
+  [[nodiscard]] const TTexture &placeholder() const noexcept {
+    return placeholder_;
+  }
+
+  [[nodiscard]] const texture_manager_stats &stats() const noexcept {
+    return stats_;
+  }
+
+  [[nodiscard]] auto worker_count() const noexcept {
+    return std::size(workers_);
+  }
+};
+
+} // namespace rpg::graphics
@@ -2,7 +2,23 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 
 namespace rpg {
 using guid = std::array<std::byte, 16>;
-}
\ No newline at end of file
+
+// Guids already carry their entropy (random or sequence bits), so instead of
+// running a byte-wise hash over all 16 bytes the two halves are folded
+// together and spread with a single multiply.
+struct guid_hash {
+  [[nodiscard]] std::size_t operator()(const rpg::guid &guid) const noexcept {
+    std::uint64_t high{};
+    std::uint64_t low{};
+    std::memcpy(&high, std::data(guid), sizeof(high));
+    std::memcpy(&low, std::data(guid) + sizeof(high), sizeof(low));
+    const auto product = (high ^ low) * 0x9e3779b97f4a7c15ull;
+    return static_cast<std::size_t>(product ^ (product >> 32));
+  }
+};
+} // namespace rpg
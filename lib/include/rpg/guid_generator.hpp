@@ -0,0 +1,92 @@
+#pragma once
+
+#include <rpg/guid.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace rpg {
+// Generates time ordered guids in the UUIDv7 layout:
+//
+//   48 bits  unix time in milliseconds
+//    4 bits  version (7)
+//   12 bits  sequence, high bits
+//    2 bits  variant (0b10)
+//   26 bits  sequence, low bits
+//   36 bits  random
+//
+// The 38 bit sequence is unique per process. Threads reserve it in blocks
+// from a shared atomic counter and then hand out ids from their block without
+// any further synchronisation, so ids are unique across threads, sort by
+// creation time and keep their order within a millisecond.
+class guid_generator {
+  static constexpr std::uint64_t block_size = 4096;
+  static constexpr std::uint64_t sequence_low_bits = 26;
+  static constexpr std::uint64_t random_bits = 36;
+
+  struct thread_state {
+    std::uint64_t next{0};
+    std::uint64_t end{0};
+    std::uint64_t random{0};
+  };
+
+  inline static std::atomic<std::uint64_t> next_block_{0};
+
+  [[nodiscard]] static thread_state &state_() {
+    thread_local thread_state state{
+        .next = 0,
+        .end = 0,
+        .random = (std::uint64_t{std::random_device{}()} << 32) ^
+                  std::random_device{}(),
+    };
+    return state;
+  }
+
+  // splitmix64
+  [[nodiscard]] static std::uint64_t next_random_(std::uint64_t &state) {
+    auto z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+
+  static void store_big_endian_(rpg::guid &guid, const std::size_t offset,
+                                const std::uint64_t value) {
+    for (std::size_t i = 0; i < 8; ++i) {
+      guid[offset + i] = static_cast<std::byte>(value >> (56 - 8 * i));
+    }
+  }
+
+public:
+  [[nodiscard]] rpg::guid generate() const {
+    auto &state = state_();
+    if (state.next == state.end) {
+      state.next =
+          next_block_.fetch_add(1, std::memory_order_relaxed) * block_size;
+      state.end = state.next + block_size;
+    }
+    const auto sequence = state.next++;
+    const auto milliseconds = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+
+    const auto high = (milliseconds << 16) | (std::uint64_t{0x7} << 12) |
+                      ((sequence >> sequence_low_bits) & 0xfff);
+    const auto low =
+        (std::uint64_t{0b10} << 62) |
+        ((sequence & ((std::uint64_t{1} << sequence_low_bits) - 1))
+         << random_bits) |
+        (next_random_(state.random) >> (64 - random_bits));
+
+    rpg::guid guid;
+    store_big_endian_(guid, 0, high);
+    store_big_endian_(guid, 8, low);
+    return guid;
+  }
+};
+
+} // namespace rpg
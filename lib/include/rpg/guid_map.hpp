@@ -0,0 +1,284 @@
+#pragma once
+
+#include <rpg/guid.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#if defined(__SSE2__) or defined(_M_X64) or                                    \
+    (defined(_M_IX86_FP) and _M_IX86_FP >= 2)
+#define RPG_GUID_MAP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace rpg {
+// Open addressing hash map keyed on rpg::guid, laid out like a swiss table:
+// one control byte per slot holding either a 7 bit fragment of the hash or an
+// empty/deleted marker, scanned 16 slots at a time. Probing visits whole
+// groups of 16 so a lookup is usually one SIMD compare of the control bytes
+// followed by a single 16 byte key compare.
+template <class T, class THash = rpg::guid_hash> class guid_map {
+  static constexpr std::size_t group_size = 16;
+  static constexpr std::int8_t empty_control = -128;
+  static constexpr std::int8_t deleted_control = -2;
+
+  struct slot {
+    rpg::guid key;
+    T value;
+  };
+
+  // Bit i is set when control byte i of the group matches.
+  using bitmask = std::uint32_t;
+
+  std::unique_ptr<std::int8_t[]> control_{};
+  slot *slots_{nullptr};
+  std::size_t capacity_{0};
+  std::size_t size_{0};
+  std::size_t growth_left_{0};
+  [[no_unique_address]] THash hash_{};
+
+  [[nodiscard]] static bitmask match_(const std::int8_t *group,
+                                      const std::int8_t value) noexcept {
+#if defined(RPG_GUID_MAP_SSE2)
+    const auto control =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+    return static_cast<bitmask>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), control)));
+#else
+    bitmask mask = 0;
+    for (std::size_t i = 0; i < group_size; ++i) {
+      mask |= static_cast<bitmask>(group[i] == value) << i;
+    }
+    return mask;
+#endif
+  }
+
+  // Empty and deleted are the only control values with the sign bit set.
+  [[nodiscard]] static bitmask
+  match_empty_or_deleted_(const std::int8_t *group) noexcept {
+#if defined(RPG_GUID_MAP_SSE2)
+    return static_cast<bitmask>(_mm_movemask_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(group))));
+#else
+    bitmask mask = 0;
+    for (std::size_t i = 0; i < group_size; ++i) {
+      mask |= static_cast<bitmask>(group[i] < 0) << i;
+    }
+    return mask;
+#endif
+  }
+
+  [[nodiscard]] static auto h1_(const std::size_t hash) noexcept {
+    return hash >> 7;
+  }
+
+  [[nodiscard]] static auto h2_(const std::size_t hash) noexcept {
+    return static_cast<std::int8_t>(hash & 0x7f);
+  }
+
+  [[nodiscard]] auto group_mask_() const noexcept {
+    return capacity_ / group_size - 1;
+  }
+
+  [[nodiscard]] static auto max_load_(const std::size_t capacity) noexcept {
+    return capacity - capacity / 8;
+  }
+
+  [[nodiscard]] auto find_index_(const rpg::guid &key) const noexcept
+      -> std::size_t {
+    if (capacity_ == 0) {
+      return capacity_;
+    }
+    const auto hash = hash_(key);
+    const auto fragment = h2_(hash);
+    auto group = h1_(hash) & group_mask_();
+    for (std::size_t probe = 1;; ++probe) {
+      const auto *control = control_.get() + group * group_size;
+      for (auto mask = match_(control, fragment); mask != 0;
+           mask &= mask - 1) {
+        const auto index = group * group_size + std::countr_zero(mask);
+        if (slots_[index].key == key) {
+          return index;
+        }
+      }
+      if (match_(control, empty_control) != 0) {
+        return capacity_;
+      }
+      group = (group + probe) & group_mask_();
+    }
+  }
+
+  [[nodiscard]] auto find_insert_index_(const std::size_t hash) const noexcept
+      -> std::size_t {
+    auto group = h1_(hash) & group_mask_();
+    for (std::size_t probe = 1;; ++probe) {
+      if (const auto mask =
+              match_empty_or_deleted_(control_.get() + group * group_size);
+          mask != 0) {
+        return group * group_size + std::countr_zero(mask);
+      }
+      group = (group + probe) & group_mask_();
+    }
+  }
+
+  void rehash_(const std::size_t capacity) {
+    auto old_control = std::move(control_);
+    auto *old_slots = std::exchange(slots_, nullptr);
+    const auto old_capacity = std::exchange(capacity_, capacity);
+
+    control_ = std::make_unique<std::int8_t[]>(capacity_);
+    std::fill_n(control_.get(), capacity_, empty_control);
+    slots_ = std::allocator<slot>{}.allocate(capacity_);
+    growth_left_ = max_load_(capacity_) - size_;
+
+    for (std::size_t i = 0; i < old_capacity; ++i) {
+      if (old_control[i] >= 0) {
+        const auto hash = hash_(old_slots[i].key);
+        const auto index = find_insert_index_(hash);
+        control_[index] = h2_(hash);
+        std::construct_at(slots_ + index, std::move(old_slots[i]));
+        std::destroy_at(old_slots + i);
+      }
+    }
+    if (old_slots != nullptr) {
+      std::allocator<slot>{}.deallocate(old_slots, old_capacity);
+    }
+  }
+
+  void destroy_slots_() noexcept {
+    for (std::size_t i = 0; i < capacity_; ++i) {
+      if (control_[i] >= 0) {
+        std::destroy_at(slots_ + i);
+      }
+    }
+  }
+
+public:
+  guid_map() = default;
+
+  explicit guid_map(const std::size_t count) { reserve(count); }
+
+  guid_map(const guid_map &) = delete;
+  guid_map &operator=(const guid_map &) = delete;
+
+  guid_map(guid_map &&other) noexcept
+      : control_(std::move(other.control_)),
+        slots_(std::exchange(other.slots_, nullptr)),
+        capacity_(std::exchange(other.capacity_, 0)),
+        size_(std::exchange(other.size_, 0)),
+        growth_left_(std::exchange(other.growth_left_, 0)) {}
+
+  guid_map &operator=(guid_map &&other) noexcept {
+    if (this != &other) {
+      std::swap(control_, other.control_);
+      std::swap(slots_, other.slots_);
+      std::swap(capacity_, other.capacity_);
+      std::swap(size_, other.size_);
+      std::swap(growth_left_, other.growth_left_);
+    }
+    return *this;
+  }
+
+  ~guid_map() {
+    if (slots_ != nullptr) {
+      destroy_slots_();
+      std::allocator<slot>{}.deallocate(slots_, capacity_);
+    }
+  }
+
+  void reserve(const std::size_t count) {
+    if (count <= max_load_(capacity_)) {
+      return;
+    }
+    auto capacity = std::max(capacity_, group_size);
+    while (max_load_(capacity) < count) {
+      capacity *= 2;
+    }
+    rehash_(capacity);
+  }
+
+  template <class... Args>
+  auto try_emplace(const rpg::guid &key, Args &&...args)
+      -> std::pair<T *, bool> {
+    if (const auto index = find_index_(key); index != capacity_) {
+      return {&slots_[index].value, false};
+    }
+    if (growth_left_ == 0) {
+      // Grow when genuinely full, otherwise just flush the tombstones.
+      rehash_(size_ >= max_load_(capacity_) / 2
+                  ? std::max(capacity_ * 2, group_size)
+                  : capacity_);
+    }
+    const auto hash = hash_(key);
+    const auto index = find_insert_index_(hash);
+    growth_left_ -= control_[index] == empty_control ? 1 : 0;
+    control_[index] = h2_(hash);
+    std::construct_at(slots_ + index,
+                      slot{key, T(std::forward<Args>(args)...)});
+    ++size_;
+    return {&slots_[index].value, true};
+  }
+
+  [[nodiscard]] T *find(const rpg::guid &key) noexcept {
+    const auto index = find_index_(key);
+    return index == capacity_ ? nullptr : &slots_[index].value;
+  }
+
+  [[nodiscard]] const T *find(const rpg::guid &key) const noexcept {
+    const auto index = find_index_(key);
+    return index == capacity_ ? nullptr : &slots_[index].value;
+  }
+
+  [[nodiscard]] bool contains(const rpg::guid &key) const noexcept {
+    return find_index_(key) != capacity_;
+  }
+
+  bool erase(const rpg::guid &key) {
+    const auto index = find_index_(key);
+    if (index == capacity_) {
+      return false;
+    }
+    std::destroy_at(slots_ + index);
+    // A probe only continues past a group that has no empty slot, so if this
+    // group already has one the slot can go straight back to empty.
+    const auto group = index / group_size * group_size;
+    if (match_(control_.get() + group, empty_control) != 0) {
+      control_[index] = empty_control;
+      ++growth_left_;
+    } else {
+      control_[index] = deleted_control;
+    }
+    --size_;
+    return true;
+  }
+
+  void clear() noexcept {
+    if (slots_ == nullptr) {
+      return;
+    }
+    destroy_slots_();
+    std::fill_n(control_.get(), capacity_, empty_control);
+    size_ = 0;
+    growth_left_ = max_load_(capacity_);
+  }
+
+  template <class F> void for_each(F &&function) {
+    for (std::size_t i = 0; i < capacity_; ++i) {
+      if (control_[i] >= 0) {
+        function(std::as_const(slots_[i].key), slots_[i].value);
+      }
+    }
+  }
+
+  [[nodiscard]] auto size() const noexcept { return size_; }
+
+  [[nodiscard]] auto empty() const noexcept { return size_ == 0; }
+
+  [[nodiscard]] auto capacity() const noexcept { return capacity_; }
+};
+
+} // namespace rpg
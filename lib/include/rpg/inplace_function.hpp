@@ -0,0 +1,112 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace rpg {
+template <class Signature, std::size_t Capacity = 48> class inplace_function;
+
+// Move-only type-erased callable that stores its target inline. Targets that
+// do not fit in `Capacity` bytes are rejected at compile time instead of
+// falling back to the heap, so constructing, moving and invoking never
+// allocates.
+template <class R, class... Args, std::size_t Capacity>
+class inplace_function<R(Args...), Capacity> {
+  struct vtable {
+    R (*invoke)(void *, Args &&...);
+    void (*move)(void *, void *) noexcept;
+    void (*destroy)(void *) noexcept;
+  };
+
+  template <class T>
+  static constexpr vtable vtable_for{
+      .invoke = [](void *target, Args &&...args) -> R {
+        return std::invoke(*static_cast<T *>(target),
+                           std::forward<Args>(args)...);
+      },
+      .move =
+          [](void *destination, void *source) noexcept {
+            std::construct_at(static_cast<T *>(destination),
+                              std::move(*static_cast<T *>(source)));
+            std::destroy_at(static_cast<T *>(source));
+          },
+      .destroy =
+          [](void *target) noexcept {
+            std::destroy_at(static_cast<T *>(target));
+          },
+  };
+
+  alignas(std::max_align_t) std::byte storage_[Capacity];
+  const vtable *vtable_{nullptr};
+
+  void reset_() noexcept {
+    if (vtable_ != nullptr) {
+      vtable_->destroy(storage_);
+      vtable_ = nullptr;
+    }
+  }
+
+  void take_(inplace_function &other) noexcept {
+    if (other.vtable_ != nullptr) {
+      other.vtable_->move(storage_, other.storage_);
+      vtable_ = std::exchange(other.vtable_, nullptr);
+    }
+  }
+
+public:
+  static constexpr auto capacity = Capacity;
+
+  inplace_function() noexcept = default;
+  inplace_function(std::nullptr_t) noexcept {}
+
+  template <class T>
+    requires(not std::same_as<std::remove_cvref_t<T>, inplace_function> and
+             std::is_invocable_r_v<R, std::decay_t<T> &, Args...>)
+  inplace_function(T &&target) {
+    using target_type = std::decay_t<T>;
+    static_assert(sizeof(target_type) <= Capacity,
+                  "callable does not fit in inplace_function storage");
+    static_assert(alignof(target_type) <= alignof(std::max_align_t),
+                  "callable is over-aligned for inplace_function storage");
+    static_assert(std::is_nothrow_move_constructible_v<target_type>,
+                  "inplace_function requires a nothrow movable callable");
+    std::construct_at(reinterpret_cast<target_type *>(storage_),
+                      std::forward<T>(target));
+    vtable_ = &vtable_for<target_type>;
+  }
+
+  inplace_function(inplace_function &&other) noexcept { take_(other); }
+
+  inplace_function &operator=(inplace_function &&other) noexcept {
+    if (this != &other) {
+      reset_();
+      take_(other);
+    }
+    return *this;
+  }
+
+  inplace_function &operator=(std::nullptr_t) noexcept {
+    reset_();
+    return *this;
+  }
+
+  inplace_function(const inplace_function &) = delete;
+  inplace_function &operator=(const inplace_function &) = delete;
+
+  ~inplace_function() { reset_(); }
+
+  [[nodiscard]] explicit operator bool() const noexcept {
+    return vtable_ != nullptr;
+  }
+
+  R operator()(Args... args) {
+    return vtable_->invoke(storage_, std::forward<Args>(args)...);
+  }
+};
+
+} // namespace rpg
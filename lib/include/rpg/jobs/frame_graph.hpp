@@ -0,0 +1,153 @@
+#pragma once
+
+#include <rpg/inplace_function.hpp>
+#include <rpg/jobs/thread_pool.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rpg::jobs {
+// Something systems read or write, such as the transforms or the scheduler.
+struct frame_resource {
+  std::uint8_t index{0};
+
+  friend bool operator==(frame_resource, frame_resource) = default;
+};
+
+// The systems that make up a frame and what each of them reads and writes.
+// Systems run in the order they were added unless they touch nothing in
+// common: a system waits for every earlier system that writes something it
+// reads or writes, and for every earlier system that reads something it
+// writes. Everything else runs concurrently on the pool.
+//
+// The graph can be run every frame; it only works out the dependencies again
+// after systems were added.
+class frame_graph {
+  static constexpr std::size_t max_resources = 64;
+
+  struct node {
+    std::string name;
+    std::uint64_t reads;
+    std::uint64_t writes;
+    rpg::inplace_function<void()> work;
+    std::vector<std::size_t> dependents{};
+    std::size_t dependencies{0};
+    std::atomic<std::size_t> waiting{0};
+    jobs::task task{};
+  };
+
+  std::vector<std::string> resources_{};
+  std::deque<node> nodes_{};
+  std::vector<std::size_t> roots_{};
+  bool compiled_{true};
+  thread_pool *pool_{nullptr};
+  task_counter counter_{};
+
+  [[nodiscard]] static auto mask_(const std::initializer_list<frame_resource>
+                                      resources) noexcept {
+    std::uint64_t mask = 0;
+    for (const auto resource : resources) {
+      mask |= std::uint64_t{1} << resource.index;
+    }
+    return mask;
+  }
+
+  void compile_() {
+    roots_.clear();
+    for (auto &system : nodes_) {
+      system.dependents.clear();
+      system.dependencies = 0;
+    }
+    for (std::size_t later = 0; later < std::size(nodes_); ++later) {
+      auto &system = nodes_[later];
+      for (std::size_t earlier = 0; earlier < later; ++earlier) {
+        auto &before = nodes_[earlier];
+        if ((system.writes & (before.reads | before.writes)) != 0 or
+            (system.reads & before.writes) != 0) {
+          before.dependents.push_back(later);
+          ++system.dependencies;
+        }
+      }
+      if (system.dependencies == 0) {
+        roots_.push_back(later);
+      }
+    }
+    compiled_ = true;
+  }
+
+  void run_(const std::size_t index) {
+    auto &system = nodes_[index];
+    system.work();
+    for (const auto dependent : system.dependents) {
+      auto &next = nodes_[dependent];
+      if (next.waiting.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        pool_->submit(next.task, counter_);
+      }
+    }
+  }
+
+public:
+  frame_graph() = default;
+  frame_graph(const frame_graph &) = delete;
+  frame_graph &operator=(const frame_graph &) = delete;
+
+  [[nodiscard]] auto add_resource(std::string name) -> frame_resource {
+    if (std::size(resources_) == max_resources) {
+      throw std::runtime_error{"frame graph has too many resources"};
+    }
+    resources_.push_back(std::move(name));
+    return {static_cast<std::uint8_t>(std::size(resources_) - 1)};
+  }
+
+  // Adds a system that runs `work` and returns its index.
+  auto add(std::string name, const std::initializer_list<frame_resource> reads,
+           const std::initializer_list<frame_resource> writes,
+           rpg::inplace_function<void()> work) -> std::size_t {
+    const auto index = std::size(nodes_);
+    auto &system = nodes_.emplace_back(std::move(name), mask_(reads),
+                                       mask_(writes), std::move(work));
+    system.task.work = [this, index] { run_(index); };
+    compiled_ = false;
+    return index;
+  }
+
+  // Runs every system once, on `pool` and the calling thread, and returns
+  // when they have all finished.
+  void run(thread_pool &pool) {
+    if (not compiled_) {
+      compile_();
+    }
+    pool_ = &pool;
+    for (auto &system : nodes_) {
+      system.waiting.store(system.dependencies, std::memory_order_relaxed);
+    }
+    for (const auto root : roots_) {
+      pool.submit(nodes_[root].task, counter_);
+    }
+    pool.wait(counter_);
+  }
+
+  [[nodiscard]] auto size() const noexcept { return std::size(nodes_); }
+
+  [[nodiscard]] auto &name(const std::size_t index) const {
+    return nodes_[index].name;
+  }
+
+  // Systems that wait for system `index` to finish before they start.
+  [[nodiscard]] auto dependents(const std::size_t index) {
+    if (not compiled_) {
+      compile_();
+    }
+    return std::span<const std::size_t>{nodes_[index].dependents};
+  }
+};
+
+} // namespace rpg::jobs
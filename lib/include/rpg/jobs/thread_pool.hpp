@@ -0,0 +1,271 @@
+#pragma once
+
+#include <rpg/inplace_function.hpp>
+#include <rpg/jobs/work_stealing_deque.hpp>
+#include <rpg/profiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rpg::jobs {
+// Number of tasks submitted under a counter that have not finished yet.
+class task_counter {
+  std::atomic<std::size_t> pending_{0};
+
+  friend class thread_pool;
+
+public:
+  [[nodiscard]] auto finished() const noexcept {
+    return pending_.load(std::memory_order_acquire) == 0;
+  }
+};
+
+// A unit of work. The pool only ever holds a pointer to it, so it has to stay
+// where it is until its counter says it has finished. Tasks must not throw.
+struct task {
+  rpg::inplace_function<void()> work{};
+  task_counter *counter{nullptr};
+};
+
+// Fixed set of worker threads, each with its own work_stealing_deque. Tasks
+// submitted from a worker go on that worker's deque; tasks submitted from any
+// other thread go on a shared queue. A worker with nothing of its own to do
+// takes from the shared queue and then steals from the other workers.
+//
+// Waiting on a counter does not block the waiting thread: it runs tasks until
+// the counter reaches zero, so the thread that kicks off a frame's work is one
+// more pair of hands, and tasks can wait on tasks they submit.
+class thread_pool {
+  struct worker {
+    work_stealing_deque<task *> tasks{};
+  };
+
+  // How often an idle thread looks for work before going to sleep.
+  static constexpr int idle_spins = 64;
+
+  std::vector<std::unique_ptr<worker>> workers_{};
+  std::mutex injected_mutex_{};
+  std::vector<task *> injected_{};
+  std::size_t injected_head_{0};
+  std::atomic<std::size_t> injected_size_{0};
+  // Bumped whenever there is something new to wake up for: a task, a counter
+  // reaching zero or the pool shutting down.
+  std::atomic<std::uint32_t> epoch_{0};
+  std::vector<std::jthread> threads_{};
+
+  inline static thread_local const thread_pool *current_pool_{nullptr};
+  inline static thread_local std::size_t current_worker_{0};
+
+  [[nodiscard]] auto current_worker_index_() const noexcept -> std::size_t {
+    return current_pool_ == this ? current_worker_ : std::size(workers_);
+  }
+
+  void wake_(const bool everyone) {
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+    if (everyone) {
+      epoch_.notify_all();
+    } else {
+      epoch_.notify_one();
+    }
+  }
+
+  [[nodiscard]] auto pop_injected_() -> task * {
+    if (injected_size_.load(std::memory_order_relaxed) == 0) {
+      return nullptr;
+    }
+    const std::lock_guard lock{injected_mutex_};
+    if (injected_head_ == std::size(injected_)) {
+      return nullptr;
+    }
+    auto *const next = injected_[injected_head_++];
+    if (injected_head_ == std::size(injected_)) {
+      injected_.clear();
+      injected_head_ = 0;
+    }
+    injected_size_.fetch_sub(1, std::memory_order_relaxed);
+    return next;
+  }
+
+  // Looks for a task for worker `self`, or for a thread that is not one of
+  // the workers when `self` is the worker count.
+  [[nodiscard]] auto find_(const std::size_t self) -> task * {
+    const auto count = std::size(workers_);
+    if (self < count) {
+      if (const auto own = workers_[self]->tasks.take()) {
+        return *own;
+      }
+    }
+    if (auto *const injected = pop_injected_()) {
+      return injected;
+    }
+    for (std::size_t i = 1; i <= count; ++i) {
+      const auto victim = (self + i) % (count + 1);
+      if (victim == count) {
+        continue;
+      }
+      if (const auto stolen = workers_[victim]->tasks.steal()) {
+        return *stolen;
+      }
+    }
+    return nullptr;
+  }
+
+  void run_(task *const job) {
+    auto *const counter = job->counter;
+    job->work();
+    // The task and its counter may be gone as soon as this reaches zero.
+    if (counter->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      wake_(true);
+    }
+  }
+
+  void work_(const std::stop_token stop, const std::size_t self) {
+    current_pool_ = this;
+    current_worker_ = self;
+    RPG_PROFILE_THREAD("worker " + std::to_string(self));
+    auto spins = 0;
+    while (not stop.stop_requested()) {
+      if (auto *const job = find_(self)) {
+        run_(job);
+        spins = 0;
+        continue;
+      }
+      if (++spins < idle_spins) {
+        std::this_thread::yield();
+        continue;
+      }
+      const auto seen = epoch_.load(std::memory_order_seq_cst);
+      if (auto *const job = find_(self)) {
+        run_(job);
+        spins = 0;
+        continue;
+      }
+      if (not stop.stop_requested()) {
+        epoch_.wait(seen, std::memory_order_seq_cst);
+      }
+    }
+  }
+
+public:
+  // One less than the hardware has, leaving a core for the thread that
+  // submits and waits.
+  [[nodiscard]] static auto default_worker_count() -> std::size_t {
+    return std::max(std::thread::hardware_concurrency(), 1u) - 1;
+  }
+
+  explicit thread_pool(const std::size_t workers = default_worker_count()) {
+    workers_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+      workers_.push_back(std::make_unique<worker>());
+    }
+    threads_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+      threads_.emplace_back(
+          [this, i](const std::stop_token stop) { work_(stop, i); });
+    }
+  }
+
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+
+  ~thread_pool() {
+    for (auto &thread : threads_) {
+      thread.request_stop();
+    }
+    wake_(true);
+    threads_.clear();
+  }
+
+  // Queues `job` and counts it against `counter`. Neither may go away before
+  // the counter has finished.
+  void submit(task &job, task_counter &counter) {
+    job.counter = &counter;
+    counter.pending_.fetch_add(1, std::memory_order_relaxed);
+    if (const auto self = current_worker_index_(); self < std::size(workers_)) {
+      workers_[self]->tasks.push(&job);
+    } else {
+      const std::lock_guard lock{injected_mutex_};
+      injected_.push_back(&job);
+      injected_size_.fetch_add(1, std::memory_order_relaxed);
+    }
+    wake_(false);
+  }
+
+  // Runs tasks until everything submitted under `counter` has finished.
+  void wait(const task_counter &counter) {
+    const auto self = current_worker_index_();
+    while (not counter.finished()) {
+      if (auto *const job = find_(self)) {
+        run_(job);
+        continue;
+      }
+      const auto seen = epoch_.load(std::memory_order_seq_cst);
+      if (counter.finished()) {
+        return;
+      }
+      if (auto *const job = find_(self)) {
+        run_(job);
+        continue;
+      }
+      epoch_.wait(seen, std::memory_order_seq_cst);
+    }
+  }
+
+  [[nodiscard]] auto worker_count() const noexcept {
+    return std::size(workers_);
+  }
+
+  // Threads that run tasks while one thread waits: the workers and the waiter.
+  [[nodiscard]] auto concurrency() const noexcept {
+    return worker_count() + 1;
+  }
+};
+
+// Calls `body(first, last)` for consecutive chunks of at most `grain` indices
+// covering [first, last), spread over the pool and the calling thread. Chunks
+// are handed out from a shared counter, so a thread that finishes early takes
+// the next one rather than idling. Returns once every chunk has been done.
+template <class TBody>
+void parallel_for(thread_pool &pool, const std::size_t first,
+                  const std::size_t last, const std::size_t grain,
+                  TBody &&body) {
+  // Never more helpers than this, however many workers there are, so the
+  // tasks can live on the stack.
+  constexpr std::size_t max_helpers = 63;
+
+  if (first >= last) {
+    return;
+  }
+  const auto step = std::max<std::size_t>(grain, 1);
+  const auto chunks = (last - first + step - 1) / step;
+  const auto helpers =
+      std::min({chunks - 1, pool.worker_count(), max_helpers});
+  std::atomic<std::size_t> next{first};
+  const auto run = [&] {
+    for (auto begin = next.fetch_add(step, std::memory_order_relaxed);
+         begin < last;
+         begin = next.fetch_add(step, std::memory_order_relaxed)) {
+      body(begin, std::min(begin + step, last));
+    }
+  };
+
+  std::array<task, max_helpers> tasks{};
+  task_counter counter{};
+  for (std::size_t i = 0; i < helpers; ++i) {
+    tasks[i].work = [&run] { run(); };
+    pool.submit(tasks[i], counter);
+  }
+  run();
+  pool.wait(counter);
+}
+
+} // namespace rpg::jobs
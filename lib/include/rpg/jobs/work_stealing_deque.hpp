@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace rpg::jobs {
+// Chase-Lev deque. The owning thread pushes and takes at the bottom like a
+// stack, so it keeps working on whatever is hottest in its cache, while any
+// other thread may steal the oldest item from the top. Only a steal racing
+// a take for the very last item needs a compare-and-swap.
+//
+// This follows Lê et al., "Correct and Efficient Work-Stealing for Weak
+// Memory Models", with the fences folded into sequentially consistent loads
+// and stores so ThreadSanitizer can follow it. Buffers that are outgrown are
+// kept until the deque goes away since a thief may still be reading one.
+template <class T> class work_stealing_deque {
+  static_assert(std::is_trivially_copyable_v<T>);
+
+  struct buffer {
+    std::int64_t mask;
+    std::unique_ptr<std::atomic<T>[]> items;
+
+    explicit buffer(const std::int64_t capacity)
+        : mask(capacity - 1),
+          items(std::make_unique<std::atomic<T>[]>(
+              static_cast<std::size_t>(capacity))) {}
+
+    [[nodiscard]] auto capacity() const noexcept { return mask + 1; }
+
+    [[nodiscard]] auto get(const std::int64_t index) const noexcept {
+      return items[static_cast<std::size_t>(index & mask)].load(
+          std::memory_order_relaxed);
+    }
+
+    void put(const std::int64_t index, const T item) noexcept {
+      items[static_cast<std::size_t>(index & mask)].store(
+          item, std::memory_order_relaxed);
+    }
+  };
+
+  alignas(64) std::atomic<std::int64_t> top_{0};
+  alignas(64) std::atomic<std::int64_t> bottom_{0};
+  std::atomic<buffer *> buffer_;
+  // Owned by the owning thread. The first one is the live buffer until the
+  // deque grows.
+  std::vector<std::unique_ptr<buffer>> buffers_{};
+
+  [[nodiscard]] auto grow_(buffer *const old, const std::int64_t top,
+                           const std::int64_t bottom) -> buffer * {
+    auto *const grown =
+        buffers_.emplace_back(std::make_unique<buffer>(old->capacity() * 2))
+            .get();
+    for (auto index = top; index < bottom; ++index) {
+      grown->put(index, old->get(index));
+    }
+    buffer_.store(grown, std::memory_order_release);
+    return grown;
+  }
+
+public:
+  explicit work_stealing_deque(const std::size_t capacity = 256) {
+    buffers_.push_back(std::make_unique<buffer>(
+        static_cast<std::int64_t>(std::bit_ceil(std::max<std::size_t>(
+            capacity, 2)))));
+    buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+  }
+
+  work_stealing_deque(const work_stealing_deque &) = delete;
+  work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+
+  // Owner only.
+  void push(const T item) {
+    const auto bottom = bottom_.load(std::memory_order_relaxed);
+    const auto top = top_.load(std::memory_order_acquire);
+    auto *items = buffer_.load(std::memory_order_relaxed);
+    if (bottom - top > items->capacity() - 1) {
+      items = grow_(items, top, bottom);
+    }
+    items->put(bottom, item);
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  // Owner only. Takes the most recently pushed item.
+  [[nodiscard]] auto take() -> std::optional<T> {
+    const auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    auto *const items = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_seq_cst);
+    auto top = top_.load(std::memory_order_seq_cst);
+    if (top > bottom) {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+    std::optional<T> item{items->get(bottom)};
+    if (top == bottom) {
+      // Last item; whoever moves top first gets it.
+      if (not top_.compare_exchange_strong(top, top + 1,
+                                           std::memory_order_seq_cst,
+                                           std::memory_order_relaxed)) {
+        item.reset();
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  // Any thread. Takes the oldest item, or nothing if the deque is empty or
+  // another thread got there first.
+  [[nodiscard]] auto steal() -> std::optional<T> {
+    auto top = top_.load(std::memory_order_seq_cst);
+    const auto bottom = bottom_.load(std::memory_order_seq_cst);
+    if (top >= bottom) {
+      return std::nullopt;
+    }
+    const auto item = buffer_.load(std::memory_order_acquire)->get(top);
+    if (not top_.compare_exchange_strong(top, top + 1,
+                                         std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+      return std::nullopt;
+    }
+    return item;
+  }
+
+  // A snapshot that may be stale by the time it is used.
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    const auto bottom = bottom_.load(std::memory_order_relaxed);
+    const auto top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+  }
+
+  [[nodiscard]] auto empty() const noexcept { return size() == 0; }
+
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t {
+    return static_cast<std::size_t>(
+        buffer_.load(std::memory_order_relaxed)->capacity());
+  }
+};
+
+} // namespace rpg::jobs
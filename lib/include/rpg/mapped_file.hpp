@@ -0,0 +1,133 @@
+#pragma once
+
+#if defined(RPG_OS_IS_WINDOWS)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <utility>
+
+namespace rpg {
+// Maps a whole file read-only into memory. The bytes stay valid for as long
+// as the mapped_file lives; pages are only read from disk when touched.
+class mapped_file {
+  std::span<const std::byte> bytes_{};
+
+  [[noreturn]] static void throw_last_error_(const char *what) {
+#if defined(RPG_OS_IS_WINDOWS)
+    throw std::system_error{static_cast<int>(::GetLastError()),
+                            std::system_category(), what};
+#else
+    throw std::system_error{errno, std::generic_category(), what};
+#endif
+  }
+
+  void unmap_() noexcept {
+    if (std::empty(bytes_)) {
+      return;
+    }
+#if defined(RPG_OS_IS_WINDOWS)
+    ::UnmapViewOfFile(std::data(bytes_));
+#else
+    ::munmap(const_cast<std::byte *>(std::data(bytes_)), std::size(bytes_));
+#endif
+    bytes_ = {};
+  }
+
+public:
+  // Throws std::system_error if the file cannot be opened or mapped. Empty
+  // files map to no bytes.
+  explicit mapped_file(const std::filesystem::path &path) {
+#if defined(RPG_OS_IS_WINDOWS)
+    const auto file =
+        ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      throw_last_error_("failed to open file");
+    }
+    LARGE_INTEGER size{};
+    if (not ::GetFileSizeEx(file, &size)) {
+      ::CloseHandle(file);
+      throw_last_error_("failed to stat file");
+    }
+    if (size.QuadPart == 0) {
+      ::CloseHandle(file);
+      return;
+    }
+    const auto mapping =
+        ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(file);
+    if (mapping == nullptr) {
+      throw_last_error_("failed to map file");
+    }
+    const auto *const data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(mapping);
+    if (data == nullptr) {
+      throw_last_error_("failed to map file");
+    }
+    bytes_ = {static_cast<const std::byte *>(data),
+              static_cast<std::size_t>(size.QuadPart)};
+#else
+    const auto file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file == -1) {
+      throw_last_error_("failed to open file");
+    }
+    struct stat status {};
+    if (::fstat(file, &status) == -1) {
+      const auto error = errno;
+      ::close(file);
+      errno = error;
+      throw_last_error_("failed to stat file");
+    }
+    const auto size = static_cast<std::size_t>(status.st_size);
+    if (size == 0) {
+      ::close(file);
+      return;
+    }
+    auto *const data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    const auto error = errno;
+    // The mapping keeps the file alive on its own.
+    ::close(file);
+    if (data == MAP_FAILED) {
+      errno = error;
+      throw_last_error_("failed to map file");
+    }
+    bytes_ = {static_cast<const std::byte *>(data), size};
+#endif
+  }
+
+  mapped_file(const mapped_file &) = delete;
+  mapped_file &operator=(const mapped_file &) = delete;
+
+  mapped_file(mapped_file &&other) noexcept
+      : bytes_(std::exchange(other.bytes_, {})) {}
+
+  mapped_file &operator=(mapped_file &&other) noexcept {
+    if (this != &other) {
+      unmap_();
+      bytes_ = std::exchange(other.bytes_, {});
+    }
+    return *this;
+  }
+
+  ~mapped_file() { unmap_(); }
+
+  [[nodiscard]] auto bytes() const noexcept { return bytes_; }
+};
+
+} // namespace rpg
@@ -24,6 +24,15 @@ constexpr auto _180_over_pi = 180.0 / std::numbers::pi_v<double>;
                                                                  : value);
 }
 
+// Wraps into [0, 360) the same way sf::Transformable::setRotation does.
+[[nodiscard]] inline float wrap_degrees(const float degrees) {
+  auto wrapped = static_cast<float>(std::fmod(degrees, 360));
+  if (wrapped < 0) {
+    wrapped += 360.f;
+  }
+  return wrapped;
+}
+
 [[nodiscard]] inline auto rotate_vector(const auto degrees) -> sf::Vector2f {
   const auto radians = static_cast<float>(degrees_to_radians(degrees));
   return {snap_to_zero(std::cos(radians)), snap_to_zero(std::sin(radians))};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <rpg/math.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+
+// Trig policies for code that turns a rotation in degrees into a direction.
+// A policy is a type with a static rotate_vector(degrees) -> sf::Vector2f.
+// std_trig forwards to math::rotate_vector and is what everything uses by
+// default; sincos_table trades a small, bounded error for a table read.
+namespace rpg::inline math {
+struct std_trig {
+  [[nodiscard]] static auto rotate_vector(const float degrees) {
+    return math::rotate_vector(degrees);
+  }
+};
+
+namespace detail {
+// Taylor series for sin, good to double precision for |x| <= pi / 2. Only
+// used to fill tables at compile time.
+[[nodiscard]] constexpr double constexpr_sin(const double x) {
+  auto term = x;
+  auto sum = x;
+  for (auto n = 1; n < 20; ++n) {
+    term *= -x * x / ((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+} // namespace detail
+
+// sin over one full turn sampled at `Resolution` evenly spaced angles, with
+// cos read from the same table a quarter turn further on. Values in between
+// samples are linearly interpolated, so the absolute error of each component
+// is at most (2 pi / Resolution)^2 / 8 from the interpolation plus a little
+// float rounding; max_error is that bound. For example 256 entries are good
+// to about 7.6e-5 and 4096 entries to about 4e-7. The multiples of 90
+// degrees are exact.
+template <std::size_t Resolution> class sincos_table {
+  static_assert(Resolution >= 8 and Resolution % 4 == 0,
+                "the table must split a full turn into quarter turns");
+
+  static constexpr auto quarter_ = Resolution / 4;
+
+  // One full turn plus a quarter so cos, and the sample after the last one,
+  // never need to wrap around.
+  static constexpr auto values_ = [] {
+    std::array<float, Resolution + quarter_ + 1> values{};
+    constexpr auto step = 2.0 * std::numbers::pi_v<double> / Resolution;
+    for (std::size_t i = 0; i < std::size(values); ++i) {
+      // Fold every sample into the first quadrant so that the table is
+      // symmetric and the zeros and ones land exactly.
+      const auto quadrant = (i / quarter_) % 4;
+      const auto offset = i % quarter_;
+      const auto sin = detail::constexpr_sin(offset * step);
+      const auto cos = detail::constexpr_sin((quarter_ - offset) * step);
+      const auto value = quadrant == 0   ? sin
+                         : quadrant == 1 ? cos
+                         : quadrant == 2 ? -sin
+                                         : -cos;
+      values[i] = static_cast<float>(value);
+    }
+    return values;
+  }();
+
+public:
+  static constexpr auto resolution = Resolution;
+  static constexpr auto max_error =
+      (2.0 * std::numbers::pi_v<double> / Resolution) *
+          (2.0 * std::numbers::pi_v<double> / Resolution) / 8.0 +
+      2.0 * std::numeric_limits<float>::epsilon();
+
+  [[nodiscard]] static constexpr auto sample(const std::size_t index) {
+    return values_[index];
+  }
+
+  [[nodiscard]] static auto rotate_vector(float degrees) {
+    // Beyond 2^24 every float is a whole number of degrees, so taking whole
+    // turns off first is exact and keeps the index below in range.
+    if (std::abs(degrees) >= 16'777'216.0f) {
+      degrees = std::fmod(degrees, 360.0f);
+    }
+    // Worked out in double so the position within the table stays precise
+    // for large angles and big tables.
+    const auto position = static_cast<double>(degrees) * (Resolution / 360.0);
+    auto whole = static_cast<std::int64_t>(position);
+    if (position < static_cast<double>(whole)) {
+      --whole;
+    }
+    constexpr auto turn = static_cast<std::int64_t>(Resolution);
+    const auto index = static_cast<std::size_t>((whole % turn + turn) % turn);
+    const auto fraction =
+        static_cast<float>(position - static_cast<double>(whole));
+    const auto sin =
+        values_[index] + (values_[index + 1] - values_[index]) * fraction;
+    const auto cos =
+        values_[index + quarter_] +
+        (values_[index + quarter_ + 1] - values_[index + quarter_]) * fraction;
+    return sf::Vector2f{snap_to_zero(cos), snap_to_zero(sin)};
+  }
+};
+
+} // namespace rpg::inline math
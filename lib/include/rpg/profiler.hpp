@@ -0,0 +1,399 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) or defined(__i386__)
+#define RPG_PROFILER_RDTSC 1
+#include <x86intrin.h>
+#elif defined(_M_X64) or defined(_M_IX86)
+#define RPG_PROFILER_RDTSC 1
+#include <intrin.h>
+#endif
+
+namespace rpg {
+// Timestamps as cheap as the platform can make them: the time stamp counter
+// on x86, steady_clock nanoseconds elsewhere. The profiler converts them to
+// nanoseconds when it hands zones out.
+struct profile_clock {
+  [[nodiscard]] static auto now() noexcept -> std::uint64_t {
+#if defined(RPG_PROFILER_RDTSC)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+  }
+};
+
+// A finished zone, with times in nanoseconds since the profiler started.
+struct profile_zone {
+  const char *name;
+  std::uint64_t begin;
+  std::uint64_t end;
+  std::uint32_t thread;
+  std::uint32_t depth;
+};
+
+// Collects zones from every thread that records one. Each thread writes into
+// its own ring of the most recent zones without taking a lock; readers copy
+// out whatever has not been overwritten yet, so recording never waits on the
+// timeline or on a trace being written, and old zones are simply lost. A
+// full ring hands out its ring_size - 1 most recent zones, since the oldest
+// slot may be the one being overwritten.
+//
+// A thread that exits hands its ring back. Its zones stay readable until the
+// next thread to record takes the ring over and clears it, so pools that
+// come and go do not keep adding rings.
+//
+// Zone names are not copied and must outlive the profiler, which string
+// literals do.
+class profiler {
+public:
+  static constexpr std::size_t ring_size = std::size_t{1} << 15;
+  static constexpr std::size_t frame_history = 256;
+
+private:
+  // Fields are atomics because a reader may copy a slot while its thread
+  // overwrites it. On x86 release stores and acquire loads of aligned words
+  // cost the same as plain ones.
+  struct slot {
+    std::atomic<const char *> name{nullptr};
+    std::atomic<std::uint64_t> begin{0};
+    std::atomic<std::uint64_t> end{0};
+    std::atomic<std::uint32_t> depth{0};
+  };
+
+  struct ring {
+    std::string name;
+    std::uint32_t index;
+    std::array<slot, ring_size> slots{};
+    // Zones recorded so far. Only the owning thread writes it.
+    alignas(64) std::atomic<std::uint64_t> head{0};
+    // Zones before this one have been cleared.
+    std::atomic<std::uint64_t> floor{0};
+    std::uint32_t depth{0};
+  };
+
+  struct calibration {
+    std::uint64_t start_ticks;
+    double nanoseconds_per_tick;
+  };
+
+  // Gives the owning thread's ring back when the thread exits.
+  struct owner {
+    profiler *from;
+    ring *own;
+
+    ~owner() { from->release_thread_(*own); }
+  };
+
+  calibration clock_{calibrate_()};
+  mutable std::mutex rings_mutex_{};
+  std::vector<std::unique_ptr<ring>> rings_{};
+  // Rings of threads that have exited.
+  std::vector<ring *> free_rings_{};
+  std::array<std::atomic<std::uint64_t>, frame_history> frames_{};
+  std::atomic<std::uint64_t> frame_count_{0};
+
+  [[nodiscard]] auto register_thread_() -> ring * {
+    const std::lock_guard lock{rings_mutex_};
+    if (not free_rings_.empty()) {
+      auto *const reused = free_rings_.back();
+      free_rings_.pop_back();
+      reused->floor.store(reused->head.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+      reused->name = "thread " + std::to_string(reused->index);
+      return reused;
+    }
+    auto &added = *rings_.emplace_back(std::make_unique<ring>());
+    added.index = static_cast<std::uint32_t>(std::size(rings_) - 1);
+    added.name = "thread " + std::to_string(added.index);
+    return &added;
+  }
+
+  void release_thread_(ring &own) {
+    const std::lock_guard lock{rings_mutex_};
+    own.depth = 0;
+    free_rings_.push_back(&own);
+  }
+
+  // Each thread's ring, registered the first time the thread records.
+  // Thread locals are destroyed before statics, so the profiler is still
+  // there when the owner gives the ring back.
+  [[nodiscard]] auto ring_() -> ring & {
+    thread_local const owner own{.from = this, .own = register_thread_()};
+    return *own.own;
+  }
+
+  // Measures how many nanoseconds a clock tick lasts against steady_clock,
+  // once, so that every conversion uses the same rate and times collected at
+  // different moments line up.
+  [[nodiscard]] static auto calibrate_() -> calibration {
+#if defined(RPG_PROFILER_RDTSC)
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto start_ticks = profile_clock::now();
+    auto elapsed = std::chrono::steady_clock::duration{};
+    while (elapsed < std::chrono::milliseconds{2}) {
+      elapsed = std::chrono::steady_clock::now() - start_time;
+    }
+    const auto ticks = profile_clock::now() - start_ticks;
+    return {.start_ticks = start_ticks,
+            .nanoseconds_per_tick =
+                std::chrono::duration<double, std::nano>(elapsed).count() /
+                static_cast<double>(std::max<std::uint64_t>(ticks, 1))};
+#else
+    return {.start_ticks = profile_clock::now(), .nanoseconds_per_tick = 1.0};
+#endif
+  }
+
+  [[nodiscard]] auto to_nanoseconds_(const std::uint64_t ticks) const {
+    return ticks <= clock_.start_ticks
+               ? std::uint64_t{0}
+               : static_cast<std::uint64_t>(
+                     static_cast<double>(ticks - clock_.start_ticks) *
+                     clock_.nanoseconds_per_tick);
+  }
+
+  // Threads find their ring through a thread_local shared by every profiler,
+  // so there is only ever the one.
+  profiler() = default;
+
+  static void write_(ring &own, const char *const name,
+                     const std::uint64_t begin, const std::uint64_t end,
+                     const std::uint32_t depth) noexcept {
+    const auto head = own.head.load(std::memory_order_relaxed);
+    auto &into = own.slots[head & (ring_size - 1)];
+    into.name.store(name, std::memory_order_release);
+    into.begin.store(begin, std::memory_order_release);
+    into.end.store(end, std::memory_order_release);
+    into.depth.store(depth, std::memory_order_release);
+    own.head.store(head + 1, std::memory_order_release);
+  }
+
+public:
+  profiler(const profiler &) = delete;
+  profiler &operator=(const profiler &) = delete;
+
+  // The profiler the RPG_PROFILE_* macros record into.
+  [[nodiscard]] static auto instance() -> profiler & {
+    static profiler global{};
+    return global;
+  }
+
+  // Records a zone on the calling thread, with times from profile_clock.
+  void record(const char *const name, const std::uint64_t begin,
+              const std::uint64_t end, const std::uint32_t depth) noexcept {
+    write_(ring_(), name, begin, end, depth);
+  }
+
+  // Opens a zone on the calling thread, nested in the zones it has open.
+  void enter() noexcept { ++ring_().depth; }
+
+  // Closes the calling thread's innermost zone and records it.
+  void leave(const char *const name, const std::uint64_t begin,
+             const std::uint64_t end) noexcept {
+    auto &own = ring_();
+    write_(own, name, begin, end, --own.depth);
+  }
+
+  // Names the calling thread in the timeline and in traces.
+  void name_thread(std::string name) {
+    auto &own = ring_();
+    const std::lock_guard lock{rings_mutex_};
+    own.name = std::move(name);
+  }
+
+  // Marks the start of a frame on the calling thread's clock.
+  void mark_frame() noexcept {
+    const auto frame = frame_count_.load(std::memory_order_relaxed);
+    frames_[frame % frame_history].store(profile_clock::now(),
+                                         std::memory_order_relaxed);
+    frame_count_.store(frame + 1, std::memory_order_release);
+  }
+
+  [[nodiscard]] auto frame_count() const noexcept {
+    return frame_count_.load(std::memory_order_acquire);
+  }
+
+  // When the `frames_back`th most recent frame started, in nanoseconds
+  // since the profiler started; 0 is the frame in progress. Frames too old
+  // to be remembered start when the profiler did.
+  [[nodiscard]] auto frame_start(const std::size_t frames_back) const
+      -> std::uint64_t {
+    const auto count = frame_count();
+    if (frames_back >= count or frames_back >= frame_history) {
+      return 0;
+    }
+    const auto frame = count - 1 - frames_back;
+    return to_nanoseconds_(
+        frames_[frame % frame_history].load(std::memory_order_relaxed));
+  }
+
+  // Nanoseconds since the profiler started.
+  [[nodiscard]] auto now() const -> std::uint64_t {
+    return to_nanoseconds_(profile_clock::now());
+  }
+
+  // Appends every zone still held that ended at or after `since`, in
+  // nanoseconds, to `zones`, thread by thread and in the order they ended.
+  void collect(std::vector<profile_zone> &zones,
+               const std::uint64_t since = 0) const {
+    const std::lock_guard lock{rings_mutex_};
+    for (const auto &thread : rings_) {
+      const auto head = thread->head.load(std::memory_order_acquire);
+      const auto first =
+          std::max(thread->floor.load(std::memory_order_relaxed),
+                   head > ring_size ? head - ring_size : std::uint64_t{0});
+      const auto copied = std::size(zones);
+      for (auto index = first; index < head; ++index) {
+        const auto &from = thread->slots[index & (ring_size - 1)];
+        zones.push_back(
+            {.name = from.name.load(std::memory_order_acquire),
+             .begin = to_nanoseconds_(
+                 from.begin.load(std::memory_order_acquire)),
+             .end = to_nanoseconds_(from.end.load(std::memory_order_acquire)),
+             .thread = thread->index,
+             .depth = from.depth.load(std::memory_order_acquire)});
+      }
+
+      // Drop whatever the thread may have overwritten while it was being
+      // copied, counting the slot it may be writing right now, and whatever
+      // ended too long ago. Reading a slot the thread had started to
+      // overwrite acquires the head that made it do so.
+      const auto now_head = thread->head.load(std::memory_order_relaxed);
+      const auto valid_from =
+          now_head + 1 > ring_size ? now_head + 1 - ring_size : 0;
+      const auto overwritten = std::min(
+          valid_from > first ? valid_from - first : std::uint64_t{0},
+          head - first);
+      const auto begin =
+          std::begin(zones) + static_cast<std::ptrdiff_t>(copied);
+      const auto kept = std::remove_if(
+          begin + static_cast<std::ptrdiff_t>(overwritten), std::end(zones),
+          [since](const profile_zone &zone) { return zone.end < since; });
+      zones.erase(kept, std::end(zones));
+      zones.erase(begin, begin + static_cast<std::ptrdiff_t>(overwritten));
+    }
+  }
+
+  // Forgets every zone recorded so far.
+  void clear() {
+    const std::lock_guard lock{rings_mutex_};
+    for (const auto &thread : rings_) {
+      thread->floor.store(thread->head.load(std::memory_order_acquire),
+                          std::memory_order_relaxed);
+    }
+  }
+
+  [[nodiscard]] auto thread_count() const {
+    const std::lock_guard lock{rings_mutex_};
+    return std::size(rings_);
+  }
+
+  [[nodiscard]] auto thread_name(const std::uint32_t thread) const
+      -> std::string {
+    const std::lock_guard lock{rings_mutex_};
+    return rings_[thread]->name;
+  }
+
+  // Writes every zone still held in the Chrome trace event format, which
+  // chrome://tracing and https://ui.perfetto.dev open.
+  void write_chrome_trace(std::ostream &out) const {
+    std::vector<profile_zone> zones{};
+    collect(zones);
+    const auto write_string = [&out](const std::string_view text) {
+      out << '"';
+      for (const auto character : text) {
+        if (character == '"' or character == '\\') {
+          out << '\\' << character;
+        } else if (static_cast<unsigned char>(character) < 0x20) {
+          out << ' ';
+        } else {
+          out << character;
+        }
+      }
+      out << '"';
+    };
+    // Microseconds, keeping the nanoseconds as a fraction.
+    const auto write_microseconds = [&out](const std::uint64_t nanoseconds) {
+      const auto fraction = std::to_string(nanoseconds % 1000);
+      out << nanoseconds / 1000 << '.'
+          << std::string(3 - std::size(fraction), '0') << fraction;
+    };
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    auto first = true;
+    for (std::uint32_t thread = 0; thread < thread_count(); ++thread) {
+      out << (first ? "" : ",")
+          << "\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":"
+          << thread << ",\"args\":{\"name\":";
+      write_string(thread_name(thread));
+      out << "}}";
+      first = false;
+    }
+    for (const auto &zone : zones) {
+      out << (first ? "" : ",") << "\n{\"ph\":\"X\",\"name\":";
+      write_string(zone.name);
+      out << ",\"pid\":0,\"tid\":" << zone.thread << ",\"ts\":";
+      write_microseconds(zone.begin);
+      out << ",\"dur\":";
+      write_microseconds(zone.end - zone.begin);
+      out << '}';
+      first = false;
+    }
+    out << "\n]}\n";
+  }
+};
+
+// Records the time from its construction to its destruction as a zone.
+class profile_scope {
+  const char *name_;
+  std::uint64_t begin_;
+
+public:
+  explicit profile_scope(const char *const name) noexcept : name_(name) {
+    profiler::instance().enter();
+    begin_ = profile_clock::now();
+  }
+
+  profile_scope(const profile_scope &) = delete;
+  profile_scope &operator=(const profile_scope &) = delete;
+
+  ~profile_scope() {
+    profiler::instance().leave(name_, begin_, profile_clock::now());
+  }
+};
+
+} // namespace rpg
+
+// Zones are only recorded when built with RPG_PROFILE; otherwise the macros
+// expand to nothing at all.
+#define RPG_PROFILE_CONCAT_(a, b) a##b
+#define RPG_PROFILE_CONCAT(a, b) RPG_PROFILE_CONCAT_(a, b)
+
+#if defined(RPG_PROFILE)
+// Times the rest of the enclosing scope as a zone called `name`.
+#define RPG_PROFILE_ZONE(name)                                                 \
+  const ::rpg::profile_scope RPG_PROFILE_CONCAT(rpg_profile_zone_,            \
+                                                __LINE__) {                    \
+    name                                                                       \
+  }
+#define RPG_PROFILE_FRAME() ::rpg::profiler::instance().mark_frame()
+#define RPG_PROFILE_THREAD(name) ::rpg::profiler::instance().name_thread(name)
+#else
+#define RPG_PROFILE_ZONE(name) static_cast<void>(0)
+#define RPG_PROFILE_FRAME() static_cast<void>(0)
+#define RPG_PROFILE_THREAD(name) static_cast<void>(0)
+#endif
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <rpg/profiler.hpp>
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rpg {
+// ImGui "Profiler" window: a timeline of the last few frames with a lane per
+// thread, nested zones stacked under the zones they ran in, and the zones
+// that took the most time over those frames. Pausing keeps the frames on
+// screen while the game keeps recording.
+class profiler_window {
+  static constexpr int max_frames = 60;
+  static constexpr std::size_t top_zone_count = 10;
+
+  struct total {
+    std::string_view name;
+    std::uint64_t time{0};
+    std::size_t calls{0};
+  };
+
+  const profiler *profiler_;
+  int frames_{3};
+  bool paused_{false};
+  std::uint64_t from_{0};
+  std::uint64_t to_{0};
+  std::vector<profile_zone> zones_{};
+  std::vector<std::uint64_t> frame_starts_{};
+  std::vector<std::string> thread_names_{};
+  std::vector<total> totals_{};
+
+  void capture_() {
+    from_ = profiler_->frame_start(static_cast<std::size_t>(frames_));
+    to_ = profiler_->now();
+    zones_.clear();
+    profiler_->collect(zones_, from_);
+    frame_starts_.clear();
+    for (std::size_t back = 0; back < static_cast<std::size_t>(frames_);
+         ++back) {
+      frame_starts_.push_back(profiler_->frame_start(back));
+    }
+    thread_names_.clear();
+    for (std::uint32_t thread = 0; thread < profiler_->thread_count();
+         ++thread) {
+      thread_names_.push_back(profiler_->thread_name(thread));
+    }
+
+    std::unordered_map<std::string_view, total> by_name{};
+    for (const auto &zone : zones_) {
+      auto &sum = by_name[zone.name];
+      sum.name = zone.name;
+      sum.time += zone.end - std::max(zone.begin, from_);
+      ++sum.calls;
+    }
+    totals_.clear();
+    for (const auto &[name, sum] : by_name) {
+      totals_.push_back(sum);
+    }
+    std::ranges::sort(totals_, std::ranges::greater{}, &total::time);
+    if (std::size(totals_) > top_zone_count) {
+      totals_.resize(top_zone_count);
+    }
+  }
+
+  // The same colour for a zone every frame.
+  [[nodiscard]] static auto colour_(const std::string_view name) -> ImU32 {
+    const auto hash = std::hash<std::string_view>{}(name);
+    return IM_COL32(0x60 + hash % 0x80, 0x60 + (hash >> 8) % 0x80,
+                    0x60 + (hash >> 16) % 0x80, 0xff);
+  }
+
+  void draw_timeline_() const {
+    const auto span = static_cast<float>(std::max<std::uint64_t>(
+        to_ - from_, 1));
+    const auto row = ImGui::GetTextLineHeightWithSpacing();
+    const auto width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+    const auto x_of = [&](const std::uint64_t time, const float left) {
+      return left + static_cast<float>(time - std::min(time, from_)) / span *
+                        width;
+    };
+
+    for (std::uint32_t thread = 0; thread < std::size(thread_names_);
+         ++thread) {
+      std::uint32_t depth = 0;
+      auto any = false;
+      for (const auto &zone : zones_) {
+        if (zone.thread == thread) {
+          depth = std::max(depth, zone.depth);
+          any = true;
+        }
+      }
+      if (not any) {
+        continue;
+      }
+
+      ImGui::TextUnformatted(thread_names_[thread].c_str());
+      const auto origin = ImGui::GetCursorScreenPos();
+      const auto height = static_cast<float>(depth + 1) * row;
+      auto &draw_list = *ImGui::GetWindowDrawList();
+      draw_list.PushClipRect(origin, {origin.x + width, origin.y + height},
+                             true);
+      for (const auto start : frame_starts_) {
+        const auto x = x_of(start, origin.x);
+        draw_list.AddLine({x, origin.y}, {x, origin.y + height},
+                          IM_COL32(0xff, 0xff, 0xff, 0x40));
+      }
+      for (const auto &zone : zones_) {
+        if (zone.thread != thread) {
+          continue;
+        }
+        const ImVec2 low{x_of(zone.begin, origin.x),
+                         origin.y + static_cast<float>(zone.depth) * row};
+        const ImVec2 high{std::max(x_of(zone.end, origin.x), low.x + 1.0f),
+                          low.y + row - 1.0f};
+        draw_list.AddRectFilled(low, high, colour_(zone.name));
+        if (high.x - low.x > ImGui::CalcTextSize(zone.name).x + 4.0f) {
+          draw_list.AddText({low.x + 2.0f, low.y}, IM_COL32(0, 0, 0, 0xff),
+                            zone.name);
+        }
+        if (ImGui::IsMouseHoveringRect(low, high)) {
+          ImGui::SetTooltip(
+              "%s\n%.3f ms", zone.name,
+              static_cast<double>(zone.end - zone.begin) / 1e6);
+        }
+      }
+      draw_list.PopClipRect();
+      ImGui::Dummy({width, height});
+    }
+  }
+
+public:
+  explicit profiler_window(const profiler &source = profiler::instance())
+      : profiler_(&source) {}
+
+  void draw() {
+    // Headless runs have no ImGui context to draw into.
+    if (ImGui::GetCurrentContext() == nullptr) {
+      return;
+    }
+    if (not paused_ or std::empty(zones_)) {
+      capture_();
+    }
+
+    ImGui::Begin("Profiler");
+    ImGui::Checkbox("Pause", &paused_);
+    ImGui::SameLine();
+    ImGui::SliderInt("Frames", &frames_, 1, max_frames);
+    ImGui::Text("%.3f ms, %zu zones",
+                static_cast<double>(to_ - from_) / 1e6, std::size(zones_));
+    draw_timeline_();
+
+    ImGui::Separator();
+    for (const auto &sum : totals_) {
+      ImGui::Text("%8.3f ms %6zu  %.*s", static_cast<double>(sum.time) / 1e6,
+                  sum.calls, static_cast<int>(std::size(sum.name)),
+                  std::data(sum.name));
+    }
+    ImGui::End();
+  }
+};
+
+} // namespace rpg
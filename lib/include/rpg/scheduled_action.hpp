@@ -4,6 +4,7 @@
 
 #include <chrono>
 #include <optional>
+#include <utility>
 
 namespace rpg {
 template <class T = decltype([] {})> class scheduled_action {
@@ -27,7 +28,7 @@ public:
         seconds_to_wait_(
             std::chrono::duration_cast<std::chrono::seconds>(time_to_wait)
                 .count()),
-        action_(action) {}
+        action_(std::move(action)) {}
 
   [[nodiscard]] auto guid() const noexcept { return guid_; }
 
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <rpg/guid.hpp>
+#include <rpg/guid_map.hpp>
+#include <rpg/inplace_function.hpp>
+#include <rpg/slab_pool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <utility>
+
+namespace rpg {
+// Owns any number of scheduled actions in a hierarchical timing wheel. Time is
+// quantised into ticks of `resolution`; four levels of 256 slots cover 2^32
+// ticks and anything further out is parked in the last level until it comes
+// into range. `update` only visits level 0 slots that hold actions and
+// cascades a higher level slot once per wrap of the level below it, so the
+// per-frame cost does not depend on how many actions are pending.
+template <class TGuid> class scheduler {
+  static constexpr std::size_t slot_bits = 8;
+  static constexpr std::size_t slot_count = std::size_t{1} << slot_bits;
+  static constexpr std::uint64_t slot_mask = slot_count - 1;
+  static constexpr std::size_t level_count = 4;
+  static constexpr std::uint64_t max_delta =
+      (std::uint64_t{1} << (slot_bits * level_count)) - 1;
+  static constexpr std::size_t firing_bucket = level_count * slot_count;
+  static constexpr std::size_t no_bucket = firing_bucket + 1;
+
+  struct node {
+    rpg::guid guid{};
+    rpg::inplace_function<void()> action{};
+    // Tick the action fires on, or ticks left to wait while it is paused.
+    std::uint64_t expiry{0};
+    node *prev{nullptr};
+    node *next{nullptr};
+    std::size_t bucket{no_bucket};
+  };
+
+  struct list {
+    node *head{nullptr};
+    node *tail{nullptr};
+  };
+
+  std::reference_wrapper<TGuid> guid_;
+  std::int64_t tick_microseconds_;
+  std::int64_t elapsed_microseconds_{0};
+  // First tick that has not been processed yet.
+  std::uint64_t next_tick_{1};
+  rpg::slab_pool<node> nodes_{};
+  std::array<list, firing_bucket + 1> buckets_{};
+  std::array<std::uint64_t, slot_count / 64> occupied_{};
+  rpg::guid_map<node *> index_{};
+
+  void push_back_(const std::size_t bucket, node *const entry) {
+    auto &list = buckets_[bucket];
+    entry->bucket = bucket;
+    entry->prev = list.tail;
+    entry->next = nullptr;
+    if (list.tail == nullptr) {
+      list.head = entry;
+    } else {
+      list.tail->next = entry;
+    }
+    list.tail = entry;
+    if (bucket < slot_count) {
+      occupied_[bucket / 64] |= std::uint64_t{1} << (bucket % 64);
+    }
+  }
+
+  void unlink_(node *const entry) {
+    auto &list = buckets_[entry->bucket];
+    if (entry->prev == nullptr) {
+      list.head = entry->next;
+    } else {
+      entry->prev->next = entry->next;
+    }
+    if (entry->next == nullptr) {
+      list.tail = entry->prev;
+    } else {
+      entry->next->prev = entry->prev;
+    }
+    if (entry->bucket < slot_count and list.head == nullptr) {
+      occupied_[entry->bucket / 64] &=
+          ~(std::uint64_t{1} << (entry->bucket % 64));
+    }
+    entry->prev = nullptr;
+    entry->next = nullptr;
+    entry->bucket = no_bucket;
+  }
+
+  void insert_(node *const entry) {
+    entry->expiry = std::max(entry->expiry, next_tick_);
+    const auto delta = entry->expiry - next_tick_;
+    if (delta < slot_count) {
+      push_back_(entry->expiry & slot_mask, entry);
+      return;
+    }
+    const auto level = std::min<std::size_t>(
+        (std::bit_width(delta) - 1) / slot_bits, level_count - 1);
+    const auto wheel_expiry = next_tick_ + std::min(delta, max_delta);
+    const auto slot = (wheel_expiry >> (slot_bits * level)) & slot_mask;
+    push_back_(level * slot_count + slot, entry);
+  }
+
+  void cascade_(const std::size_t level, const std::uint64_t slot) {
+    auto *entry =
+        std::exchange(buckets_[level * slot_count + slot], list{}).head;
+    while (entry != nullptr) {
+      auto *const next = entry->next;
+      insert_(entry);
+      entry = next;
+    }
+  }
+
+  void cascade_(const std::uint64_t tick) {
+    std::size_t level = 1;
+    while (level + 1 < level_count and
+           ((tick >> (slot_bits * level)) & slot_mask) == 0) {
+      ++level;
+    }
+    for (; level > 0; --level) {
+      cascade_(level, (tick >> (slot_bits * level)) & slot_mask);
+    }
+  }
+
+  [[nodiscard]] auto next_occupied_(const std::uint64_t slot) const
+      -> std::uint64_t {
+    auto word = slot / 64;
+    auto bits = occupied_[word] & (~std::uint64_t{0} << (slot % 64));
+    while (bits == 0) {
+      if (++word == std::size(occupied_)) {
+        return slot_count;
+      }
+      bits = occupied_[word];
+    }
+    return word * 64 + static_cast<std::uint64_t>(std::countr_zero(bits));
+  }
+
+  void fire_(const std::uint64_t slot) {
+    auto &firing = buckets_[firing_bucket];
+    firing = std::exchange(buckets_[slot], list{});
+    occupied_[slot / 64] &= ~(std::uint64_t{1} << (slot % 64));
+    for (auto *entry = firing.head; entry != nullptr; entry = entry->next) {
+      entry->bucket = firing_bucket;
+    }
+
+    ++next_tick_;
+    while (firing.head != nullptr) {
+      auto *const entry = firing.head;
+      unlink_(entry);
+      std::ignore = index_.erase(entry->guid);
+      auto action = std::move(entry->action);
+      nodes_.destroy(entry);
+      action();
+    }
+  }
+
+  void advance_(const std::uint64_t target) {
+    while (next_tick_ <= target) {
+      const auto slot = next_tick_ & slot_mask;
+      if (slot == 0) {
+        cascade_(next_tick_);
+      }
+      const auto occupied = next_occupied_(slot);
+      const auto tick = next_tick_ - slot + occupied;
+      if (tick > target) {
+        next_tick_ = target + 1;
+        return;
+      }
+      next_tick_ = tick;
+      if (occupied != slot_count) {
+        fire_(occupied);
+      }
+    }
+  }
+
+  [[nodiscard]] auto find_(const rpg::guid &guid) const -> node * {
+    const auto *const entry = index_.find(guid);
+    return entry == nullptr ? nullptr : *entry;
+  }
+
+public:
+  explicit scheduler(TGuid &guid, const std::chrono::microseconds resolution =
+                                      std::chrono::milliseconds{1})
+      : guid_(guid), tick_microseconds_(std::max<std::int64_t>(
+                         resolution.count(), 1)) {}
+
+  scheduler(const scheduler &) = delete;
+  scheduler &operator=(const scheduler &) = delete;
+
+  ~scheduler() {
+    index_.for_each([this](const rpg::guid &, node *const entry) {
+      nodes_.destroy(entry);
+    });
+  }
+
+  auto schedule(const auto time_to_wait, auto &&action) -> rpg::guid {
+    const auto wait = std::max<std::int64_t>(
+        std::chrono::ceil<std::chrono::microseconds>(time_to_wait).count(), 0);
+    auto *const entry = nodes_.create();
+    entry->guid = guid_.get().generate();
+    entry->action = std::forward<decltype(action)>(action);
+    entry->expiry = static_cast<std::uint64_t>(
+        (elapsed_microseconds_ + wait + tick_microseconds_ - 1) /
+        tick_microseconds_);
+    insert_(entry);
+    std::ignore = index_.try_emplace(entry->guid, entry);
+    return entry->guid;
+  }
+
+  void cancel(const rpg::guid &guid) {
+    auto *const entry = find_(guid);
+    if (entry == nullptr) {
+      return;
+    }
+    if (entry->bucket != no_bucket) {
+      unlink_(entry);
+    }
+    std::ignore = index_.erase(guid);
+    nodes_.destroy(entry);
+  }
+
+  void pause(const rpg::guid &guid) {
+    auto *const entry = find_(guid);
+    if (entry == nullptr or entry->bucket == no_bucket) {
+      return;
+    }
+    unlink_(entry);
+    entry->expiry -= next_tick_ - 1;
+  }
+
+  void resume(const rpg::guid &guid) {
+    auto *const entry = find_(guid);
+    if (entry == nullptr or entry->bucket != no_bucket) {
+      return;
+    }
+    entry->expiry += next_tick_ - 1;
+    insert_(entry);
+  }
+
+  [[nodiscard]] auto contains(const rpg::guid &guid) const {
+    return find_(guid) != nullptr;
+  }
+
+  [[nodiscard]] auto is_paused(const rpg::guid &guid) const {
+    const auto *const entry = find_(guid);
+    return entry != nullptr and entry->bucket == no_bucket;
+  }
+
+  // Pre-sizes the action pool and guid index so that keeping up to `count`
+  // actions pending does not allocate.
+  void reserve(const std::size_t count) {
+    nodes_.reserve(count);
+    index_.reserve(count);
+  }
+
+  [[nodiscard]] auto size() const noexcept { return std::size(index_); }
+
+  void update(const auto &delta_time) {
+    elapsed_microseconds_ += delta_time.asMicroseconds();
+    advance_(static_cast<std::uint64_t>(elapsed_microseconds_ /
+                                        tick_microseconds_));
+  }
+};
+
+} // namespace rpg
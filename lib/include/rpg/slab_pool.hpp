@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace rpg {
+// Fixed-size object pool that carves objects out of slabs of `SlabSize`
+// slots. Slabs are never returned until the pool is destroyed and released
+// slots are recycled through an intrusive free list, so once the pool has
+// grown (or been reserved) to its working size, create/destroy do not touch
+// the heap and objects never move.
+template <class T, std::size_t SlabSize = 256> class slab_pool {
+  union slot {
+    slot *next;
+    alignas(T) std::byte storage[sizeof(T)];
+  };
+
+  std::vector<std::unique_ptr<slot[]>> slabs_{};
+  slot *free_{nullptr};
+  std::size_t size_{0};
+
+  void grow_() {
+    auto &slab = slabs_.emplace_back(std::make_unique<slot[]>(SlabSize));
+    for (auto i = SlabSize; i > 0; --i) {
+      slab[i - 1].next = free_;
+      free_ = &slab[i - 1];
+    }
+  }
+
+public:
+  slab_pool() = default;
+  slab_pool(const slab_pool &) = delete;
+  slab_pool &operator=(const slab_pool &) = delete;
+  slab_pool(slab_pool &&) noexcept = default;
+  slab_pool &operator=(slab_pool &&) noexcept = default;
+
+  // Objects still alive when the pool goes away are not destroyed; owners are
+  // expected to destroy what they create.
+  ~slab_pool() = default;
+
+  void reserve(const std::size_t count) {
+    slabs_.reserve((count + SlabSize - 1) / SlabSize);
+    while (capacity() < count) {
+      grow_();
+    }
+  }
+
+  template <class... Args> [[nodiscard]] T *create(Args &&...args) {
+    if (free_ == nullptr) {
+      grow_();
+    }
+    auto *free_slot = free_;
+    free_ = free_slot->next;
+    auto *object = std::construct_at(
+        reinterpret_cast<T *>(free_slot->storage), std::forward<Args>(args)...);
+    ++size_;
+    return object;
+  }
+
+  void destroy(T *object) noexcept {
+    std::destroy_at(object);
+    auto *released = reinterpret_cast<slot *>(object);
+    released->next = free_;
+    free_ = released;
+    --size_;
+  }
+
+  [[nodiscard]] auto size() const noexcept { return size_; }
+
+  [[nodiscard]] auto capacity() const noexcept {
+    return std::size(slabs_) * SlabSize;
+  }
+};
+
+} // namespace rpg
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace rpg {
+// Refers to a value in a slot_map: the slot it was given plus the generation
+// that slot was on when it was inserted. Erasing bumps the slot's
+// generation, so handles held on to after that are rejected instead of
+// finding whatever reuses the slot.
+struct slot_handle {
+  std::uint32_t index{std::numeric_limits<std::uint32_t>::max()};
+  std::uint32_t generation{0};
+
+  friend bool operator==(slot_handle, slot_handle) = default;
+};
+
+inline constexpr slot_handle null_slot_handle{};
+
+// Pool of `T` addressed by slot_handle. The values are packed into one
+// contiguous array, so iterating over them is a linear walk, and each slot
+// records where its value currently is. Erasing moves the last value into
+// the hole and growing may reallocate the array, but handles stay valid
+// through both since they go through the slot. Insert, erase and lookup are
+// O(1); erased slots are reused through a free list.
+template <class T> class slot_map {
+  static constexpr auto npos = std::numeric_limits<std::uint32_t>::max();
+  static constexpr auto retired = std::numeric_limits<std::uint32_t>::max();
+
+  struct slot {
+    // Position of the value while the slot is in use, the next free slot
+    // while it is not, and npos once it is retired.
+    std::uint32_t position;
+    std::uint32_t generation;
+  };
+
+  std::vector<slot> slots_{};
+  std::vector<T> values_{};
+  // Slot of each value, in the same order as values_.
+  std::vector<std::uint32_t> owners_{};
+  std::uint32_t free_{npos};
+
+  // Invalidates the handles to the slot at `index` and frees it. A slot
+  // whose generation would wrap back to one that may still be held somewhere
+  // is never reused, the same as rpg::ecs::registry does with entities.
+  void release_(const std::uint32_t index) noexcept {
+    auto &released = slots_[index];
+    if (++released.generation == retired) {
+      released.position = npos;
+    } else {
+      released.position = std::exchange(free_, index);
+    }
+  }
+
+public:
+  void reserve(const std::size_t count) {
+    slots_.reserve(count);
+    values_.reserve(count);
+    owners_.reserve(count);
+  }
+
+  // Adds a `T` made from `args` and returns its handle.
+  template <class... Args>
+  [[nodiscard]] slot_handle insert(Args &&...args) {
+    const auto position = static_cast<std::uint32_t>(std::size(values_));
+    values_.emplace_back(std::forward<Args>(args)...);
+    auto index = free_;
+    if (index == npos) {
+      index = static_cast<std::uint32_t>(std::size(slots_));
+      slots_.push_back({.position = position, .generation = 0});
+    } else {
+      free_ = slots_[index].position;
+      slots_[index].position = position;
+    }
+    owners_.push_back(index);
+    return {.index = index, .generation = slots_[index].generation};
+  }
+
+  [[nodiscard]] bool contains(const slot_handle handle) const noexcept {
+    if (handle.index >= std::size(slots_)) {
+      return false;
+    }
+    const auto &held = slots_[handle.index];
+    // A free slot's position is the next free slot, so the owner check also
+    // rejects handles made up or taken from another map.
+    return held.generation == handle.generation and
+           held.position < std::size(owners_) and
+           owners_[held.position] == handle.index;
+  }
+
+  // Returns whether `handle` still referred to a value.
+  bool erase(const slot_handle handle) {
+    if (not contains(handle)) {
+      return false;
+    }
+    const auto position = slots_[handle.index].position;
+    const auto last = owners_.back();
+    if (position + std::size_t{1} != std::size(values_)) {
+      values_[position] = std::move(values_.back());
+      owners_[position] = last;
+      slots_[last].position = position;
+    }
+    values_.pop_back();
+    owners_.pop_back();
+    release_(handle.index);
+    return true;
+  }
+
+  void clear() {
+    for (const auto index : owners_) {
+      release_(index);
+    }
+    values_.clear();
+    owners_.clear();
+  }
+
+  // `handle` must be valid.
+  [[nodiscard]] T &get(const slot_handle handle) noexcept {
+    return values_[slots_[handle.index].position];
+  }
+
+  [[nodiscard]] const T &get(const slot_handle handle) const noexcept {
+    return values_[slots_[handle.index].position];
+  }
+
+  // nullptr if `handle` was erased or never came from this map.
+  [[nodiscard]] T *try_get(const slot_handle handle) noexcept {
+    return contains(handle) ? &get(handle) : nullptr;
+  }
+
+  [[nodiscard]] const T *try_get(const slot_handle handle) const noexcept {
+    return contains(handle) ? &get(handle) : nullptr;
+  }
+
+  // Handle of the value at `position` in values().
+  [[nodiscard]] auto handle(const std::size_t position) const noexcept
+      -> slot_handle {
+    const auto index = owners_[position];
+    return {.index = index, .generation = slots_[index].generation};
+  }
+
+  [[nodiscard]] auto values() noexcept { return std::span<T>{values_}; }
+
+  [[nodiscard]] auto values() const noexcept {
+    return std::span<const T>{values_};
+  }
+
+  [[nodiscard]] auto begin() noexcept { return std::begin(values_); }
+  [[nodiscard]] auto end() noexcept { return std::end(values_); }
+  [[nodiscard]] auto begin() const noexcept { return std::cbegin(values_); }
+  [[nodiscard]] auto end() const noexcept { return std::cend(values_); }
+
+  [[nodiscard]] auto size() const noexcept { return std::size(values_); }
+  [[nodiscard]] auto empty() const noexcept { return std::empty(values_); }
+};
+
+} // namespace rpg
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace rpg {
+struct spatial_hash_settings {
+  // Side of a grid cell. Queries are cheapest when the usual query radius is
+  // around half of this, so a query covers at most four cells.
+  float cell_size{64.0f};
+  // Buckets the cells are hashed into, rounded up to a power of two. More
+  // buckets than occupied cells keeps unrelated cells from sharing one.
+  std::uint32_t bucket_count{4096};
+};
+
+// Uniform grid over an unbounded world. Every point lives in the cell its
+// position falls in, and cells are hashed into a fixed number of buckets, so
+// memory depends on the number of points rather than on how far apart they
+// are. Each bucket keeps a copy of its points' positions next to their ids,
+// so a query reads contiguous memory and never looks anything up by id.
+//
+// Points are identified by small integers, such as batch_movement indices or
+// entity indices, and stored in a table indexed by id. update only moves a
+// point to another bucket when it crossed into another cell; otherwise it
+// just overwrites the stored position.
+class spatial_hash {
+  static constexpr auto absent = std::numeric_limits<std::uint32_t>::max();
+
+  struct cell {
+    std::int32_t x;
+    std::int32_t y;
+
+    friend bool operator==(cell, cell) = default;
+  };
+
+  struct entry {
+    sf::Vector2f position;
+    cell where;
+    std::uint32_t id;
+  };
+
+  struct location {
+    std::uint32_t bucket{absent};
+    std::uint32_t slot{absent};
+  };
+
+  float cell_size_;
+  float inverse_cell_size_;
+  std::uint32_t bucket_mask_;
+  std::vector<std::vector<entry>> buckets_;
+  std::vector<location> locations_{};
+  std::size_t size_{0};
+  std::size_t rebucketed_{0};
+
+  // Points further out than the cell coordinates reach share the outermost
+  // cells.
+  [[nodiscard]] auto cell_of_(const sf::Vector2f position) const noexcept
+      -> cell {
+    // The largest floats on either side of the int32 range.
+    constexpr auto lowest = -2147483648.0f;
+    constexpr auto highest = 2147483520.0f;
+    const auto coordinate = [&](const float value) {
+      return static_cast<std::int32_t>(
+          std::clamp(std::floor(value * inverse_cell_size_), lowest, highest));
+    };
+    return {coordinate(position.x), coordinate(position.y)};
+  }
+
+  // Teschner et al., "Optimized Spatial Hashing for Collision Detection of
+  // Deformable Objects".
+  [[nodiscard]] auto bucket_of_(const cell where) const noexcept {
+    return ((static_cast<std::uint32_t>(where.x) * 73856093u) ^
+            (static_cast<std::uint32_t>(where.y) * 19349663u)) &
+           bucket_mask_;
+  }
+
+  void link_(const std::uint32_t id, const sf::Vector2f position,
+             const cell where) {
+    const auto bucket = bucket_of_(where);
+    auto &entries = buckets_[bucket];
+    locations_[id] = {.bucket = bucket,
+                      .slot = static_cast<std::uint32_t>(std::size(entries))};
+    entries.push_back({.position = position, .where = where, .id = id});
+  }
+
+  void unlink_(const location at) {
+    auto &entries = buckets_[at.bucket];
+    entries[at.slot] = entries.back();
+    locations_[entries[at.slot].id].slot = at.slot;
+    entries.pop_back();
+  }
+
+  // Calls `visit(entry)` for every entry in the cells overlapping
+  // [low, high], and possibly for others outside it.
+  void each_in_cells_(const sf::Vector2f low, const sf::Vector2f high,
+                      auto &&visit) const {
+    const auto first = cell_of_(low);
+    const auto last = cell_of_(high);
+    // Counted in double, since the cells between two far apart int32
+    // coordinates can outnumber what a 64 bit integer holds.
+    const auto span = [](const std::int32_t from, const std::int32_t to) {
+      return static_cast<double>(to) - static_cast<double>(from) + 1.0;
+    };
+    if (span(first.x, last.x) * span(first.y, last.y) >
+        static_cast<double>(bucket_count())) {
+      // Most of that many cells would be empty; reading every bucket once is
+      // cheaper than hashing each of them.
+      for (const auto &entries : buckets_) {
+        for (const auto &candidate : entries) {
+          const auto position = candidate.position;
+          if (position.x >= low.x and position.x <= high.x and
+              position.y >= low.y and position.y <= high.y) {
+            visit(candidate);
+          }
+        }
+      }
+      return;
+    }
+    // Wide enough that stepping past the last cell cannot overflow.
+    for (std::int64_t y = first.y; y <= last.y; ++y) {
+      for (std::int64_t x = first.x; x <= last.x; ++x) {
+        const cell where{static_cast<std::int32_t>(x),
+                         static_cast<std::int32_t>(y)};
+        for (const auto &candidate : buckets_[bucket_of_(where)]) {
+          // Other cells may hash into the same bucket.
+          if (candidate.where == where) {
+            visit(candidate);
+          }
+        }
+      }
+    }
+  }
+
+public:
+  explicit spatial_hash(const spatial_hash_settings settings = {})
+      : cell_size_(settings.cell_size),
+        inverse_cell_size_(1.0f / settings.cell_size),
+        bucket_mask_(std::bit_ceil(std::max(settings.bucket_count, 1u)) - 1),
+        buckets_(bucket_mask_ + std::size_t{1}) {}
+
+  // Sizes the id table for ids below `count`.
+  void reserve(const std::size_t count) {
+    if (count > std::size(locations_)) {
+      locations_.resize(count);
+    }
+  }
+
+  // Adds `id` at `position`, or moves it there if it is already present.
+  void insert(const std::uint32_t id, const sf::Vector2f position) {
+    reserve(std::size_t{id} + 1);
+    if (locations_[id].bucket != absent) {
+      std::ignore = update(id, position);
+      return;
+    }
+    link_(id, position, cell_of_(position));
+    ++size_;
+  }
+
+  // Moves `id` to `position`. Returns whether it changed cells and so had to
+  // be moved to another bucket; ids that are not present are left out and
+  // give false.
+  auto update(const std::uint32_t id, const sf::Vector2f position) -> bool {
+    if (not contains(id)) {
+      return false;
+    }
+    const auto at = locations_[id];
+    auto &stored = buckets_[at.bucket][at.slot];
+    const auto where = cell_of_(position);
+    if (where == stored.where) {
+      stored.position = position;
+      return false;
+    }
+    unlink_(at);
+    link_(id, position, where);
+    ++rebucketed_;
+    return true;
+  }
+
+  // Moves point i to positions[i] for every point present with an id below
+  // the size of `positions`.
+  void update(const std::span<const sf::Vector2f> positions) {
+    const auto count = std::min(std::size(positions), std::size(locations_));
+    for (std::size_t id = 0; id < count; ++id) {
+      std::ignore = update(static_cast<std::uint32_t>(id), positions[id]);
+    }
+  }
+
+  auto remove(const std::uint32_t id) -> bool {
+    if (not contains(id)) {
+      return false;
+    }
+    unlink_(locations_[id]);
+    locations_[id] = {};
+    --size_;
+    return true;
+  }
+
+  void clear() {
+    for (auto &entries : buckets_) {
+      entries.clear();
+    }
+    std::ranges::fill(locations_, location{});
+    size_ = 0;
+  }
+
+  [[nodiscard]] auto contains(const std::uint32_t id) const noexcept -> bool {
+    return id < std::size(locations_) and locations_[id].bucket != absent;
+  }
+
+  [[nodiscard]] auto position(const std::uint32_t id) const {
+    const auto at = locations_[id];
+    return buckets_[at.bucket][at.slot].position;
+  }
+
+  // Calls `visit(id, position)` for every point within `radius` of `center`,
+  // boundary included.
+  void query_radius(const sf::Vector2f center, const float radius,
+                    auto &&visit) const {
+    const auto radius_squared = radius * radius;
+    each_in_cells_(center - sf::Vector2f{radius, radius},
+                   center + sf::Vector2f{radius, radius},
+                   [&](const entry &candidate) {
+                     const auto offset = candidate.position - center;
+                     if (offset.x * offset.x + offset.y * offset.y <=
+                         radius_squared) {
+                       visit(candidate.id, candidate.position);
+                     }
+                   });
+  }
+
+  // Calls `visit(id, position)` for every point inside `area`, edges
+  // included.
+  void query_rect(const sf::FloatRect &area, auto &&visit) const {
+    const sf::Vector2f low{area.left, area.top};
+    const sf::Vector2f high{area.left + area.width, area.top + area.height};
+    each_in_cells_(low, high, [&](const entry &candidate) {
+      const auto position = candidate.position;
+      if (position.x >= low.x and position.x <= high.x and
+          position.y >= low.y and position.y <= high.y) {
+        visit(candidate.id, position);
+      }
+    });
+  }
+
+  // Radius queries around every point of `centers` at once. The ids found
+  // around centers[i] end up in ids[offsets[i]] to ids[offsets[i + 1]], so
+  // the results of a whole batch share two vectors that can be kept from
+  // frame to frame.
+  void query_radius(const std::span<const sf::Vector2f> centers,
+                    const float radius, std::vector<std::uint32_t> &ids,
+                    std::vector<std::size_t> &offsets) const {
+    ids.clear();
+    offsets.clear();
+    offsets.reserve(std::size(centers) + 1);
+    for (const auto center : centers) {
+      offsets.push_back(std::size(ids));
+      query_radius(center, radius,
+                   [&](const std::uint32_t id, sf::Vector2f) {
+                     ids.push_back(id);
+                   });
+    }
+    offsets.push_back(std::size(ids));
+  }
+
+  // Calls `visit(first, second)` once for every pair of points at most
+  // `radius` apart, with first < second. This is the broad phase for
+  // collisions.
+  void each_pair(const float radius, auto &&visit) const {
+    for (const auto &entries : buckets_) {
+      for (const auto &point : entries) {
+        query_radius(point.position, radius,
+                     [&](const std::uint32_t other, sf::Vector2f) {
+                       if (point.id < other) {
+                         visit(point.id, other);
+                       }
+                     });
+      }
+    }
+  }
+
+  [[nodiscard]] auto size() const noexcept { return size_; }
+  [[nodiscard]] auto cell_size() const noexcept { return cell_size_; }
+  [[nodiscard]] auto bucket_count() const noexcept {
+    return std::size(buckets_);
+  }
+
+  // Updates that moved a point to another cell since the last call.
+  [[nodiscard]] auto take_rebucketed() noexcept {
+    return std::exchange(rebucketed_, 0);
+  }
+};
+
+} // namespace rpg
@@ -0,0 +1,7 @@
+#pragma once
+
+// Configured by CMake. The archive is built from the texture atlas pages by
+// the texture_archive target.
+namespace rpg::inline texture_archive {
+inline constexpr auto path = "@RPG_TEXTURE_ARCHIVE@";
+}
@@ -1,6 +0,0 @@
-#pragma once
-
-namespace rpg::inline texture_paths {
-static constexpr auto survivor_idle_shotgun_0 =
-    "@CMAKE_BINARY_DIR@/textures/survivor-idle_shotgun_0.png";
-}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <rpg/window/key_bitset.hpp>
+#include <rpg/window/key_position.hpp>
+#include <rpg/window/key_state.hpp>
+
+#include <SFML/Window/Keyboard.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <functional>
+
+namespace rpg::window {
+// Drop in replacement for rpg::window::input that keeps key state in
+// sf::Keyboard::KeyCount wide bitsets instead of a sorted map. Transitions for
+// a whole word of keys are found with a couple of XOR/AND operations and
+// get_key_state is a table lookup indexed by three bits of state.
+//
+// If TInput can produce a whole key_bitset per frame through `snapshot()` it
+// is used instead of asking `is_key_pressed` once per subscribed key.
+//
+// Unlike rpg::window::input, querying a key that is not subscribed returns
+// key_position::unknown rather than throwing. Keys outside the bitsets, such
+// as sf::Keyboard::Unknown, are never subscribed and so always unknown.
+template <class TInput> class bitset_input {
+  using word = key_bitset::word;
+
+  static constexpr auto word_bits = key_bitset::word_bits;
+  static constexpr auto word_count = key_bitset::word_count;
+
+  // Indexed by known << 2 | previous << 1 | current.
+  static constexpr std::array<key_position, 8> positions_{
+      key_position::unknown,  key_position::unknown, key_position::unknown,
+      key_position::unknown,  key_position::up,      key_position::pressed,
+      key_position::released, key_position::down,
+  };
+
+  std::reference_wrapper<TInput> input_;
+  key_bitset subscribed_{};
+  // Subscribed keys that have been sampled at least once.
+  key_bitset known_{};
+  key_bitset current_{};
+  key_bitset previous_{};
+  // Padded to whole words so the per frame add vectorises without a tail.
+  std::array<float, word_count * word_bits> seconds_in_current_position_{};
+
+  [[nodiscard]] static bool is_valid_(const auto key) {
+    return key >= 0 and static_cast<std::size_t>(key) < key_bitset::key_count;
+  }
+
+  [[nodiscard]] auto sample_() const {
+    auto &input = input_.get();
+    if constexpr (requires { input.snapshot(); }) {
+      key_bitset sampled = input.snapshot();
+      for (std::size_t i = 0; i < word_count; ++i) {
+        sampled.words[i] &= subscribed_.words[i];
+      }
+      return sampled;
+    } else {
+      key_bitset sampled{};
+      for (std::size_t i = 0; i < word_count; ++i) {
+        for (auto remaining = subscribed_.words[i]; remaining != 0;
+             remaining &= remaining - 1) {
+          const auto bit =
+              static_cast<std::size_t>(std::countr_zero(remaining));
+          const auto key = static_cast<sf::Keyboard::Key>(i * word_bits + bit);
+          sampled.words[i] |= static_cast<word>(input.is_key_pressed(key))
+                              << bit;
+        }
+      }
+      return sampled;
+    }
+  }
+
+public:
+  bitset_input(TInput &input, const auto... keys) : input_(input) {
+    subscribe(keys...);
+  };
+
+  inline void subscribe(const auto key) {
+    if (is_valid_(key)) {
+      subscribed_.set(static_cast<std::size_t>(key));
+    }
+  }
+
+  inline void unsubscribe(const auto key) {
+    if (not is_valid_(key)) {
+      return;
+    }
+    const auto index = static_cast<std::size_t>(key);
+    subscribed_.reset(index);
+    known_.reset(index);
+    current_.reset(index);
+    previous_.reset(index);
+  }
+
+  inline void subscribe(const auto... keys) { (subscribe(keys), ...); }
+
+  inline void update(const auto delta_time) {
+    const auto seconds_elapsed_in_last_frame = delta_time.asSeconds();
+    for (auto &seconds : seconds_in_current_position_) {
+      seconds += seconds_elapsed_in_last_frame;
+    }
+    const auto sampled = sample_();
+    for (std::size_t i = 0; i < word_count; ++i) {
+      // A key seen for the first time always counts as a transition, the same
+      // as leaving key_position::unknown does in rpg::window::input.
+      const auto fresh = subscribed_.words[i] & ~known_.words[i];
+      previous_.words[i] =
+          (current_.words[i] & ~fresh) | (~sampled.words[i] & fresh);
+      current_.words[i] = sampled.words[i];
+      known_.words[i] |= subscribed_.words[i];
+      for (auto changed = (previous_.words[i] ^ current_.words[i]) &
+                          subscribed_.words[i];
+           changed != 0; changed &= changed - 1) {
+        seconds_in_current_position_[i * word_bits +
+                                     std::countr_zero(changed)] = 0;
+      }
+    }
+  }
+
+  // Subscribed keys that are down, the same keys get_key_state reports as
+  // pressed or down.
+  [[nodiscard]] inline const key_bitset &down_keys() const noexcept {
+    return current_;
+  }
+
+  [[nodiscard]] inline key_state get_key_state(const auto key) const {
+    if (not is_valid_(key)) {
+      return {.position = key_position::unknown,
+              .seconds_in_current_position = 0};
+    }
+    const auto index = static_cast<std::size_t>(key);
+    return {
+        .position = positions_[known_.test(index) << 2 |
+                               previous_.test(index) << 1 |
+                               current_.test(index)],
+        .seconds_in_current_position = seconds_in_current_position_[index],
+    };
+  }
+};
+
+} // namespace rpg::window
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <rpg/window/key_bitset.hpp>
+
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Keyboard.hpp>
+
+#include <cstddef>
+
+namespace rpg::window {
+// Keyboard source fed from the window's event loop rather than by querying
+// sf::Keyboard for every key each frame, so the per frame cost only depends
+// on how many key events arrived.
+//
+// `snapshot()` closes the frame and reports, for every key, whether it should
+// be treated as pressed during that frame. A key that changes state more than
+// once between two snapshots still reports the first change this frame and
+// the state it ended up in on the next, so a tap shorter than a frame shows up
+// as pressed then released instead of being lost.
+class event_input {
+  // Physical state as of the last event.
+  key_bitset down_{};
+  // Keys that went down/up at least once since the last snapshot.
+  key_bitset went_down_{};
+  key_bitset went_up_{};
+  // What the last snapshot reported.
+  key_bitset reported_{};
+
+  [[nodiscard]] static bool is_valid_(const sf::Keyboard::Key key) {
+    return key >= 0 and static_cast<std::size_t>(key) < key_bitset::key_count;
+  }
+
+public:
+  void process(const sf::Event &event) {
+    switch (event.type) {
+    case sf::Event::KeyPressed:
+      if (is_valid_(event.key.code)) {
+        down_.set(static_cast<std::size_t>(event.key.code));
+        went_down_.set(static_cast<std::size_t>(event.key.code));
+      }
+      break;
+    case sf::Event::KeyReleased:
+      if (is_valid_(event.key.code)) {
+        down_.reset(static_cast<std::size_t>(event.key.code));
+        went_up_.set(static_cast<std::size_t>(event.key.code));
+      }
+      break;
+    case sf::Event::LostFocus:
+      // No release events arrive while unfocused, so let go of everything.
+      for (std::size_t i = 0; i < key_bitset::word_count; ++i) {
+        went_up_.words[i] |= down_.words[i];
+        down_.words[i] = 0;
+      }
+      break;
+    default:
+      break;
+    }
+  }
+
+  [[nodiscard]] key_bitset snapshot() {
+    for (std::size_t i = 0; i < key_bitset::word_count; ++i) {
+      // Keys reported down stay down unless they went up since; keys
+      // reported up come down if they went down at any point.
+      const auto previous = reported_.words[i];
+      reported_.words[i] =
+          (previous & ~went_up_.words[i] & down_.words[i]) |
+          (~previous & (went_down_.words[i] | down_.words[i]));
+      went_down_.words[i] = 0;
+      went_up_.words[i] = 0;
+    }
+    return reported_;
+  }
+
+  // What the last snapshot returned.
+  [[nodiscard]] const key_bitset &current() const noexcept { return reported_; }
+
+  [[nodiscard]] bool is_key_pressed(const sf::Keyboard::Key key) const {
+    return is_valid_(key) and down_.test(static_cast<std::size_t>(key)) != 0;
+  }
+};
+} // namespace rpg::window
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <rpg/window/input_recording.hpp>
+#include <rpg/window/key_bitset.hpp>
+
+#include <SFML/System/Time.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace rpg::window {
+// Streams the pressed keys and delta time of every frame to `output` in the
+// rpg::window::input_recording format. Frames are buffered and written in
+// blocks, and whatever is left is written when the recorder is destroyed.
+// A failed write throws std::runtime_error from record or flush, except when
+// destroying, so call flush before then to hear about it.
+class input_recorder {
+  static constexpr std::size_t flush_threshold = 4096;
+
+  std::reference_wrapper<std::ostream> output_;
+  std::vector<std::byte> buffer_{};
+  key_bitset pressed_{};
+
+public:
+  explicit input_recorder(std::ostream &output) : output_(output) {
+    buffer_.reserve(flush_threshold + 256);
+    buffer_.insert(std::end(buffer_), std::cbegin(input_recording::magic),
+                   std::cend(input_recording::magic));
+    buffer_.push_back(input_recording::version);
+    input_recording::write_varint(buffer_, key_bitset::key_count);
+  }
+
+  input_recorder(const input_recorder &) = delete;
+  input_recorder &operator=(const input_recorder &) = delete;
+
+  ~input_recorder() {
+    try {
+      flush();
+    } catch (const std::runtime_error &) {
+    }
+  }
+
+  void record(const sf::Time delta_time, const key_bitset &pressed) {
+    input_recording::write_varint(
+        buffer_, static_cast<std::uint64_t>(
+                     std::max<std::int64_t>(delta_time.asMicroseconds(), 0)));
+
+    std::size_t changed_count = 0;
+    for (std::size_t i = 0; i < key_bitset::word_count; ++i) {
+      changed_count += static_cast<std::size_t>(
+          std::popcount(pressed.words[i] ^ pressed_.words[i]));
+    }
+    input_recording::write_varint(buffer_, changed_count);
+
+    std::size_t next_key = 0;
+    for (std::size_t i = 0; i < key_bitset::word_count; ++i) {
+      for (auto changed = pressed.words[i] ^ pressed_.words[i]; changed != 0;
+           changed &= changed - 1) {
+        const auto key = i * key_bitset::word_bits +
+                         static_cast<std::size_t>(std::countr_zero(changed));
+        input_recording::write_varint(buffer_, key - next_key);
+        next_key = key + 1;
+      }
+    }
+    pressed_ = pressed;
+
+    if (std::size(buffer_) >= flush_threshold) {
+      flush();
+    }
+  }
+
+  // Writes the buffered frames, and flushes the stream so a full disk shows
+  // up now rather than when it is closed.
+  void flush() {
+    auto &output = output_.get();
+    output.write(reinterpret_cast<const char *>(std::data(buffer_)),
+                 static_cast<std::streamsize>(std::size(buffer_)));
+    output.flush();
+    buffer_.clear();
+    if (not output) {
+      throw std::runtime_error{"input recording could not be written"};
+    }
+  }
+};
+} // namespace rpg::window
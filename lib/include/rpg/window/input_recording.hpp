@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+namespace rpg::window::input_recording {
+// Binary layout shared by rpg::window::input_recorder and
+// rpg::window::input_replay. Every integer is an unsigned LEB128 varint.
+//
+//   header  "RPGI", version byte, key count
+//   frame   delta time in microseconds
+//           number of keys that changed state
+//           for each changed key, in ascending order, the gap to the previous
+//           changed key minus one (the first is the key itself)
+//
+// A 60 fps frame with no key changes takes three bytes.
+inline constexpr std::array<std::byte, 4> magic{std::byte{'R'}, std::byte{'P'},
+                                                std::byte{'G'}, std::byte{'I'}};
+inline constexpr std::byte version{1};
+
+template <class TOutput>
+void write_varint(TOutput &output, std::uint64_t value) {
+  while (value >= 0x80) {
+    output.push_back(static_cast<std::byte>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  output.push_back(static_cast<std::byte>(value));
+}
+
+// Reads one varint from the front of `input` and advances past it.
+[[nodiscard]] inline std::uint64_t
+read_varint(std::span<const std::byte> &input) {
+  std::uint64_t value = 0;
+  for (std::size_t shift = 0; shift < 64; shift += 7) {
+    if (input.empty()) {
+      throw std::runtime_error{"input recording is truncated"};
+    }
+    const auto byte = static_cast<std::uint64_t>(input.front());
+    input = input.subspan(1);
+    value |= (byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  throw std::runtime_error{"input recording has an oversized varint"};
+}
+} // namespace rpg::window::input_recording
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <rpg/window/bitset_input.hpp>
+#include <rpg/window/input_recording.hpp>
+#include <rpg/window/key_bitset.hpp>
+#include <rpg/window/key_state.hpp>
+
+#include <SFML/System/Time.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+namespace rpg::window {
+// Plays back a recording made by rpg::window::input_recorder. It has the same
+// interface as rpg::window::input, so it can drive rpg::controllers::movement
+// directly, and `next()` advances one recorded frame at a time regardless of
+// wall clock time.
+//
+// The replay reads straight out of `data`, which must outlive it.
+class input_replay {
+  struct source {
+    key_bitset pressed{};
+
+    [[nodiscard]] const key_bitset &snapshot() const { return pressed; }
+  };
+
+  std::span<const std::byte> remaining_;
+  source source_{};
+  bitset_input<source> input_{source_};
+  sf::Time delta_time_{};
+  std::size_t frame_{0};
+
+public:
+  explicit input_replay(const std::span<const std::byte> data)
+      : remaining_(data) {
+    if (std::size(remaining_) < std::size(input_recording::magic) + 1 or
+        not std::equal(std::cbegin(input_recording::magic),
+                       std::cend(input_recording::magic),
+                       std::cbegin(remaining_))) {
+      throw std::runtime_error{"not an input recording"};
+    }
+    remaining_ = remaining_.subspan(std::size(input_recording::magic));
+    if (remaining_.front() != input_recording::version) {
+      throw std::runtime_error{"unsupported input recording version"};
+    }
+    remaining_ = remaining_.subspan(1);
+    if (input_recording::read_varint(remaining_) != key_bitset::key_count) {
+      throw std::runtime_error{"input recording has a different key count"};
+    }
+  }
+
+  input_replay(const input_replay &) = delete;
+  input_replay &operator=(const input_replay &) = delete;
+
+  // Applies the next recorded frame. Returns false once the recording is
+  // exhausted, leaving the last frame's state in place.
+  [[nodiscard]] bool next() {
+    if (remaining_.empty()) {
+      return false;
+    }
+    delta_time_ = sf::microseconds(
+        static_cast<std::int64_t>(input_recording::read_varint(remaining_)));
+    auto changed_count = input_recording::read_varint(remaining_);
+    std::uint64_t key = 0;
+    while (changed_count-- > 0) {
+      key += input_recording::read_varint(remaining_);
+      if (key >= key_bitset::key_count) {
+        throw std::runtime_error{"input recording has an invalid key"};
+      }
+      source_.pressed.words[key_bitset::word_index(key)] ^=
+          key_bitset::bit(key);
+      ++key;
+    }
+    input_.update(delta_time_);
+    ++frame_;
+    return true;
+  }
+
+  [[nodiscard]] sf::Time delta_time() const noexcept { return delta_time_; }
+
+  [[nodiscard]] std::size_t frame() const noexcept { return frame_; }
+
+  // Keys held down in the current frame, so a replay can also be the key
+  // source of a bitset_input.
+  [[nodiscard]] const key_bitset &snapshot() const noexcept {
+    return source_.pressed;
+  }
+
+  inline void subscribe(const auto... keys) { input_.subscribe(keys...); }
+
+  inline void unsubscribe(const auto key) { input_.unsubscribe(key); }
+
+  [[nodiscard]] inline key_state get_key_state(const auto key) const {
+    return input_.get_key_state(key);
+  }
+};
+} // namespace rpg::window
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SFML/Window/Keyboard.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace rpg::window {
+// One bit per sf::Keyboard::Key, packed into 64 bit words.
+struct key_bitset {
+  using word = std::uint64_t;
+
+  static constexpr std::size_t key_count = sf::Keyboard::KeyCount;
+  static constexpr std::size_t word_bits = 64;
+  static constexpr std::size_t word_count =
+      (key_count + word_bits - 1) / word_bits;
+
+  std::array<word, word_count> words{};
+
+  [[nodiscard]] static constexpr auto word_index(const std::size_t key) {
+    return key / word_bits;
+  }
+
+  [[nodiscard]] static constexpr auto bit(const std::size_t key) {
+    return word{1} << (key % word_bits);
+  }
+
+  [[nodiscard]] constexpr auto test(const std::size_t key) const {
+    return static_cast<std::size_t>(
+        (words[word_index(key)] >> (key % word_bits)) & 1);
+  }
+
+  constexpr void set(const std::size_t key) {
+    words[word_index(key)] |= bit(key);
+  }
+
+  constexpr void reset(const std::size_t key) {
+    words[word_index(key)] &= ~bit(key);
+  }
+};
+} // namespace rpg::window
@@ -0,0 +1,15 @@
+#pragma once
+
+// Counts heap allocations in a test executable. Include from exactly one
+// translation unit.
+
+#include <rpg/allocation_hook.hpp>
+#include <rpg/allocations.hpp>
+
+#include <cstddef>
+
+namespace rpg::test::allocations {
+[[nodiscard]] inline std::size_t count() noexcept {
+  return static_cast<std::size_t>(rpg::allocations::total().allocations);
+}
+} // namespace rpg::test::allocations
@@ -0,0 +1,181 @@
+#include <rpg/action.hpp>
+#include <rpg/action_bindings.hpp>
+#include <rpg/window/key_bitset.hpp>
+#include <rpg/window/key_position.hpp>
+#include <rpg/window/key_state.hpp>
+
+#include <SFML/Window/Keyboard.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+namespace {
+[[nodiscard]] constexpr auto
+held(const std::initializer_list<sf::Keyboard::Key> keys) {
+  rpg::window::key_bitset down{};
+  for (const auto key : keys) {
+    down.set(static_cast<std::size_t>(key));
+  }
+  return down;
+}
+
+// Reports the keys in `down` as down, for the per key path.
+struct polled_input {
+  rpg::window::key_bitset down{};
+
+  [[nodiscard]] rpg::window::key_state
+  get_key_state(const sf::Keyboard::Key key) const {
+    return {.position = down.test(static_cast<std::size_t>(key)) != 0
+                            ? rpg::window::key_position::down
+                            : rpg::window::key_position::up,
+            .seconds_in_current_position = 0};
+  }
+};
+
+constexpr auto chorded = [] {
+  rpg::action_bindings bindings{};
+  bindings.bind(rpg::action::move_forward, sf::Keyboard::Key::W);
+  bindings.bind(rpg::action::move_forward, sf::Keyboard::Key::Up);
+  bindings.bind(rpg::action::rotate_left, sf::Keyboard::Key::LShift,
+                sf::Keyboard::Key::A);
+  bindings.bind(rpg::action::move_left, sf::Keyboard::Key::A);
+  return bindings;
+}();
+} // namespace
+
+TEST(action_bindings, any_bound_key_triggers_the_action) {
+  const auto forward = rpg::action_bit(rpg::action::move_forward);
+  EXPECT_EQ(chorded.actions(held({sf::Keyboard::Key::W})), forward);
+  EXPECT_EQ(chorded.actions(held({sf::Keyboard::Key::Up})), forward);
+  EXPECT_EQ(chorded.actions(held({sf::Keyboard::Key::S})), 0);
+}
+
+TEST(action_bindings, chords_need_every_key) {
+  const auto rotate_left = rpg::action_bit(rpg::action::rotate_left);
+  const auto move_left = rpg::action_bit(rpg::action::move_left);
+  EXPECT_EQ(chorded.actions(held({sf::Keyboard::Key::LShift})), 0);
+  EXPECT_EQ(chorded.actions(held({sf::Keyboard::Key::A})), move_left);
+  EXPECT_EQ(chorded.actions(
+                held({sf::Keyboard::Key::LShift, sf::Keyboard::Key::A})),
+            rotate_left | move_left);
+}
+
+TEST(action_bindings, inputs_without_a_bitset_are_polled_per_key) {
+  const polled_input input{
+      .down = held({sf::Keyboard::Key::LShift, sf::Keyboard::Key::A,
+                    sf::Keyboard::Key::Up})};
+  EXPECT_EQ(chorded.actions(input), chorded.actions(input.down));
+  EXPECT_TRUE(chorded.is_active(rpg::action::rotate_left, input));
+  EXPECT_FALSE(chorded.is_active(rpg::action::move_backward, input));
+}
+
+TEST(action_bindings, fixed_actions_match_runtime_lookup) {
+  static constexpr auto bindings = chorded;
+  // Every combination of the keys the bindings use, plus one they do not.
+  constexpr std::array keys{sf::Keyboard::Key::W, sf::Keyboard::Key::Up,
+                            sf::Keyboard::Key::LShift, sf::Keyboard::Key::A,
+                            sf::Keyboard::Key::F15};
+  for (unsigned combination = 0; combination < (1u << std::size(keys));
+       ++combination) {
+    rpg::window::key_bitset down{};
+    for (std::size_t i = 0; i < std::size(keys); ++i) {
+      if ((combination >> i) & 1u) {
+        down.set(static_cast<std::size_t>(keys[i]));
+      }
+    }
+    EXPECT_EQ(rpg::fixed_actions<bindings>(down), bindings.actions(down));
+  }
+  static_assert(rpg::fixed_actions<rpg::default_action_bindings>(
+                    held({sf::Keyboard::Key::W, sf::Keyboard::Key::Q})) ==
+                (rpg::action_bit(rpg::action::move_forward) |
+                 rpg::action_bit(rpg::action::rotate_left)));
+}
+
+TEST(action_bindings, keys_lists_every_bound_key) {
+  auto count = 0;
+  chorded.each_key([&](const sf::Keyboard::Key) { ++count; });
+  EXPECT_EQ(count, 4);
+  EXPECT_EQ(chorded.keys().words,
+            held({sf::Keyboard::Key::W, sf::Keyboard::Key::Up,
+                  sf::Keyboard::Key::LShift, sf::Keyboard::Key::A})
+                .words);
+}
+
+TEST(action_bindings, rejects_too_many_chords_and_unbindable_keys) {
+  rpg::action_bindings bindings{};
+  for (std::size_t i = 0; i < rpg::action_bindings::max_chords; ++i) {
+    bindings.bind(rpg::action::move_forward,
+                  static_cast<sf::Keyboard::Key>(i));
+  }
+  EXPECT_THROW(bindings.bind(rpg::action::move_forward, sf::Keyboard::Key::Z),
+               std::invalid_argument);
+  EXPECT_THROW(
+      bindings.bind(rpg::action::move_backward, sf::Keyboard::Key::Unknown),
+      std::invalid_argument);
+  bindings.clear(rpg::action::move_forward);
+  EXPECT_TRUE(std::empty(bindings.chords(rpg::action::move_forward)));
+}
+
+TEST(action_bindings, parses_bindings_text) {
+  const auto bindings = rpg::parse_action_bindings(R"(
+    # Arrow keys as well as WASD
+    move_forward = W
+    move_forward = Up   # trailing comment
+    rotate_left=LShift+A
+  )");
+  EXPECT_EQ(bindings.actions(held({sf::Keyboard::Key::Up})),
+            rpg::action_bit(rpg::action::move_forward));
+  EXPECT_EQ(
+      bindings.actions(held({sf::Keyboard::Key::LShift, sf::Keyboard::Key::A})),
+      rpg::action_bit(rpg::action::rotate_left));
+  EXPECT_EQ(std::size(bindings.chords(rpg::action::move_forward)), 2);
+}
+
+TEST(action_bindings, parse_errors_name_the_line) {
+  const auto message = [](const char *const text) -> std::string {
+    try {
+      std::ignore = rpg::parse_action_bindings(text);
+    } catch (const std::runtime_error &error) {
+      return error.what();
+    }
+    return "";
+  };
+  EXPECT_EQ(message("move_forward = W\njump = Space"),
+            "action bindings line 2: unknown action `jump`");
+  EXPECT_EQ(message("move_forward = W + Nope"),
+            "action bindings line 1: unknown key `Nope`");
+  EXPECT_EQ(message("\n\nmove_forward W"),
+            "action bindings line 3: expected `action = keys`");
+  EXPECT_EQ(message("move_forward = +"),
+            "action bindings line 1: unknown key ``");
+}
+
+TEST(action_bindings, loads_bindings_file) {
+  const auto path =
+      std::filesystem::temp_directory_path() / "rpg_action_bindings.txt";
+  {
+    std::ofstream file{path};
+    file << "move_backward = S\nmove_backward = Down\n";
+  }
+  const auto bindings = rpg::load_action_bindings(path);
+  std::filesystem::remove(path);
+  EXPECT_EQ(bindings.actions(held({sf::Keyboard::Key::Down})),
+            rpg::action_bit(rpg::action::move_backward));
+  EXPECT_THROW(std::ignore = rpg::load_action_bindings(path),
+               std::runtime_error);
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
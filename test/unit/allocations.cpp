@@ -0,0 +1,242 @@
+#include <rpg/action.hpp>
+#include <rpg/allocations.hpp>
+#include <rpg/controllers/batch_movement.hpp>
+#include <rpg/controllers/movement.hpp>
+#include <rpg/window/bitset_input.hpp>
+#include <rpg/window/input.hpp>
+
+#include <rpg/test/allocations.hpp>
+
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/Window/Keyboard.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct speed {
+  [[nodiscard]] float frontal_movement() const noexcept { return 500.0f; }
+  [[nodiscard]] float backward_movement() const noexcept { return 250.0f; }
+  [[nodiscard]] float lateral_movement() const noexcept { return 150.0f; }
+  [[nodiscard]] float rotational_movement() const noexcept { return 250.0f; }
+};
+
+// Keys held down by the test, without the allocations a gmock expectation
+// makes on every call.
+struct held_keys {
+  std::bitset<sf::Keyboard::KeyCount> down{};
+
+  [[nodiscard]] bool is_key_pressed(const sf::Keyboard::Key key) const {
+    return down.test(static_cast<std::size_t>(key));
+  }
+};
+
+constexpr std::array keys{sf::Keyboard::Key::W, sf::Keyboard::Key::A,
+                          sf::Keyboard::Key::S, sf::Keyboard::Key::D,
+                          sf::Keyboard::Key::Q, sf::Keyboard::Key::E};
+
+// Steady state is whatever follows a few frames of every key going down and
+// up again, once containers have grown to their working size.
+constexpr auto warm_up_frames = 8;
+constexpr auto measured_frames = 1000;
+
+// Presses a different combination of keys every few frames.
+void press_keys(held_keys &keyboard, const int frame) {
+  keyboard.down.reset();
+  const auto pattern = static_cast<unsigned>(frame / 4);
+  for (std::size_t i = 0; i < std::size(keys); ++i) {
+    if ((pattern >> i) & 1u) {
+      keyboard.down.set(static_cast<std::size_t>(keys[i]));
+    }
+  }
+}
+
+void map_actions(auto &movement_controller) {
+  movement_controller.map_action(rpg::action::move_forward,
+                                 sf::Keyboard::Key::W);
+  movement_controller.map_action(rpg::action::move_backward,
+                                 sf::Keyboard::Key::S);
+  movement_controller.map_action(rpg::action::move_left, sf::Keyboard::Key::A);
+  movement_controller.map_action(rpg::action::move_right, sf::Keyboard::Key::D);
+  movement_controller.map_action(rpg::action::rotate_left,
+                                 sf::Keyboard::Key::Q);
+  movement_controller.map_action(rpg::action::rotate_right,
+                                 sf::Keyboard::Key::E);
+}
+
+// Runs `frame(index)` for the warm up frames and then returns what the
+// measured frames allocated.
+auto steady_state_allocations(auto &&frame) {
+  auto index = 0;
+  for (; index < warm_up_frames; ++index) {
+    frame(index);
+  }
+  const auto before = rpg::allocations::this_thread();
+  for (; index < warm_up_frames + measured_frames; ++index) {
+    frame(index);
+  }
+  return rpg::allocations::this_thread() - before;
+}
+} // namespace
+
+TEST(allocations, counts_allocations_and_bytes) {
+  const auto before = rpg::allocations::this_thread();
+  const auto total_before = rpg::allocations::total();
+  // Calling operator new directly, since new expressions may be elided.
+  ::operator delete(::operator new(100));
+  ::operator delete(::operator new(28));
+  const auto counted = rpg::allocations::this_thread() - before;
+  EXPECT_EQ(counted, (rpg::allocation_counts{.allocations = 2, .bytes = 128}));
+  EXPECT_GE((rpg::allocations::total() - total_before).allocations, 2);
+}
+
+TEST(allocations, zero_byte_allocations_succeed) {
+  const auto before = rpg::allocations::this_thread();
+  auto *const plain = ::operator new(0);
+  auto *const aligned = ::operator new(0, std::align_val_t{64});
+  EXPECT_NE(plain, nullptr);
+  EXPECT_NE(aligned, nullptr);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 64, 0);
+  ::operator delete(aligned, std::align_val_t{64});
+  ::operator delete(plain);
+  EXPECT_EQ((rpg::allocations::this_thread() - before).allocations, 2);
+}
+
+TEST(allocations, threads_count_their_own_allocations) {
+  const auto before = rpg::allocations::this_thread();
+  const auto total_before = rpg::allocations::total();
+  std::thread allocating{[] {
+    const auto before = rpg::allocations::this_thread();
+    const std::vector<int> numbers(16);
+    EXPECT_EQ((rpg::allocations::this_thread() - before).allocations, 1);
+  }};
+  allocating.join();
+  // Starting the thread allocates on this one.
+  const auto own = rpg::allocations::this_thread() - before;
+  EXPECT_GE((rpg::allocations::total() - total_before).allocations,
+            own.allocations + 1);
+}
+
+TEST(allocations, scopes_add_up_by_name) {
+  static constexpr auto name = "scopes_add_up_by_name";
+  for (auto i = 0; i < 3; ++i) {
+    const rpg::allocations::scope scope{name};
+    const std::vector<std::uint64_t> numbers(8);
+  }
+  {
+    const rpg::allocations::scope scope{name};
+  }
+
+  auto found = false;
+  rpg::allocations::scope_table::instance().each(
+      [&](const rpg::allocations::scope_totals &totals) {
+        if (std::string_view{totals.name} == name) {
+          found = true;
+          EXPECT_EQ(totals.calls, 4);
+          EXPECT_EQ(totals.counts,
+                    (rpg::allocation_counts{.allocations = 3, .bytes = 192}));
+        }
+      });
+  EXPECT_TRUE(found);
+}
+
+TEST(allocations, frame_counter_tracks_last_and_peak_frames) {
+  rpg::allocations::frame_counter frames{};
+  ::operator delete(::operator new(8));
+  frames.mark();
+  EXPECT_GE(frames.last().allocations, 1);
+  for (auto i = 0; i < 3; ++i) {
+    ::operator delete(::operator new(8));
+  }
+  frames.mark();
+  EXPECT_GE(frames.last().allocations, 3);
+  frames.mark();
+  EXPECT_GE(frames.peak().allocations, 3);
+  EXPECT_EQ(frames.frames(), 3);
+  EXPECT_GE(frames.overall().allocations, 4);
+}
+
+TEST(allocations, steady_state_input_update_does_not_allocate) {
+  held_keys keyboard{};
+  rpg::window::input<held_keys> input{keyboard};
+  for (const auto key : keys) {
+    input.subscribe(key);
+  }
+  const auto frame = sf::milliseconds(16);
+  EXPECT_EQ(steady_state_allocations([&](const int index) {
+              press_keys(keyboard, index);
+              input.update(frame);
+            }),
+            rpg::allocation_counts{});
+}
+
+TEST(allocations, steady_state_bitset_input_update_does_not_allocate) {
+  held_keys keyboard{};
+  rpg::window::bitset_input<held_keys> input{keyboard};
+  for (const auto key : keys) {
+    input.subscribe(key);
+  }
+  const auto frame = sf::milliseconds(16);
+  EXPECT_EQ(steady_state_allocations([&](const int index) {
+              press_keys(keyboard, index);
+              input.update(frame);
+            }),
+            rpg::allocation_counts{});
+}
+
+TEST(allocations, steady_state_movement_update_does_not_allocate) {
+  using input_type = rpg::window::input<held_keys>;
+  held_keys keyboard{};
+  input_type input{keyboard};
+  const speed movement_speed{};
+  rpg::controllers::movement<input_type, speed> movement_controller{
+      input, movement_speed};
+  map_actions(movement_controller);
+  sf::Transformable transformable{};
+  movement_controller.attach(transformable);
+
+  const auto frame = sf::milliseconds(16);
+  EXPECT_EQ(steady_state_allocations([&](const int index) {
+              press_keys(keyboard, index);
+              input.update(frame);
+              movement_controller.update(frame);
+            }),
+            rpg::allocation_counts{});
+}
+
+TEST(allocations, steady_state_batch_movement_update_does_not_allocate) {
+  rpg::controllers::batch_movement movement{};
+  const sf::Transformable transformable{};
+  for (auto i = 0; i < 64; ++i) {
+    std::ignore = movement.add(transformable, speed{});
+  }
+
+  const auto frame = sf::milliseconds(16);
+  EXPECT_EQ(steady_state_allocations([&](const int index) {
+              for (std::size_t i = 0; i < movement.size(); ++i) {
+                movement.set_actions(
+                    i, rpg::controllers::action_bit(
+                           (index + i) % 2 == 0 ? rpg::action::move_forward
+                                                : rpg::action::rotate_left));
+              }
+              movement.update(frame);
+            }),
+            rpg::allocation_counts{});
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,165 @@
+#include <rpg/asset_archive.hpp>
+#include <rpg/mapped_file.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <vector>
+
+namespace {
+[[nodiscard]] auto as_bytes(const std::string_view text) {
+  return std::as_bytes(std::span{std::data(text), std::size(text)});
+}
+
+[[nodiscard]] auto as_string(const std::span<const std::byte> bytes) {
+  return std::string{reinterpret_cast<const char *>(std::data(bytes)),
+                     std::size(bytes)};
+}
+
+const std::vector<rpg::asset_archive_entry> entries{
+    {.name = "grass.png", .bytes = as_bytes("grass")},
+    {.name = "stone.png", .bytes = as_bytes("a little more stone")},
+    {.name = "empty.png", .bytes = {}},
+    {.name = "water.png", .bytes = as_bytes("water water water water")},
+};
+} // namespace
+
+TEST(asset_archive, finds_every_packed_asset) {
+  const auto bytes = rpg::pack_asset_archive(entries);
+  const rpg::asset_archive_view archive{bytes};
+  ASSERT_EQ(archive.size(), std::size(entries));
+  for (const auto &entry : entries) {
+    const auto found = archive.find(entry.name);
+    ASSERT_TRUE(found) << entry.name;
+    EXPECT_EQ(as_string(*found), as_string(entry.bytes)) << entry.name;
+  }
+  EXPECT_FALSE(archive.find("missing.png"));
+}
+
+TEST(asset_archive, assets_are_aligned_views_into_the_archive) {
+  const auto bytes = rpg::pack_asset_archive(entries);
+  const rpg::asset_archive_view archive{bytes};
+  for (const auto &entry : entries) {
+    const auto found = archive.find(entry.name);
+    ASSERT_TRUE(found);
+    const auto offset = std::data(*found) - std::data(bytes);
+    EXPECT_EQ(offset % rpg::asset_archive_format::alignment, 0);
+    EXPECT_GE(offset, 0);
+    EXPECT_LE(offset + std::ssize(*found), std::ssize(bytes));
+  }
+}
+
+TEST(asset_archive, table_of_contents_is_sorted_by_hash) {
+  namespace format = rpg::asset_archive_format;
+  const auto bytes = rpg::pack_asset_archive(entries);
+  std::vector<std::uint64_t> hashes{};
+  for (std::size_t i = 0; i < std::size(entries); ++i) {
+    hashes.push_back(format::read<std::uint64_t>(
+        bytes, format::header_size + i * format::toc_entry_size));
+  }
+  EXPECT_TRUE(std::ranges::is_sorted(hashes));
+}
+
+TEST(asset_archive, hash_is_fnv1a) {
+  static_assert(rpg::asset_archive_format::hash("") == 0xcbf29ce484222325);
+  static_assert(rpg::asset_archive_format::hash("a") == 0xaf63dc4c8601ec8c);
+  static_assert(rpg::asset_archive_format::hash("foobar") ==
+                0x85944171f73967e8);
+}
+
+TEST(asset_archive, empty_archive_finds_nothing) {
+  const auto bytes = rpg::pack_asset_archive({});
+  const rpg::asset_archive_view archive{bytes};
+  EXPECT_EQ(archive.size(), 0);
+  EXPECT_FALSE(archive.find("grass.png"));
+}
+
+TEST(asset_archive, refuses_duplicate_names) {
+  const std::vector<rpg::asset_archive_entry> duplicates{
+      {.name = "grass.png", .bytes = as_bytes("grass")},
+      {.name = "grass.png", .bytes = as_bytes("more grass")},
+  };
+  EXPECT_THROW(std::ignore = rpg::pack_asset_archive(duplicates),
+               std::invalid_argument);
+}
+
+TEST(asset_archive, rejects_malformed_archives) {
+  namespace format = rpg::asset_archive_format;
+  const auto valid = rpg::pack_asset_archive(entries);
+  const auto rejects = [](std::vector<std::byte> bytes) {
+    EXPECT_THROW(rpg::asset_archive_view{bytes}, std::runtime_error);
+  };
+
+  rejects({});
+  auto bad_magic = valid;
+  bad_magic[0] = std::byte{'X'};
+  rejects(bad_magic);
+
+  auto bad_version = valid;
+  format::write(bad_version, 4, format::version + 1);
+  rejects(bad_version);
+
+  rejects({std::begin(valid), std::next(std::begin(valid), 40)});
+
+  auto misaligned = valid;
+  format::write(misaligned, format::header_size + 8, std::uint64_t{1});
+  rejects(misaligned);
+
+  auto out_of_bounds = valid;
+  format::write(out_of_bounds, format::header_size + 16,
+                std::uint64_t{std::size(valid)});
+  rejects(out_of_bounds);
+
+  auto unsorted = valid;
+  format::write(unsorted, format::header_size, ~std::uint64_t{0});
+  rejects(unsorted);
+}
+
+TEST(asset_archive, maps_archives_from_disk) {
+  const auto path =
+      std::filesystem::temp_directory_path() /
+      ("rpg_asset_archive_test_" +
+       std::to_string(
+           std::chrono::steady_clock::now().time_since_epoch().count()) +
+       ".rpga");
+  {
+    const auto bytes = rpg::pack_asset_archive(entries);
+    std::ofstream file{path, std::ios::binary};
+    file.write(reinterpret_cast<const char *>(std::data(bytes)),
+               static_cast<std::streamsize>(std::size(bytes)));
+  }
+  {
+    const rpg::asset_archive archive{path};
+    const auto found = archive.find("water.png");
+    ASSERT_TRUE(found);
+    EXPECT_EQ(as_string(*found), "water water water water");
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(std::data(*found)) %
+                  rpg::asset_archive_format::alignment,
+              0);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(asset_archive, mapping_a_missing_file_throws) {
+  EXPECT_THROW(rpg::mapped_file{"/nonexistent/rpg/archive.rpga"},
+               std::system_error);
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,105 @@
+#include <rpg/atlas.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace {
+[[nodiscard]] bool overlap(const rpg::atlas_region &lhs,
+                           const rpg::atlas_region &rhs, const int padding) {
+  return lhs.page == rhs.page and lhs.left < rhs.left + rhs.width + padding and
+         rhs.left < lhs.left + lhs.width + padding and
+         lhs.top < rhs.top + rhs.height + padding and
+         rhs.top < lhs.top + lhs.height + padding;
+}
+
+void expect_valid_packing(const std::vector<rpg::atlas_size> &sizes,
+                          const std::vector<rpg::atlas_region> &regions,
+                          const int page_size, const int padding) {
+  ASSERT_EQ(std::size(sizes), std::size(regions));
+  for (std::size_t i = 0; i < std::size(regions); ++i) {
+    const auto &region = regions[i];
+    EXPECT_EQ(sizes[i].width, region.width);
+    EXPECT_EQ(sizes[i].height, region.height);
+    EXPECT_GE(region.left, 0);
+    EXPECT_GE(region.top, 0);
+    EXPECT_LE(region.left + region.width + padding, page_size);
+    EXPECT_LE(region.top + region.height + padding, page_size);
+    for (std::size_t j = i + 1; j < std::size(regions); ++j) {
+      ASSERT_FALSE(overlap(region, regions[j], padding)) << i << " " << j;
+    }
+  }
+}
+} // namespace
+
+TEST(atlas, skyline_packer_places_bottom_left) {
+  rpg::skyline_packer packer{64};
+  EXPECT_EQ(sf::Vector2i(0, 0), packer.insert(32, 16));
+  EXPECT_EQ(sf::Vector2i(32, 0), packer.insert(32, 8));
+  // Lowest top edge wins, which is on top of the shorter one.
+  EXPECT_EQ(sf::Vector2i(32, 8), packer.insert(16, 8));
+  EXPECT_EQ(sf::Vector2i(0, 16), packer.insert(64, 48));
+}
+
+TEST(atlas, skyline_packer_reports_full_page) {
+  rpg::skyline_packer packer{32};
+  EXPECT_TRUE(packer.insert(32, 32).has_value());
+  EXPECT_FALSE(packer.insert(1, 1).has_value());
+}
+
+TEST(atlas, packs_random_sizes_without_overlap) {
+  constexpr auto page_size = 512;
+  constexpr auto padding = 1;
+  std::mt19937 random{42};
+  std::uniform_int_distribution<int> lengths{4, 96};
+  std::vector<rpg::atlas_size> sizes(200);
+  for (auto &size : sizes) {
+    size = {.width = lengths(random), .height = lengths(random)};
+  }
+  const auto regions = rpg::pack_atlas(sizes, page_size, padding);
+  expect_valid_packing(sizes, regions, page_size, padding);
+
+  // Skyline packing of sorted sizes should waste well under half of the
+  // pages it opens.
+  auto area = 0;
+  for (const auto &size : sizes) {
+    area += (size.width + padding) * (size.height + padding);
+  }
+  const auto pages = std::ranges::max(regions, {}, &rpg::atlas_region::page)
+                         .page +
+                     1;
+  EXPECT_LT(pages * page_size * page_size, area * 2);
+}
+
+TEST(atlas, opens_new_pages_when_full) {
+  const std::vector<rpg::atlas_size> sizes(5, {.width = 63, .height = 63});
+  const auto regions = rpg::pack_atlas(sizes, 128, 1);
+  expect_valid_packing(sizes, regions, 128, 1);
+  EXPECT_EQ(0, regions[3].page);
+  EXPECT_EQ(1, regions[4].page);
+}
+
+TEST(atlas, rejects_textures_larger_than_a_page) {
+  const std::vector<rpg::atlas_size> sizes{{.width = 128, .height = 16}};
+  EXPECT_THROW(std::ignore = rpg::pack_atlas(sizes, 128, 1),
+               std::invalid_argument);
+}
+
+TEST(atlas, region_converts_to_rect) {
+  const rpg::atlas_region region{
+      .page = 1, .left = 2, .top = 3, .width = 4, .height = 5};
+  EXPECT_EQ(sf::IntRect(2, 3, 4, 5), region.rect());
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
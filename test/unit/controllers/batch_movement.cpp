@@ -0,0 +1,153 @@
+#include <rpg/action.hpp>
+#include <rpg/controllers/batch_movement.hpp>
+#include <rpg/controllers/movement.hpp>
+#include <rpg/window/key_position.hpp>
+#include <rpg/window/key_state.hpp>
+
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/Window/Keyboard.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr std::array actions{
+    rpg::action::move_forward, rpg::action::move_backward,
+    rpg::action::move_right,   rpg::action::move_left,
+    rpg::action::rotate_right, rpg::action::rotate_left,
+};
+
+constexpr std::array keys{
+    sf::Keyboard::Key::W, sf::Keyboard::Key::S, sf::Keyboard::Key::D,
+    sf::Keyboard::Key::A, sf::Keyboard::Key::E, sf::Keyboard::Key::Q,
+};
+
+// Reports the keys for the actions in `actions` as down.
+struct action_input {
+  rpg::controllers::action_set actions{};
+
+  [[nodiscard]] rpg::window::key_state
+  get_key_state(const sf::Keyboard::Key key) const {
+    for (std::size_t i = 0; i < std::size(keys); ++i) {
+      if (keys[i] == key and
+          (actions & rpg::controllers::action_bit(::actions[i])) != 0) {
+        return {.position = rpg::window::key_position::down,
+                .seconds_in_current_position = 0};
+      }
+    }
+    return {.position = rpg::window::key_position::up,
+            .seconds_in_current_position = 0};
+  }
+
+  void subscribe(const sf::Keyboard::Key) {}
+  void unsubscribe(const sf::Keyboard::Key) {}
+};
+
+struct speed {
+  float frontal;
+  float backward;
+  float lateral;
+  float rotational;
+
+  [[nodiscard]] float frontal_movement() const noexcept { return frontal; }
+  [[nodiscard]] float backward_movement() const noexcept { return backward; }
+  [[nodiscard]] float lateral_movement() const noexcept { return lateral; }
+  [[nodiscard]] float rotational_movement() const noexcept {
+    return rotational;
+  }
+};
+
+// One movement controller per entity, used as the reference implementation.
+struct oracle {
+  action_input input{};
+  speed speeds;
+  sf::Transformable transformable{};
+  rpg::controllers::movement<action_input, speed> controller{input, speeds};
+
+  explicit oracle(const speed &values) : speeds(values) {
+    for (std::size_t i = 0; i < std::size(actions); ++i) {
+      controller.map_action(actions[i], keys[i]);
+    }
+  }
+};
+} // namespace
+
+TEST(controllers_batch_movement, new_entities_face_right) {
+  rpg::controllers::batch_movement movement{};
+  sf::Transformable transformable{};
+  transformable.setPosition(3.0f, 4.0f);
+  const auto index = movement.add(transformable, speed{1, 1, 1, 1});
+  EXPECT_EQ(0, index);
+  EXPECT_EQ(1, movement.size());
+  EXPECT_EQ(sf::Vector2f(3.0f, 4.0f), movement.position(index));
+  EXPECT_EQ(sf::Vector2f(1.0f, 0.0f), movement.direction(index));
+}
+
+TEST(controllers_batch_movement, swap_remove_moves_last_entity_into_place) {
+  rpg::controllers::batch_movement movement{};
+  sf::Transformable first{};
+  sf::Transformable last{};
+  last.setPosition(5.0f, 6.0f);
+  std::ignore = movement.add(first, speed{1, 1, 1, 1});
+  std::ignore = movement.add(last, speed{1, 1, 1, 1});
+  movement.swap_remove(0);
+  EXPECT_EQ(1, movement.size());
+  EXPECT_EQ(sf::Vector2f(5.0f, 6.0f), movement.position(0));
+}
+
+TEST(controllers_batch_movement, matches_movement_controller) {
+  constexpr auto entity_count = 256;
+  constexpr auto frame_count = 500;
+
+  std::mt19937 random{42};
+  std::uniform_real_distribution<float> speeds{1.0f, 500.0f};
+  std::uniform_real_distribution<float> positions{-1000.0f, 1000.0f};
+  std::uniform_int_distribution<int> action_sets{0, (1 << 6) - 1};
+  std::uniform_int_distribution<int> milliseconds{1, 50};
+
+  rpg::controllers::batch_movement movement{};
+  std::vector<std::unique_ptr<oracle>> oracles{};
+  for (auto i = 0; i < entity_count; ++i) {
+    auto &entity = *oracles.emplace_back(std::make_unique<oracle>(
+        speed{speeds(random), speeds(random), speeds(random), speeds(random)}));
+    entity.transformable.setPosition(positions(random), positions(random));
+    entity.controller.attach(entity.transformable);
+    std::ignore = movement.add(entity.transformable, entity.speeds);
+  }
+
+  std::vector<sf::Transformable> transformables(entity_count);
+  for (auto frame = 0; frame < frame_count; ++frame) {
+    const auto delta_time = sf::milliseconds(milliseconds(random));
+    for (std::size_t i = 0; i < entity_count; ++i) {
+      const auto actions =
+          static_cast<rpg::controllers::action_set>(action_sets(random));
+      oracles[i]->input.actions = actions;
+      oracles[i]->controller.update(delta_time);
+      movement.set_actions(i, actions);
+    }
+    movement.update(delta_time);
+    movement.store(transformables);
+
+    for (std::size_t i = 0; i < entity_count; ++i) {
+      const auto &expected = oracles[i]->transformable;
+      ASSERT_EQ(expected.getPosition(), transformables[i].getPosition())
+          << "entity " << i << " frame " << frame;
+      ASSERT_EQ(expected.getRotation(), movement.rotation(i))
+          << "entity " << i << " frame " << frame;
+    }
+  }
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -1,5 +1,6 @@
 #include <rpg/action.hpp>
 #include <rpg/controllers/movement.hpp>
+#include <rpg/slot_map.hpp>
 #include <rpg/window/key_position.hpp>
 #include <rpg/window/key_state.hpp>
 
@@ -7,6 +8,7 @@
 #include <rpg/test/mocks/speed.hpp>
 #include <rpg/test/mocks/window_input.hpp>
 
+#include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/Transformable.hpp>
 #include <SFML/System/Time.hpp>
 #include <SFML/Window/Keyboard.hpp>
@@ -14,6 +16,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <tuple>
+
 template <template <class> class TMock>
 class controllers_movement_impl : public testing::Test {
 protected:
@@ -338,6 +342,22 @@ TEST_F(strick_controllers_movement, lateral_movement_considers_orientation) {
   EXPECT_EQ(-2.0f, transformable.getPosition().y);
 }
 
+TEST_F(strick_controllers_movement, remapping_releases_the_old_key) {
+  EXPECT_CALL(test_input, subscribe(sf::Keyboard::Key::W)).Times(1);
+  movement_controller.map_action(rpg::action::move_forward,
+                                 sf::Keyboard::Key::W);
+
+  EXPECT_CALL(test_input, subscribe(sf::Keyboard::Key::Up)).Times(1);
+  EXPECT_CALL(test_input, unsubscribe(sf::Keyboard::Key::W)).Times(1);
+  movement_controller.map_action(rpg::action::move_forward,
+                                 sf::Keyboard::Key::Up);
+
+  // Unknown is never subscribed; it only releases Up.
+  EXPECT_CALL(test_input, unsubscribe(sf::Keyboard::Key::Up)).Times(1);
+  movement_controller.map_action(rpg::action::move_forward,
+                                 sf::Keyboard::Key::Unknown);
+}
+
 TEST_F(nice_controllers_movement, cannot_move_laterally_if_rotating) {
   constexpr rpg::window::key_state key_down{
       .position = rpg::window::key_position::down,
@@ -387,6 +407,107 @@ TEST_F(nice_controllers_movement, cannot_move_laterally_if_rotating) {
   EXPECT_EQ(0.0f, transformable.getPosition().y);
 }
 
+TEST_F(nice_controllers_movement, reports_whether_update_moved) {
+  constexpr rpg::window::key_state key_down{
+      .position = rpg::window::key_position::down,
+      .seconds_in_current_position = 0,
+  };
+  constexpr rpg::window::key_state key_up{
+      .position = rpg::window::key_position::up,
+      .seconds_in_current_position = 0,
+  };
+
+  EXPECT_CALL(test_input, get_key_state(sf::Keyboard::Key::W))
+      .Times(2)
+      .WillOnce(::testing::Return(key_down))
+      .WillOnce(::testing::Return(key_up));
+  EXPECT_CALL(test_speed, frontal_movement())
+      .WillRepeatedly(::testing::Return(1.0f));
+  movement_controller.map_action(rpg::action::move_forward,
+                                 sf::Keyboard::Key::W);
+  EXPECT_FALSE(movement_controller.moved());
+  movement_controller.attach(transformable);
+  movement_controller.update(sf::seconds(1.0f));
+  EXPECT_TRUE(movement_controller.moved());
+  movement_controller.update(sf::seconds(1.0f));
+  EXPECT_FALSE(movement_controller.moved());
+}
+
+TEST_F(nice_controllers_movement, chorded_binding_needs_every_key) {
+  constexpr rpg::window::key_state key_down{
+      .position = rpg::window::key_position::down,
+      .seconds_in_current_position = 0,
+  };
+  constexpr rpg::window::key_state key_up{
+      .position = rpg::window::key_position::up,
+      .seconds_in_current_position = 0,
+  };
+
+  EXPECT_CALL(test_input, subscribe(sf::Keyboard::Key::LShift)).Times(1);
+  EXPECT_CALL(test_input, subscribe(sf::Keyboard::Key::W)).Times(1);
+  EXPECT_CALL(test_input, get_key_state(sf::Keyboard::Key::LShift))
+      .WillOnce(::testing::Return(key_up))
+      .WillRepeatedly(::testing::Return(key_down));
+  EXPECT_CALL(test_input, get_key_state(sf::Keyboard::Key::W))
+      .WillRepeatedly(::testing::Return(key_down));
+  EXPECT_CALL(test_speed, frontal_movement())
+      .WillRepeatedly(::testing::Return(1.0f));
+  movement_controller.bind_action(rpg::action::move_forward,
+                                  sf::Keyboard::Key::LShift,
+                                  sf::Keyboard::Key::W);
+  movement_controller.attach(transformable);
+  movement_controller.update(sf::seconds(1.0f));
+  EXPECT_FALSE(movement_controller.moved());
+  movement_controller.update(sf::seconds(1.0f));
+  EXPECT_TRUE(movement_controller.moved());
+
+  EXPECT_CALL(test_input, unsubscribe(sf::Keyboard::Key::LShift)).Times(1);
+  EXPECT_CALL(test_input, unsubscribe(sf::Keyboard::Key::W)).Times(1);
+  movement_controller.clear_action(rpg::action::move_forward);
+}
+
+TEST_F(nice_controllers_movement, moves_pooled_transformable_by_handle) {
+  constexpr rpg::window::key_state key_down{
+      .position = rpg::window::key_position::down,
+      .seconds_in_current_position = 0,
+  };
+
+  EXPECT_CALL(test_input, get_key_state(sf::Keyboard::Key::W))
+      .WillRepeatedly(::testing::Return(key_down));
+  EXPECT_CALL(test_speed, frontal_movement())
+      .WillRepeatedly(::testing::Return(1.0f));
+  movement_controller.map_action(rpg::action::move_forward,
+                                 sf::Keyboard::Key::W);
+
+  rpg::slot_map<sf::Sprite> sprites{};
+  const auto first = sprites.insert();
+  const auto moved = sprites.insert();
+  movement_controller.attach(sprites, moved);
+  EXPECT_TRUE(movement_controller.is_attached());
+  EXPECT_EQ(movement_controller.handle(), moved);
+  movement_controller.update(sf::seconds(1.0f));
+
+  // Erasing the first sprite moves the attached one into its place.
+  std::ignore = sprites.erase(first);
+  movement_controller.update(sf::seconds(1.0f));
+  EXPECT_EQ(2.0f, sprites.get(moved).getPosition().x);
+}
+
+TEST_F(nice_controllers_movement, erasing_pooled_transformable_detaches) {
+  rpg::slot_map<sf::Transformable> transformables{};
+  const auto handle = transformables.insert();
+  movement_controller.attach(transformables, handle);
+  std::ignore = transformables.erase(handle);
+  std::ignore = transformables.insert();
+  EXPECT_FALSE(movement_controller.is_attached());
+  EXPECT_FALSE(movement_controller.moved());
+  movement_controller.update(sf::seconds(1.0f));
+  EXPECT_FALSE(movement_controller.moved());
+
+  movement_controller.detach();
+  EXPECT_EQ(movement_controller.handle(), rpg::null_slot_handle);
+}
+
 #if defined(RPG_OS_IS_WINDOWS)
 
 int main(int argc, char **argv) {
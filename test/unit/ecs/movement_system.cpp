@@ -0,0 +1,232 @@
+#include <rpg/action.hpp>
+#include <rpg/controllers/batch_movement.hpp>
+#include <rpg/controllers/movement.hpp>
+#include <rpg/ecs/entity.hpp>
+#include <rpg/ecs/movement_system.hpp>
+#include <rpg/ecs/registry.hpp>
+#include <rpg/window/key_position.hpp>
+#include <rpg/window/key_state.hpp>
+
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/Window/Keyboard.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace {
+constexpr std::array actions{
+    rpg::action::move_forward, rpg::action::move_backward,
+    rpg::action::move_right,   rpg::action::move_left,
+    rpg::action::rotate_right, rpg::action::rotate_left,
+};
+
+constexpr std::array keys{
+    sf::Keyboard::Key::W, sf::Keyboard::Key::S, sf::Keyboard::Key::D,
+    sf::Keyboard::Key::A, sf::Keyboard::Key::E, sf::Keyboard::Key::Q,
+};
+
+// Reports the keys for the actions in `actions` as down.
+struct action_input {
+  rpg::controllers::action_set actions{};
+  std::size_t subscribed{0};
+
+  [[nodiscard]] rpg::window::key_state
+  get_key_state(const sf::Keyboard::Key key) const {
+    for (std::size_t i = 0; i < std::size(keys); ++i) {
+      if (keys[i] == key and
+          (actions & rpg::controllers::action_bit(::actions[i])) != 0) {
+        return {.position = rpg::window::key_position::down,
+                .seconds_in_current_position = 0};
+      }
+    }
+    return {.position = rpg::window::key_position::up,
+            .seconds_in_current_position = 0};
+  }
+
+  void subscribe(const sf::Keyboard::Key) { ++subscribed; }
+  void unsubscribe(const sf::Keyboard::Key) { --subscribed; }
+};
+
+struct speed {
+  float frontal;
+  float backward;
+  float lateral;
+  float rotational;
+
+  [[nodiscard]] float frontal_movement() const noexcept { return frontal; }
+  [[nodiscard]] float backward_movement() const noexcept { return backward; }
+  [[nodiscard]] float lateral_movement() const noexcept { return lateral; }
+  [[nodiscard]] float rotational_movement() const noexcept {
+    return rotational;
+  }
+};
+
+// One movement controller per entity, used as the reference implementation.
+struct oracle {
+  action_input input{};
+  speed speeds;
+  sf::Transformable transformable{};
+  rpg::controllers::movement<action_input, speed> controller{input, speeds};
+
+  explicit oracle(const speed &values) : speeds(values) {
+    for (std::size_t i = 0; i < std::size(actions); ++i) {
+      controller.map_action(actions[i], keys[i]);
+    }
+  }
+};
+
+using registry =
+    rpg::ecs::registry<rpg::ecs::position, rpg::ecs::heading,
+                       rpg::ecs::movement_speed, rpg::ecs::movement_actions,
+                       rpg::ecs::input_controlled>;
+
+auto add_mover(registry &entities, const float x, const float y,
+               const speed &values) {
+  const auto id = entities.create();
+  entities.emplace<rpg::ecs::position>(id, x, y);
+  entities.emplace<rpg::ecs::heading>(id);
+  entities.emplace<rpg::ecs::movement_speed>(
+      id, values.frontal, values.backward, values.lateral, values.rotational);
+  entities.emplace<rpg::ecs::movement_actions>(id);
+  return id;
+}
+} // namespace
+
+TEST(ecs_movement_system, matches_movement_controller) {
+  constexpr auto entity_count = 256;
+  constexpr auto frame_count = 500;
+
+  std::mt19937 random{42};
+  std::uniform_real_distribution<float> speeds{1.0f, 500.0f};
+  std::uniform_real_distribution<float> positions{-1000.0f, 1000.0f};
+  std::uniform_int_distribution<int> action_sets{0, (1 << 6) - 1};
+  std::uniform_int_distribution<int> milliseconds{1, 50};
+
+  registry entities{};
+  rpg::ecs::movement_system<> movement{};
+  std::vector<std::unique_ptr<oracle>> oracles{};
+  std::vector<rpg::ecs::entity> ids{};
+  for (auto i = 0; i < entity_count; ++i) {
+    auto &entity = *oracles.emplace_back(std::make_unique<oracle>(
+        speed{speeds(random), speeds(random), speeds(random), speeds(random)}));
+    entity.transformable.setPosition(positions(random), positions(random));
+    entity.controller.attach(entity.transformable);
+    ids.push_back(add_mover(entities, entity.transformable.getPosition().x,
+                            entity.transformable.getPosition().y,
+                            entity.speeds));
+  }
+
+  sf::Transformable transformable{};
+  for (auto frame = 0; frame < frame_count; ++frame) {
+    const auto delta_time = sf::milliseconds(milliseconds(random));
+    for (std::size_t i = 0; i < entity_count; ++i) {
+      const auto actions =
+          static_cast<rpg::controllers::action_set>(action_sets(random));
+      oracles[i]->input.actions = actions;
+      oracles[i]->controller.update(delta_time);
+      entities.get<rpg::ecs::movement_actions>(ids[i]).actions = actions;
+    }
+    movement.update(entities, delta_time);
+    ASSERT_EQ(movement.size(), entity_count);
+
+    for (std::size_t i = 0; i < entity_count; ++i) {
+      rpg::ecs::store(entities.get<rpg::ecs::position>(ids[i]),
+                      entities.get<rpg::ecs::heading>(ids[i]), transformable);
+      const auto &expected = oracles[i]->transformable;
+      ASSERT_EQ(expected.getPosition(), transformable.getPosition())
+          << "entity " << i << " frame " << frame;
+      ASSERT_EQ(expected.getRotation(),
+                entities.get<rpg::ecs::heading>(ids[i]).rotation)
+          << "entity " << i << " frame " << frame;
+    }
+  }
+}
+
+TEST(ecs_movement_system, skips_entities_missing_a_component) {
+  registry entities{};
+  rpg::ecs::movement_system<> movement{};
+  const auto mover = add_mover(entities, 0.0f, 0.0f, {100, 100, 100, 100});
+  const auto still = entities.create();
+  entities.emplace<rpg::ecs::position>(still, 5.0f, 5.0f);
+  entities.emplace<rpg::ecs::movement_actions>(
+      still, rpg::controllers::action_bit(rpg::action::move_forward));
+  entities.get<rpg::ecs::movement_actions>(mover).actions =
+      rpg::controllers::action_bit(rpg::action::move_forward);
+
+  movement.update(entities, sf::seconds(1));
+  EXPECT_EQ(movement.size(), 1);
+  EXPECT_FLOAT_EQ(entities.get<rpg::ecs::position>(mover).x, 100.0f);
+  EXPECT_FLOAT_EQ(entities.get<rpg::ecs::position>(still).x, 5.0f);
+}
+
+TEST(ecs_movement_system, keeps_up_with_entities_coming_and_going) {
+  registry entities{};
+  rpg::ecs::movement_system<> movement{};
+  std::vector<rpg::ecs::entity> ids{};
+  for (auto i = 0; i < 10; ++i) {
+    ids.push_back(add_mover(entities, 0.0f, 0.0f, {1, 1, 1, 1}));
+    entities.get<rpg::ecs::movement_actions>(ids.back()).actions =
+        rpg::controllers::action_bit(rpg::action::move_forward);
+  }
+  movement.update(entities, sf::seconds(1));
+  std::ignore = entities.destroy(ids[3]);
+  std::ignore = entities.destroy(ids[7]);
+  movement.update(entities, sf::seconds(1));
+  EXPECT_EQ(movement.size(), 8);
+  for (const auto id : ids) {
+    if (entities.valid(id)) {
+      EXPECT_FLOAT_EQ(entities.get<rpg::ecs::position>(id).x, 2.0f);
+    }
+  }
+}
+
+TEST(ecs_input_system, drives_input_controlled_entities_only) {
+  registry entities{};
+  action_input input{};
+  rpg::ecs::input_system<action_input> system{input};
+  for (std::size_t i = 0; i < std::size(actions); ++i) {
+    system.map_action(actions[i], keys[i]);
+  }
+  EXPECT_EQ(input.subscribed, std::size(actions));
+
+  const auto player = add_mover(entities, 0.0f, 0.0f, {1, 1, 1, 1});
+  entities.emplace<rpg::ecs::input_controlled>(player);
+  const auto other = add_mover(entities, 0.0f, 0.0f, {1, 1, 1, 1});
+
+  input.actions = rpg::controllers::action_bit(rpg::action::move_left) |
+                  rpg::controllers::action_bit(rpg::action::rotate_left);
+  system.update(entities);
+  EXPECT_EQ(entities.get<rpg::ecs::movement_actions>(player).actions,
+            input.actions);
+  EXPECT_EQ(entities.get<rpg::ecs::movement_actions>(other).actions, 0);
+
+  system.clear_action(rpg::action::move_left);
+  EXPECT_EQ(input.subscribed, std::size(actions) - 1);
+  system.update(entities);
+  EXPECT_EQ(entities.get<rpg::ecs::movement_actions>(player).actions,
+            rpg::controllers::action_bit(rpg::action::rotate_left));
+}
+
+TEST(ecs_input_system, remapping_releases_the_old_key) {
+  action_input input{};
+  rpg::ecs::input_system<action_input> system{input};
+  system.map_action(rpg::action::move_forward, sf::Keyboard::Key::W);
+  system.map_action(rpg::action::move_forward, sf::Keyboard::Key::Up);
+  EXPECT_EQ(input.subscribed, 1);
+  system.map_action(rpg::action::move_forward, sf::Keyboard::Key::Unknown);
+  EXPECT_EQ(input.subscribed, 0);
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
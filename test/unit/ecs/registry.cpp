@@ -0,0 +1,206 @@
+#include <rpg/ecs/entity.hpp>
+#include <rpg/ecs/group.hpp>
+#include <rpg/ecs/registry.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <set>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct health {
+  int value{0};
+};
+
+struct armour {
+  int value{0};
+};
+
+struct name {
+  char letter{'?'};
+};
+
+using registry = rpg::ecs::registry<health, armour, name>;
+} // namespace
+
+TEST(ecs_registry, created_entities_are_valid_and_distinct) {
+  registry entities{};
+  const auto first = entities.create();
+  const auto second = entities.create();
+  EXPECT_TRUE(entities.valid(first));
+  EXPECT_TRUE(entities.valid(second));
+  EXPECT_NE(first, second);
+  EXPECT_EQ(entities.size(), 2);
+  EXPECT_FALSE(entities.valid(rpg::ecs::null_entity));
+}
+
+TEST(ecs_registry, destroyed_ids_go_stale_when_the_index_is_reused) {
+  registry entities{};
+  const auto first = entities.create();
+  entities.emplace<health>(first, 10);
+  EXPECT_TRUE(entities.destroy(first));
+  EXPECT_FALSE(entities.valid(first));
+  EXPECT_FALSE(entities.destroy(first));
+
+  const auto reused = entities.create();
+  EXPECT_EQ(reused.index, first.index);
+  EXPECT_NE(reused.generation, first.generation);
+  EXPECT_TRUE(entities.valid(reused));
+  EXPECT_FALSE(entities.valid(first));
+  EXPECT_FALSE(entities.has<health>(reused));
+  EXPECT_FALSE(entities.has<health>(first));
+  EXPECT_EQ(entities.size(), 1);
+}
+
+TEST(ecs_registry, components_can_be_added_read_and_removed) {
+  registry entities{};
+  const auto id = entities.create();
+  entities.emplace<health>(id, 10);
+  entities.emplace<armour>(id, 3);
+  EXPECT_TRUE((entities.has<health, armour>(id)));
+  EXPECT_FALSE((entities.has<health, name>(id)));
+  EXPECT_EQ(entities.get<health>(id).value, 10);
+
+  entities.emplace<health>(id, 20);
+  EXPECT_EQ(entities.get<health>(id).value, 20);
+  EXPECT_EQ(entities.storage<health>().size(), 1);
+
+  EXPECT_TRUE(entities.remove<health>(id));
+  EXPECT_FALSE(entities.remove<health>(id));
+  EXPECT_EQ(entities.try_get<health>(id), nullptr);
+  EXPECT_NE(entities.try_get<armour>(id), nullptr);
+}
+
+TEST(ecs_registry, removing_keeps_components_packed) {
+  registry entities{};
+  std::vector<rpg::ecs::entity> ids{};
+  for (auto i = 0; i < 5; ++i) {
+    ids.push_back(entities.create());
+    entities.emplace<health>(ids.back(), i);
+  }
+  std::ignore = entities.remove<health>(ids[1]);
+  const auto &pool = entities.storage<health>();
+  ASSERT_EQ(pool.size(), 4);
+  for (std::size_t i = 0; i < pool.size(); ++i) {
+    const auto id = pool.entities()[i];
+    EXPECT_EQ(pool.position(id), i);
+    EXPECT_EQ(pool.components()[i].value,
+              std::ranges::find(ids, id) - std::begin(ids));
+  }
+}
+
+TEST(ecs_registry, each_visits_entities_with_every_component) {
+  registry entities{};
+  std::set<int> expected{};
+  for (auto i = 0; i < 20; ++i) {
+    const auto id = entities.create();
+    entities.emplace<health>(id, i);
+    if (i % 3 == 0) {
+      entities.emplace<armour>(id, i);
+      expected.insert(i);
+    }
+  }
+
+  std::set<int> visited{};
+  entities.each<health, armour>(
+      [&](const rpg::ecs::entity, const health &hp, const armour &ac) {
+        EXPECT_EQ(hp.value, ac.value);
+        visited.insert(hp.value);
+      });
+  EXPECT_EQ(visited, expected);
+}
+
+TEST(ecs_group, packs_matching_entities_at_the_front_in_the_same_order) {
+  registry entities{};
+  std::mt19937 random{42};
+  std::bernoulli_distribution coin{0.5};
+  std::set<int> expected{};
+  for (auto i = 0; i < 200; ++i) {
+    const auto id = entities.create();
+    const auto has_health = coin(random);
+    const auto has_armour = coin(random);
+    if (has_health) {
+      entities.emplace<health>(id, i);
+    }
+    if (has_armour) {
+      entities.emplace<armour>(id, i);
+    }
+    if (has_health and has_armour) {
+      expected.insert(i);
+    }
+  }
+
+  rpg::ecs::group<health, armour> group{};
+  ASSERT_EQ(group.refresh(entities), std::size(expected));
+  const auto ids = group.entities(entities);
+  const auto healths = group.components<health>(entities);
+  const auto armours = group.components<armour>(entities);
+  std::set<int> packed{};
+  for (std::size_t i = 0; i < group.size(); ++i) {
+    EXPECT_EQ(entities.storage<armour>().entities()[i], ids[i]);
+    EXPECT_EQ(healths[i].value, armours[i].value);
+    packed.insert(healths[i].value);
+  }
+  EXPECT_EQ(packed, expected);
+}
+
+TEST(ecs_group, repacks_only_after_owned_pools_change) {
+  registry entities{};
+  rpg::ecs::group<health, armour> group{};
+  const auto first = entities.create();
+  entities.emplace<health>(first, 1);
+  entities.emplace<armour>(first, 1);
+  EXPECT_EQ(group.refresh(entities), 1);
+
+  const auto version = entities.storage<health>().version();
+  EXPECT_EQ(group.refresh(entities), 1);
+  EXPECT_EQ(entities.storage<health>().version(), version);
+
+  const auto second = entities.create();
+  entities.emplace<health>(second, 2);
+  EXPECT_EQ(group.refresh(entities), 1);
+  entities.emplace<armour>(second, 2);
+  EXPECT_EQ(group.refresh(entities), 2);
+  // Unowned pools do not matter.
+  entities.emplace<name>(second, 'b');
+  EXPECT_EQ(group.refresh(entities), 2);
+
+  std::ignore = entities.destroy(first);
+  EXPECT_EQ(group.refresh(entities), 1);
+  EXPECT_EQ(group.entities(entities)[0], second);
+}
+
+TEST(ecs_group, each_visits_every_member) {
+  registry entities{};
+  for (auto i = 0; i < 10; ++i) {
+    const auto id = entities.create();
+    entities.emplace<health>(id, i);
+    if (i % 2 == 0) {
+      entities.emplace<armour>(id, 0);
+    }
+  }
+  rpg::ecs::group<health, armour> group{};
+  auto visited = 0;
+  group.each(entities,
+             [&](const rpg::ecs::entity id, health &hp, armour &ac) {
+               EXPECT_EQ(entities.get<health>(id).value, hp.value);
+               ac.value = hp.value;
+               ++visited;
+             });
+  EXPECT_EQ(visited, 5);
+  entities.each<health, armour>(
+      [](const rpg::ecs::entity, const health &hp, const armour &ac) {
+        EXPECT_EQ(hp.value, ac.value);
+      });
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
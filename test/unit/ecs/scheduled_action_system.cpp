@@ -0,0 +1,141 @@
+#include <rpg/ecs/entity.hpp>
+#include <rpg/ecs/registry.hpp>
+#include <rpg/ecs/scheduled_action_system.hpp>
+
+#include <SFML/System/Time.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <tuple>
+#include <vector>
+
+namespace {
+using registry = rpg::ecs::registry<rpg::ecs::scheduled_delay,
+                                    rpg::ecs::scheduled_callback>;
+using system_type = rpg::ecs::scheduled_action_system;
+} // namespace
+
+TEST(ecs_scheduled_action_system, fires_once_the_delay_has_passed) {
+  registry entities{};
+  system_type scheduled{};
+  const auto id = entities.create();
+  std::vector<rpg::ecs::entity> fired{};
+  system_type::schedule(entities, id, std::chrono::milliseconds{500},
+                        [&](const rpg::ecs::entity target) {
+                          fired.push_back(target);
+                        });
+
+  scheduled.update(entities, sf::milliseconds(250));
+  EXPECT_TRUE(fired.empty());
+  scheduled.update(entities, sf::milliseconds(250));
+  ASSERT_EQ(fired.size(), 1);
+  EXPECT_EQ(fired[0], id);
+  EXPECT_FALSE(entities.has<rpg::ecs::scheduled_delay>(id));
+  EXPECT_FALSE(entities.has<rpg::ecs::scheduled_callback>(id));
+
+  scheduled.update(entities, sf::seconds(10));
+  EXPECT_EQ(fired.size(), 1);
+}
+
+TEST(ecs_scheduled_action_system, paused_actions_do_not_count_down) {
+  registry entities{};
+  system_type scheduled{};
+  const auto id = entities.create();
+  auto fired = 0;
+  system_type::schedule(entities, id, std::chrono::seconds{1},
+                        [&](const rpg::ecs::entity) { ++fired; });
+
+  system_type::pause(entities, id);
+  scheduled.update(entities, sf::seconds(5));
+  EXPECT_EQ(fired, 0);
+  system_type::resume(entities, id);
+  scheduled.update(entities, sf::milliseconds(999));
+  EXPECT_EQ(fired, 0);
+  scheduled.update(entities, sf::milliseconds(1));
+  EXPECT_EQ(fired, 1);
+}
+
+TEST(ecs_scheduled_action_system, cancelled_actions_never_fire) {
+  registry entities{};
+  system_type scheduled{};
+  const auto cancelled = entities.create();
+  const auto destroyed = entities.create();
+  auto fired = 0;
+  system_type::schedule(entities, cancelled, std::chrono::seconds{1},
+                        [&](const rpg::ecs::entity) { ++fired; });
+  system_type::schedule(entities, destroyed, std::chrono::seconds{1},
+                        [&](const rpg::ecs::entity) { ++fired; });
+  system_type::cancel(entities, cancelled);
+  std::ignore = entities.destroy(destroyed);
+  scheduled.update(entities, sf::seconds(2));
+  EXPECT_EQ(fired, 0);
+}
+
+TEST(ecs_scheduled_action_system, actions_of_destroyed_entities_are_dropped) {
+  registry entities{};
+  system_type scheduled{};
+  const auto first = entities.create();
+  const auto second = entities.create();
+  std::vector<rpg::ecs::entity> fired{};
+  // Whichever fires first destroys the other, whose action then must not run.
+  const auto destroy = [&](const rpg::ecs::entity other) {
+    return [&, other](const rpg::ecs::entity target) {
+      fired.push_back(target);
+      std::ignore = entities.destroy(other);
+    };
+  };
+  system_type::schedule(entities, first, std::chrono::seconds{1},
+                        destroy(second));
+  system_type::schedule(entities, second, std::chrono::seconds{1},
+                        destroy(first));
+  scheduled.update(entities, sf::seconds(1));
+  ASSERT_EQ(fired.size(), 1);
+  EXPECT_TRUE(entities.valid(fired[0]));
+  EXPECT_EQ(entities.size(), 1);
+}
+
+TEST(ecs_scheduled_action_system, actions_can_reschedule_themselves) {
+  registry entities{};
+  system_type scheduled{};
+  const auto id = entities.create();
+  auto fired = 0;
+  struct repeat {
+    registry *entities;
+    int *fired;
+
+    void operator()(const rpg::ecs::entity target) const {
+      ++*fired;
+      system_type::schedule(*entities, target, std::chrono::seconds{1},
+                            *this);
+    }
+  };
+  system_type::schedule(entities, id, std::chrono::seconds{1},
+                        repeat{.entities = &entities, .fired = &fired});
+  for (auto second = 0; second < 5; ++second) {
+    scheduled.update(entities, sf::seconds(1));
+  }
+  EXPECT_EQ(fired, 5);
+}
+
+TEST(ecs_scheduled_action_system, many_entities_fire_in_the_same_update) {
+  registry entities{};
+  system_type scheduled{};
+  auto fired = 0;
+  for (auto i = 0; i < 100; ++i) {
+    system_type::schedule(entities, entities.create(),
+                          std::chrono::milliseconds{10 * (i % 10)},
+                          [&](const rpg::ecs::entity) { ++fired; });
+  }
+  scheduled.update(entities, sf::milliseconds(45));
+  EXPECT_EQ(fired, 50);
+  scheduled.update(entities, sf::milliseconds(45));
+  EXPECT_EQ(fired, 100);
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,109 @@
+#include <rpg/frame_arena.hpp>
+
+#include <rpg/test/allocations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+namespace {
+auto is_aligned(const void *const pointer, const std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+} // namespace
+
+TEST(frame_arena, allocations_are_aligned_and_do_not_overlap) {
+  rpg::frame_arena arena{{.capacity = 4096}};
+  auto *const first = static_cast<std::byte *>(arena.allocate(3, 1));
+  auto *const second = static_cast<std::byte *>(arena.allocate(8, 8));
+  auto *const third = static_cast<std::byte *>(arena.allocate(64, 64));
+  EXPECT_TRUE(is_aligned(second, 8));
+  EXPECT_TRUE(is_aligned(third, 64));
+  EXPECT_GE(second, first + 3);
+  EXPECT_GE(third, second + 8);
+  EXPECT_EQ(arena.overflow_count(), 0);
+  EXPECT_GE(arena.used(), 75);
+}
+
+TEST(frame_arena, memory_lasts_through_the_next_frame) {
+  rpg::frame_arena arena{{.capacity = 4096}};
+  auto *const first = static_cast<int *>(arena.allocate(sizeof(int) * 16));
+  std::iota(first, first + 16, 0);
+
+  arena.next_frame();
+  auto *const second = static_cast<int *>(arena.allocate(sizeof(int) * 16));
+  std::fill(second, second + 16, -1);
+  EXPECT_NE(first, second);
+  for (auto i = 0; i < 16; ++i) {
+    EXPECT_EQ(first[i], i);
+  }
+
+  // The first frame's buffer comes round again.
+  arena.next_frame();
+  EXPECT_EQ(arena.used(), 0);
+  EXPECT_EQ(arena.allocate(sizeof(int) * 16), first);
+}
+
+TEST(frame_arena, pmr_containers_allocate_from_the_arena) {
+  rpg::frame_arena arena{{.capacity = 1 << 16}};
+  std::pmr::vector<std::uint32_t> ids{arena.memory_resource()};
+  const auto allocations = rpg::test::allocations::count();
+  for (std::uint32_t id = 0; id < 1000; ++id) {
+    ids.push_back(id);
+  }
+  EXPECT_EQ(rpg::test::allocations::count(), allocations);
+  EXPECT_GE(arena.used(), 1000 * sizeof(std::uint32_t));
+  EXPECT_EQ(ids.back(), 999);
+}
+
+TEST(frame_arena, grows_after_a_frame_that_did_not_fit) {
+  rpg::frame_arena arena{{.capacity = 256}};
+  auto *const small = arena.allocate(128);
+  auto *const large = static_cast<std::byte *>(arena.allocate(1000));
+  // The overflow is real memory.
+  std::fill(large, large + 1000, std::byte{1});
+  EXPECT_NE(small, nullptr);
+  EXPECT_EQ(arena.overflow_count(), 1);
+  EXPECT_GE(arena.used(), 1128);
+
+  arena.next_frame();
+  arena.next_frame();
+  EXPECT_GE(arena.capacity(), 1128);
+  std::ignore = arena.allocate(128);
+  std::ignore = arena.allocate(1000);
+  EXPECT_EQ(arena.overflow_count(), 0);
+}
+
+TEST(frame_arena, steady_state_frames_do_not_touch_the_heap) {
+  rpg::frame_arena arena{{.capacity = 1 << 16}};
+  const auto frame = [&] {
+    arena.next_frame();
+    std::pmr::vector<std::pmr::vector<std::uint32_t>> lists{
+        arena.memory_resource()};
+    for (std::uint32_t i = 0; i < 100; ++i) {
+      auto &list = lists.emplace_back();
+      list.push_back(i);
+      list.push_back(i + 1);
+    }
+  };
+  frame();
+  frame();
+  const auto allocations = rpg::test::allocations::count();
+  for (auto i = 0; i < 100; ++i) {
+    frame();
+  }
+  EXPECT_EQ(rpg::test::allocations::count(), allocations);
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
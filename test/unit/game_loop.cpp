@@ -0,0 +1,110 @@
+#include <rpg/game_loop.hpp>
+
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+TEST(game_loop, step_comes_from_simulation_rate) {
+  rpg::game_loop loop{{.simulation_rate = 120, .max_ticks_per_frame = 8}};
+  EXPECT_EQ(sf::microseconds(8'333), loop.step());
+}
+
+TEST(game_loop, rejects_settings_that_never_tick) {
+  EXPECT_THROW(rpg::game_loop({.simulation_rate = 0}), std::invalid_argument);
+  EXPECT_THROW(rpg::game_loop({.simulation_rate = 1'000'001}),
+               std::invalid_argument);
+  EXPECT_THROW(rpg::game_loop({.max_ticks_per_frame = 0}),
+               std::invalid_argument);
+
+  const rpg::game_loop fastest{{.simulation_rate = 1'000'000}};
+  EXPECT_EQ(sf::microseconds(1), fastest.step());
+}
+
+TEST(game_loop, runs_one_tick_per_step_of_elapsed_time) {
+  rpg::game_loop loop{{.simulation_rate = 100, .max_ticks_per_frame = 8}};
+  std::vector<sf::Time> steps{};
+  const auto ticks =
+      loop.advance(sf::milliseconds(35),
+                   [&](const sf::Time step) { steps.push_back(step); });
+  EXPECT_EQ(3, ticks);
+  EXPECT_EQ(3, loop.ticks());
+  EXPECT_EQ((std::vector{sf::milliseconds(10), sf::milliseconds(10),
+                         sf::milliseconds(10)}),
+            steps);
+  EXPECT_FLOAT_EQ(0.5f, loop.alpha());
+}
+
+TEST(game_loop, carries_remainder_to_next_frame) {
+  rpg::game_loop loop{{.simulation_rate = 100, .max_ticks_per_frame = 8}};
+  auto ticks = 0;
+  const auto simulate = [&](const sf::Time) { ++ticks; };
+  EXPECT_EQ(0, loop.advance(sf::milliseconds(6), simulate));
+  EXPECT_FLOAT_EQ(0.6f, loop.alpha());
+  EXPECT_EQ(1, loop.advance(sf::milliseconds(6), simulate));
+  EXPECT_FLOAT_EQ(0.2f, loop.alpha());
+  EXPECT_EQ(1, ticks);
+}
+
+TEST(game_loop, simulates_faster_than_it_renders) {
+  rpg::game_loop loop{{.simulation_rate = 120, .max_ticks_per_frame = 8}};
+  auto ticks = 0;
+  for (auto frame = 0; frame < 60; ++frame) {
+    loop.advance(sf::microseconds(16'667), [&](const sf::Time) { ++ticks; });
+  }
+  EXPECT_EQ(120, ticks);
+  EXPECT_EQ(sf::Time::Zero, loop.dropped_time());
+}
+
+TEST(game_loop, caps_ticks_per_frame_and_drops_the_rest) {
+  rpg::game_loop loop{{.simulation_rate = 100, .max_ticks_per_frame = 4}};
+  auto ticks = 0;
+  const auto simulate = [&](const sf::Time) { ++ticks; };
+  EXPECT_EQ(4, loop.advance(sf::milliseconds(1'005), simulate));
+  EXPECT_EQ(sf::milliseconds(960), loop.dropped_time());
+  EXPECT_FLOAT_EQ(0.5f, loop.alpha());
+
+  // The loop is not left behind.
+  EXPECT_EQ(1, loop.advance(sf::milliseconds(10), simulate));
+  EXPECT_EQ(5, ticks);
+}
+
+TEST(game_loop, interpolates_between_states) {
+  sf::Transformable previous{};
+  previous.setPosition(0.0f, 10.0f);
+  previous.setRotation(90.0f);
+  sf::Transformable current{};
+  current.setPosition(10.0f, 30.0f);
+  current.setRotation(180.0f);
+  current.setScale(3.0f, 1.0f);
+
+  sf::Transformable result{};
+  rpg::interpolate(previous, current, 0.25f, result);
+  EXPECT_EQ(sf::Vector2f(2.5f, 15.0f), result.getPosition());
+  EXPECT_FLOAT_EQ(112.5f, result.getRotation());
+  EXPECT_EQ(sf::Vector2f(1.5f, 1.0f), result.getScale());
+}
+
+TEST(game_loop, interpolates_rotation_the_short_way) {
+  sf::Transformable previous{};
+  previous.setRotation(350.0f);
+  sf::Transformable current{};
+  current.setRotation(10.0f);
+
+  sf::Transformable result{};
+  rpg::interpolate(previous, current, 0.75f, result);
+  EXPECT_FLOAT_EQ(5.0f, result.getRotation());
+  rpg::interpolate(current, previous, 0.75f, result);
+  EXPECT_FLOAT_EQ(355.0f, result.getRotation());
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
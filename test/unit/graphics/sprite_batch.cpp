@@ -0,0 +1,131 @@
+#include <rpg/graphics/sprite_batch.hpp>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+
+namespace {
+// The corners sf::Sprite would draw, in the order sprite_batch emits them.
+void expect_quad(const sf::VertexArray &vertices, const std::size_t sprite,
+                 const sf::Transformable &transformable,
+                 const sf::IntRect &rect) {
+  const auto width = static_cast<float>(rect.width);
+  const auto height = static_cast<float>(rect.height);
+  const auto left = static_cast<float>(rect.left);
+  const auto top = static_cast<float>(rect.top);
+  const auto &transform = transformable.getTransform();
+  const std::array<sf::Vector2f, 6> positions{
+      transform.transformPoint(0.0f, 0.0f),
+      transform.transformPoint(0.0f, height),
+      transform.transformPoint(width, 0.0f),
+      transform.transformPoint(width, 0.0f),
+      transform.transformPoint(0.0f, height),
+      transform.transformPoint(width, height),
+  };
+  const std::array<sf::Vector2f, 6> texture_coordinates{
+      sf::Vector2f{left, top},
+      sf::Vector2f{left, top + height},
+      sf::Vector2f{left + width, top},
+      sf::Vector2f{left + width, top},
+      sf::Vector2f{left, top + height},
+      sf::Vector2f{left + width, top + height},
+  };
+  for (std::size_t i = 0; i < std::size(positions); ++i) {
+    EXPECT_EQ(positions[i], vertices[sprite * 6 + i].position) << i;
+    EXPECT_EQ(texture_coordinates[i], vertices[sprite * 6 + i].texCoords)
+        << i;
+  }
+}
+} // namespace
+
+TEST(graphics_sprite_batch, groups_sprites_by_texture) {
+  const sf::Texture first{};
+  const sf::Texture second{};
+  const sf::Transformable transformable{};
+  const sf::IntRect rect{0, 0, 16, 16};
+  rpg::graphics::sprite_batch batch{};
+  const auto a = batch.add(first, rect, transformable);
+  const auto b = batch.add(second, rect, transformable);
+  const auto c = batch.add(first, rect, transformable);
+
+  EXPECT_EQ(2, batch.batch_count());
+  EXPECT_EQ(3, batch.size());
+  EXPECT_EQ(a.batch, c.batch);
+  EXPECT_NE(a.batch, b.batch);
+  EXPECT_EQ(0, a.index);
+  EXPECT_EQ(1, c.index);
+  EXPECT_EQ(12, batch.vertices(a.batch).getVertexCount());
+  EXPECT_EQ(6, batch.vertices(b.batch).getVertexCount());
+}
+
+TEST(graphics_sprite_batch, quads_match_sprite_geometry) {
+  const sf::Texture texture{};
+  sf::Transformable transformable{};
+  transformable.setPosition(100.0f, 50.0f);
+  transformable.setRotation(30.0f);
+  transformable.setOrigin(8.0f, 12.0f);
+  transformable.setScale(2.0f, 0.5f);
+  const sf::IntRect rect{32, 64, 16, 24};
+  rpg::graphics::sprite_batch batch{};
+  const auto handle = batch.add(texture, rect, transformable);
+  batch.update();
+
+  expect_quad(batch.vertices(handle.batch), handle.index, transformable, rect);
+}
+
+TEST(graphics_sprite_batch, only_rebuilds_dirty_sprites) {
+  const sf::Texture texture{};
+  std::array<sf::Transformable, 3> transformables{};
+  const sf::IntRect rect{0, 0, 16, 16};
+  rpg::graphics::sprite_batch batch{};
+  std::array<rpg::graphics::sprite_handle, 3> handles{};
+  for (std::size_t i = 0; i < std::size(transformables); ++i) {
+    handles[i] = batch.add(texture, rect, transformables[i]);
+  }
+  batch.update();
+  EXPECT_EQ(3, batch.rebuilt());
+  batch.update();
+  EXPECT_EQ(0, batch.rebuilt());
+
+  transformables[1].setPosition(5.0f, 5.0f);
+  transformables[2].setPosition(9.0f, 9.0f);
+  batch.mark_dirty(handles[1]);
+  batch.mark_dirty(handles[1]);
+  batch.update();
+  EXPECT_EQ(1, batch.rebuilt());
+  const auto &vertices = batch.vertices(handles[1].batch);
+  expect_quad(vertices, handles[1].index, transformables[1], rect);
+  // Not marked, so still where it was.
+  EXPECT_EQ(sf::Vector2f(0.0f, 0.0f), vertices[handles[2].index * 6].position);
+}
+
+TEST(graphics_sprite_batch, texture_rect_changes_rebuild_the_quad) {
+  const sf::Texture texture{};
+  const sf::Transformable transformable{};
+  rpg::graphics::sprite_batch batch{};
+  const auto handle =
+      batch.add(texture, sf::IntRect{0, 0, 16, 16}, transformable);
+  batch.update();
+
+  const sf::IntRect frame{16, 0, 16, 16};
+  batch.set_texture_rect(handle, frame);
+  batch.update();
+  EXPECT_EQ(1, batch.rebuilt());
+  expect_quad(batch.vertices(handle.batch), handle.index, transformable,
+              frame);
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
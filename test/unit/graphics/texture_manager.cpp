@@ -0,0 +1,239 @@
+#include <rpg/graphics/texture_manager.hpp>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+// Stands in for sf::Image: "decodes" a file by reading it, and fails on
+// missing files and ones that say "corrupt".
+struct fake_image {
+  std::string pixels{};
+
+  bool loadFromFile(const std::string &path) {
+    std::ifstream file{path, std::ios::binary};
+    pixels.assign(std::istreambuf_iterator<char>{file},
+                  std::istreambuf_iterator<char>{});
+    return file.is_open() and pixels != "corrupt";
+  }
+
+  bool loadFromMemory(const void *data, const std::size_t size) {
+    pixels.assign(static_cast<const char *>(data), size);
+    return pixels != "corrupt";
+  }
+
+  void create(const std::uint32_t, const std::uint32_t, const sf::Color &) {
+    pixels = "placeholder";
+  }
+
+  void setPixel(const std::uint32_t, const std::uint32_t, const sf::Color &) {}
+};
+
+// Stands in for sf::Texture so no GL context is needed.
+struct fake_texture {
+  std::string pixels{};
+  bool repeated{false};
+
+  bool loadFromImage(const fake_image &image) {
+    pixels = image.pixels;
+    return true;
+  }
+
+  void setRepeated(const bool value) { repeated = value; }
+};
+
+// Takes long enough to decode that a queue of them outlasts any test.
+struct slow_image : fake_image {
+  bool loadFromMemory(const void *data, const std::size_t size) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    return fake_image::loadFromMemory(data, size);
+  }
+};
+
+using texture_manager =
+    rpg::graphics::texture_manager<fake_texture, fake_image>;
+
+class texture_manager_test : public ::testing::Test {
+protected:
+  std::filesystem::path directory_{
+      std::filesystem::temp_directory_path() /
+      ("rpg_texture_manager_test_" +
+       std::to_string(
+           std::chrono::steady_clock::now().time_since_epoch().count()))};
+
+  void SetUp() override { std::filesystem::create_directories(directory_); }
+
+  void TearDown() override { std::filesystem::remove_all(directory_); }
+
+  [[nodiscard]] auto write(const std::string &name,
+                           const std::string &contents) const {
+    const auto path = directory_ / name;
+    std::ofstream{path, std::ios::binary} << contents;
+    return path.string();
+  }
+
+  // Updates until nothing is pending, giving up after a few seconds.
+  static void update_until_idle(texture_manager &manager,
+                                std::vector<std::size_t> &uploads) {
+    const auto give_up =
+        std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (manager.stats().pending() > 0 and
+           std::chrono::steady_clock::now() < give_up) {
+      manager.update();
+      uploads.push_back(manager.stats().frame_uploads);
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+  }
+};
+} // namespace
+
+TEST_F(texture_manager_test, handles_show_placeholder_until_uploaded) {
+  texture_manager manager{{.workers = 1}};
+  const auto handle = manager.load(write("grass.png", "grass"));
+
+  EXPECT_EQ(manager.state(handle), rpg::graphics::texture_state::loading);
+  EXPECT_EQ(manager.get(handle).pixels, "placeholder");
+  EXPECT_TRUE(manager.get(handle).repeated);
+
+  manager.finish();
+  EXPECT_EQ(manager.state(handle), rpg::graphics::texture_state::loaded);
+  EXPECT_EQ(manager.get(handle).pixels, "grass");
+  EXPECT_FALSE(manager.get(handle).repeated);
+}
+
+TEST_F(texture_manager_test, decodes_images_in_memory) {
+  texture_manager manager{{.workers = 1}};
+  const std::string pixels{"grass"};
+  const auto handle = manager.load(
+      "grass", std::as_bytes(std::span{std::data(pixels), std::size(pixels)}));
+  manager.finish();
+  EXPECT_EQ(manager.state(handle), rpg::graphics::texture_state::loaded);
+  EXPECT_EQ(manager.get(handle).pixels, "grass");
+  EXPECT_EQ(manager.path(handle), "grass");
+}
+
+TEST_F(texture_manager_test, textures_keep_their_address) {
+  texture_manager manager{{.workers = 2}};
+  const auto first = manager.load(write("first.png", "first"));
+  const auto *const texture = &manager.get(first);
+  for (auto i = 0; i < 100; ++i) {
+    std::ignore = manager.load(write(std::to_string(i) + ".png", "more"));
+  }
+  manager.finish();
+  EXPECT_EQ(&manager.get(first), texture);
+  EXPECT_EQ(texture->pixels, "first");
+}
+
+TEST_F(texture_manager_test, same_path_gives_same_handle) {
+  texture_manager manager{{.workers = 1}};
+  const auto path = write("grass.png", "grass");
+  const auto first = manager.load(path);
+  const auto second = manager.load(path);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(manager.stats().requested, 1);
+  EXPECT_EQ(manager.path(first), path);
+}
+
+TEST_F(texture_manager_test, failures_keep_the_placeholder) {
+  texture_manager manager{{.workers = 2}};
+  const auto missing = manager.load((directory_ / "missing.png").string());
+  const auto corrupt = manager.load(write("corrupt.png", "corrupt"));
+  manager.finish();
+
+  EXPECT_EQ(manager.state(missing), rpg::graphics::texture_state::failed);
+  EXPECT_EQ(manager.state(corrupt), rpg::graphics::texture_state::failed);
+  EXPECT_EQ(manager.get(missing).pixels, "placeholder");
+  EXPECT_EQ(manager.get(corrupt).pixels, "placeholder");
+  EXPECT_EQ(manager.stats().failed, 2);
+  EXPECT_EQ(manager.stats().pending(), 0);
+}
+
+TEST_F(texture_manager_test, update_uploads_at_least_one_texture) {
+  texture_manager manager{{.workers = 2, .upload_budget = sf::Time::Zero}};
+  std::vector<rpg::graphics::texture_handle> handles{};
+  for (auto i = 0; i < 8; ++i) {
+    const auto name = std::to_string(i);
+    handles.push_back(manager.load(write(name + ".png", name)));
+  }
+
+  std::vector<std::size_t> uploads{};
+  update_until_idle(manager, uploads);
+
+  ASSERT_EQ(manager.stats().pending(), 0);
+  EXPECT_EQ(manager.stats().loaded, 8);
+  for (const auto count : uploads) {
+    EXPECT_LE(count, 1);
+  }
+  for (auto i = 0; i < 8; ++i) {
+    EXPECT_EQ(manager.get(handles[i]).pixels, std::to_string(i));
+  }
+}
+
+TEST_F(texture_manager_test, generous_budget_uploads_everything_decoded) {
+  texture_manager manager{{.workers = 2, .upload_budget = sf::seconds(10)}};
+  for (auto i = 0; i < 8; ++i) {
+    std::ignore = manager.load(write(std::to_string(i) + ".png", "pixels"));
+  }
+
+  std::vector<std::size_t> uploads{};
+  update_until_idle(manager, uploads);
+
+  ASSERT_EQ(manager.stats().pending(), 0);
+  std::size_t total = 0;
+  for (const auto count : uploads) {
+    total += count;
+  }
+  EXPECT_EQ(total, 8);
+}
+
+TEST_F(texture_manager_test, reports_load_time_once_idle) {
+  texture_manager manager{{.workers = 1}};
+  EXPECT_EQ(manager.stats().last_load_time, sf::Time::Zero);
+  std::ignore = manager.load(write("grass.png", "grass"));
+  std::this_thread::sleep_for(std::chrono::milliseconds{2});
+  manager.finish();
+  EXPECT_GE(manager.stats().last_load_time, sf::milliseconds(2));
+  EXPECT_EQ(manager.stats().frame_uploads, 1);
+}
+
+TEST_F(texture_manager_test, destroying_drops_queued_jobs) {
+  const std::string pixels{"grass"};
+  const auto bytes =
+      std::as_bytes(std::span{std::data(pixels), std::size(pixels)});
+  const auto started = std::chrono::steady_clock::now();
+  {
+    rpg::graphics::texture_manager<fake_texture, slow_image> manager{
+        {.workers = 1}};
+    // Ten seconds of decoding if the queue were drained.
+    for (auto i = 0; i < 1000; ++i) {
+      std::ignore = manager.load(std::to_string(i), bytes);
+    }
+  }
+  EXPECT_LT(std::chrono::steady_clock::now() - started,
+            std::chrono::seconds{1});
+}
+
+TEST_F(texture_manager_test, defaults_to_at_least_one_worker) {
+  const texture_manager manager{};
+  EXPECT_GE(manager.worker_count(), 1);
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
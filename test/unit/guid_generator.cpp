@@ -0,0 +1,86 @@
+#include <rpg/guid.hpp>
+#include <rpg/guid_generator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+[[nodiscard]] auto timestamp(const rpg::guid &guid) {
+  std::uint64_t milliseconds = 0;
+  for (std::size_t i = 0; i < 6; ++i) {
+    milliseconds = (milliseconds << 8) | static_cast<std::uint64_t>(guid[i]);
+  }
+  return milliseconds;
+}
+
+[[nodiscard]] auto now() {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+}
+} // namespace
+
+TEST(guid_generator, sets_version_and_variant) {
+  rpg::guid_generator generator{};
+  const auto guid = generator.generate();
+  EXPECT_EQ(std::byte{0x70}, guid[6] & std::byte{0xf0});
+  EXPECT_EQ(std::byte{0x80}, guid[8] & std::byte{0xc0});
+}
+
+TEST(guid_generator, embeds_unix_time_in_milliseconds) {
+  rpg::guid_generator generator{};
+  const auto before = now();
+  const auto guid = generator.generate();
+  const auto after = now();
+  EXPECT_LE(before, timestamp(guid));
+  EXPECT_GE(after, timestamp(guid));
+}
+
+TEST(guid_generator, guids_from_one_thread_are_ordered) {
+  rpg::guid_generator generator{};
+  std::vector<rpg::guid> guids(100'000);
+  std::ranges::generate(guids, [&] { return generator.generate(); });
+  EXPECT_TRUE(std::ranges::is_sorted(guids));
+  EXPECT_EQ(std::cend(guids), std::ranges::adjacent_find(guids));
+}
+
+TEST(guid_generator, guids_do_not_collide_across_threads) {
+  constexpr std::size_t thread_count = 8;
+  constexpr std::size_t guids_per_thread = 200'000;
+  std::vector<std::vector<rpg::guid>> guids(thread_count);
+  {
+    std::vector<std::jthread> threads{};
+    for (auto &thread_guids : guids) {
+      threads.emplace_back([&thread_guids] {
+        rpg::guid_generator generator{};
+        thread_guids.resize(guids_per_thread);
+        std::ranges::generate(thread_guids,
+                              [&] { return generator.generate(); });
+      });
+    }
+  }
+
+  std::vector<rpg::guid> all{};
+  all.reserve(thread_count * guids_per_thread);
+  for (const auto &thread_guids : guids) {
+    all.insert(std::end(all), std::cbegin(thread_guids),
+               std::cend(thread_guids));
+  }
+  std::ranges::sort(all);
+  EXPECT_EQ(std::cend(all), std::ranges::adjacent_find(all));
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
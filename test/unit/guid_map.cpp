@@ -0,0 +1,129 @@
+#include <rpg/guid.hpp>
+#include <rpg/guid_generator.hpp>
+#include <rpg/guid_map.hpp>
+#include <rpg/operators/guid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+TEST(guid_map, find_returns_null_when_empty) {
+  using rpg::operators::operator""_guid;
+  rpg::guid_map<int> map{};
+  EXPECT_EQ(nullptr, map.find("0000000000000001"_guid));
+  EXPECT_FALSE(map.contains("0000000000000001"_guid));
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(guid_map, can_insert_and_find) {
+  using rpg::operators::operator""_guid;
+  rpg::guid_map<int> map{};
+  const auto [value, inserted] = map.try_emplace("0000000000000001"_guid, 42);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(42, *value);
+  ASSERT_NE(nullptr, map.find("0000000000000001"_guid));
+  EXPECT_EQ(42, *map.find("0000000000000001"_guid));
+  EXPECT_EQ(nullptr, map.find("0000000000000002"_guid));
+  EXPECT_EQ(1, map.size());
+}
+
+TEST(guid_map, try_emplace_does_not_overwrite) {
+  using rpg::operators::operator""_guid;
+  rpg::guid_map<int> map{};
+  std::ignore = map.try_emplace("0000000000000001"_guid, 42);
+  const auto [value, inserted] = map.try_emplace("0000000000000001"_guid, 7);
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(42, *value);
+  EXPECT_EQ(1, map.size());
+}
+
+TEST(guid_map, can_erase) {
+  using rpg::operators::operator""_guid;
+  rpg::guid_map<int> map{};
+  std::ignore = map.try_emplace("0000000000000001"_guid, 42);
+  EXPECT_TRUE(map.erase("0000000000000001"_guid));
+  EXPECT_FALSE(map.erase("0000000000000001"_guid));
+  EXPECT_EQ(nullptr, map.find("0000000000000001"_guid));
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(guid_map, holds_move_only_values) {
+  using rpg::operators::operator""_guid;
+  rpg::guid_map<std::unique_ptr<int>> map{};
+  std::ignore =
+      map.try_emplace("0000000000000001"_guid, std::make_unique<int>(42));
+  map.reserve(1000);
+  ASSERT_NE(nullptr, map.find("0000000000000001"_guid));
+  EXPECT_EQ(42, **map.find("0000000000000001"_guid));
+}
+
+TEST(guid_map, reserve_avoids_rehashing) {
+  rpg::guid_generator generator{};
+  rpg::guid_map<std::size_t> map{};
+  map.reserve(10'000);
+  const auto capacity = map.capacity();
+  for (std::size_t i = 0; i < 10'000; ++i) {
+    std::ignore = map.try_emplace(generator.generate(), i);
+  }
+  EXPECT_EQ(capacity, map.capacity());
+  EXPECT_EQ(10'000, map.size());
+}
+
+TEST(guid_map, matches_unordered_map_under_churn) {
+  rpg::guid_generator generator{};
+  std::mt19937 random{42};
+  rpg::guid_map<std::size_t> map{};
+  std::unordered_map<rpg::guid, std::size_t, rpg::guid_hash> expected{};
+  std::vector<rpg::guid> keys{};
+
+  for (std::size_t step = 0; step < 200'000; ++step) {
+    if (keys.empty() or random() % 3 != 0) {
+      const auto key = generator.generate();
+      keys.push_back(key);
+      std::ignore = map.try_emplace(key, step);
+      expected.emplace(key, step);
+    } else {
+      const auto index = random() % keys.size();
+      EXPECT_EQ(expected.erase(keys[index]) == 1, map.erase(keys[index]));
+      keys[index] = keys.back();
+      keys.pop_back();
+    }
+  }
+
+  EXPECT_EQ(expected.size(), map.size());
+  for (const auto &[key, value] : expected) {
+    ASSERT_NE(nullptr, map.find(key));
+    EXPECT_EQ(value, *map.find(key));
+  }
+  std::size_t visited = 0;
+  map.for_each([&](const rpg::guid &key, const std::size_t value) {
+    EXPECT_EQ(expected.at(key), value);
+    ++visited;
+  });
+  EXPECT_EQ(expected.size(), visited);
+}
+
+TEST(guid_map, clear_destroys_values) {
+  using rpg::operators::operator""_guid;
+  auto value = std::make_shared<int>(42);
+  rpg::guid_map<std::shared_ptr<int>> map{};
+  std::ignore = map.try_emplace("0000000000000001"_guid, value);
+  std::ignore = map.try_emplace("0000000000000002"_guid, value);
+  EXPECT_EQ(3, value.use_count());
+  map.clear();
+  EXPECT_EQ(1, value.use_count());
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(nullptr, map.find("0000000000000001"_guid));
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,137 @@
+#include <rpg/jobs/frame_graph.hpp>
+#include <rpg/jobs/thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+TEST(jobs_frame_graph, works_out_dependencies_from_reads_and_writes) {
+  rpg::jobs::frame_graph graph{};
+  const auto input = graph.add_resource("input");
+  const auto transforms = graph.add_resource("transforms");
+  const auto timers = graph.add_resource("timers");
+
+  const auto read_input = graph.add("input", {}, {input}, [] {});
+  const auto movement = graph.add("movement", {input}, {transforms}, [] {});
+  const auto scheduler = graph.add("scheduler", {}, {timers}, [] {});
+  const auto camera = graph.add("camera", {input, transforms}, {}, [] {});
+  const auto draw = graph.add("draw", {transforms, timers}, {}, [] {});
+
+  const auto dependents = [&](const std::size_t system) {
+    const auto span = graph.dependents(system);
+    return std::vector<std::size_t>{std::begin(span), std::end(span)};
+  };
+  EXPECT_EQ(dependents(read_input),
+            (std::vector<std::size_t>{movement, camera}));
+  EXPECT_EQ(dependents(movement), (std::vector<std::size_t>{camera, draw}));
+  EXPECT_EQ(dependents(scheduler), std::vector<std::size_t>{draw});
+  EXPECT_TRUE(dependents(camera).empty());
+  EXPECT_TRUE(dependents(draw).empty());
+  EXPECT_EQ(graph.name(scheduler), "scheduler");
+}
+
+TEST(jobs_frame_graph, writers_wait_for_earlier_readers) {
+  rpg::jobs::frame_graph graph{};
+  const auto state = graph.add_resource("state");
+  const auto reader = graph.add("reader", {state}, {}, [] {});
+  const auto writer = graph.add("writer", {}, {state}, [] {});
+  ASSERT_EQ(graph.dependents(reader).size(), 1);
+  EXPECT_EQ(graph.dependents(reader)[0], writer);
+}
+
+TEST(jobs_frame_graph, runs_systems_after_their_dependencies) {
+  rpg::jobs::thread_pool pool{4};
+  rpg::jobs::frame_graph graph{};
+  std::array<rpg::jobs::frame_resource, 4> resources{};
+  for (std::size_t i = 0; i < std::size(resources); ++i) {
+    resources[i] = graph.add_resource("resource " + std::to_string(i));
+  }
+
+  // A chain through resource 0 alongside systems that only share reads.
+  std::atomic<int> clock{0};
+  std::array<int, 6> started{};
+  std::array<int, 6> finished{};
+  const auto timed = [&](const std::size_t system) {
+    return [&, system] {
+      started[system] = clock++;
+      std::this_thread::yield();
+      finished[system] = clock++;
+    };
+  };
+  graph.add("a", {}, {resources[0]}, timed(0));
+  graph.add("b", {resources[1]}, {}, timed(1));
+  graph.add("c", {resources[0]}, {resources[2]}, timed(2));
+  graph.add("d", {resources[1]}, {}, timed(3));
+  graph.add("e", {resources[2]}, {resources[0]}, timed(4));
+  graph.add("f", {resources[3]}, {resources[3]}, timed(5));
+
+  for (auto frame = 0; frame < 200; ++frame) {
+    graph.run(pool);
+    EXPECT_LT(finished[0], started[2]);
+    EXPECT_LT(finished[2], started[4]);
+  }
+}
+
+TEST(jobs_frame_graph, runs_independent_systems_concurrently) {
+  rpg::jobs::thread_pool pool{2};
+  rpg::jobs::frame_graph graph{};
+  const auto left = graph.add_resource("left");
+  const auto right = graph.add_resource("right");
+
+  // Each system waits for the other to start, which can only happen if they
+  // run at the same time.
+  std::atomic<int> arrived{0};
+  std::atomic<int> met{0};
+  const auto meet = [&] {
+    ++arrived;
+    const auto give_up =
+        std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (arrived.load() < 2 and std::chrono::steady_clock::now() < give_up) {
+      std::this_thread::yield();
+    }
+    if (arrived.load() >= 2) {
+      ++met;
+    }
+  };
+  graph.add("movement", {}, {left}, meet);
+  graph.add("scheduler", {}, {right}, meet);
+  graph.run(pool);
+  EXPECT_EQ(met.load(), 2);
+}
+
+TEST(jobs_frame_graph, picks_up_systems_added_after_running) {
+  rpg::jobs::thread_pool pool{1};
+  rpg::jobs::frame_graph graph{};
+  const auto state = graph.add_resource("state");
+  std::vector<int> order{};
+  graph.add("first", {}, {state}, [&] { order.push_back(1); });
+  graph.run(pool);
+  graph.add("second", {}, {state}, [&] { order.push_back(2); });
+  graph.run(pool);
+  EXPECT_EQ(order, (std::vector<int>{1, 1, 2}));
+}
+
+TEST(jobs_frame_graph, rejects_too_many_resources) {
+  rpg::jobs::frame_graph graph{};
+  for (auto i = 0; i < 64; ++i) {
+    std::ignore = graph.add_resource(std::to_string(i));
+  }
+  EXPECT_THROW(std::ignore = graph.add_resource("one too many"),
+               std::runtime_error);
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,161 @@
+#include <rpg/jobs/thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <thread>
+#include <vector>
+
+TEST(jobs_thread_pool, runs_every_submitted_task) {
+  rpg::jobs::thread_pool pool{3};
+  std::atomic<int> ran{0};
+  std::deque<rpg::jobs::task> tasks(1000);
+  rpg::jobs::task_counter counter{};
+  for (auto &task : tasks) {
+    task.work = [&ran] { ++ran; };
+    pool.submit(task, counter);
+  }
+  pool.wait(counter);
+  EXPECT_TRUE(counter.finished());
+  EXPECT_EQ(ran.load(), 1000);
+}
+
+TEST(jobs_thread_pool, runs_on_the_waiting_thread_without_workers) {
+  rpg::jobs::thread_pool pool{0};
+  EXPECT_EQ(pool.concurrency(), 1);
+  const auto caller = std::this_thread::get_id();
+  std::thread::id ran_on{};
+  rpg::jobs::task task{.work = [&] { ran_on = std::this_thread::get_id(); }};
+  rpg::jobs::task_counter counter{};
+  pool.submit(task, counter);
+  pool.wait(counter);
+  EXPECT_EQ(ran_on, caller);
+}
+
+TEST(jobs_thread_pool, tasks_can_submit_and_wait_for_more_tasks) {
+  rpg::jobs::thread_pool pool{4};
+  constexpr std::size_t children = 16;
+  std::atomic<int> ran{0};
+  std::array<rpg::jobs::task, 8> parents{};
+  std::array<std::array<rpg::jobs::task, children>, 8> tasks{};
+  rpg::jobs::task_counter counter{};
+  for (std::size_t i = 0; i < std::size(parents); ++i) {
+    parents[i].work = [&, i] {
+      rpg::jobs::task_counter inner{};
+      for (auto &child : tasks[i]) {
+        child.work = [&ran] { ++ran; };
+        pool.submit(child, inner);
+      }
+      pool.wait(inner);
+      EXPECT_TRUE(inner.finished());
+    };
+    pool.submit(parents[i], counter);
+  }
+  pool.wait(counter);
+  EXPECT_EQ(ran.load(), std::size(parents) * children);
+}
+
+TEST(jobs_thread_pool, idle_threads_steal_from_busy_workers) {
+  rpg::jobs::thread_pool pool{2};
+  std::atomic<int> children_done{0};
+  std::atomic<bool> stolen{false};
+  std::array<rpg::jobs::task, 8> children{};
+  rpg::jobs::task parent{};
+  rpg::jobs::task_counter counter{};
+  parent.work = [&] {
+    const auto owner = std::this_thread::get_id();
+    rpg::jobs::task_counter inner{};
+    for (auto &child : children) {
+      child.work = [&, owner] {
+        if (std::this_thread::get_id() != owner) {
+          stolen = true;
+        }
+        ++children_done;
+      };
+      pool.submit(child, inner);
+    }
+    // Stay busy until some other thread has taken a child off this
+    // worker's deque.
+    while (children_done.load() == 0) {
+      std::this_thread::yield();
+    }
+    pool.wait(inner);
+  };
+  pool.submit(parent, counter);
+  pool.wait(counter);
+  EXPECT_TRUE(stolen.load());
+  EXPECT_EQ(children_done.load(), std::size(children));
+}
+
+TEST(jobs_thread_pool, can_be_destroyed_while_idle) {
+  for (auto i = 0; i < 20; ++i) {
+    rpg::jobs::thread_pool pool{4};
+  }
+}
+
+TEST(jobs_parallel_for, visits_every_index_exactly_once) {
+  rpg::jobs::thread_pool pool{3};
+  for (const std::size_t count : {0, 1, 7, 1000, 100'003}) {
+    for (const std::size_t grain : {1, 64, 4096, 1'000'000}) {
+      std::vector<std::atomic<int>> visits(count);
+      rpg::jobs::parallel_for(
+          pool, 0, count, grain,
+          [&](const std::size_t first, const std::size_t last) {
+            EXPECT_LE(last - first, grain);
+            for (auto i = first; i < last; ++i) {
+              ++visits[i];
+            }
+          });
+      EXPECT_TRUE(std::ranges::all_of(
+          visits, [](const auto &visited) { return visited.load() == 1; }))
+          << count << " indices, grain " << grain;
+    }
+  }
+}
+
+TEST(jobs_parallel_for, respects_the_range_bounds) {
+  rpg::jobs::thread_pool pool{2};
+  std::vector<int> values(100, 0);
+  rpg::jobs::parallel_for(pool, 10, 90, 7,
+                          [&](const std::size_t first, const std::size_t last) {
+                            for (auto i = first; i < last; ++i) {
+                              values[i] = 1;
+                            }
+                          });
+  for (std::size_t i = 0; i < std::size(values); ++i) {
+    EXPECT_EQ(values[i], i >= 10 and i < 90 ? 1 : 0) << "index " << i;
+  }
+}
+
+TEST(jobs_parallel_for, can_be_nested) {
+  rpg::jobs::thread_pool pool{4};
+  constexpr std::size_t rows = 32;
+  constexpr std::size_t columns = 256;
+  std::vector<int> cells(rows * columns, 0);
+  rpg::jobs::parallel_for(
+      pool, 0, rows, 1, [&](const std::size_t first, const std::size_t last) {
+        for (auto row = first; row < last; ++row) {
+          rpg::jobs::parallel_for(
+              pool, 0, columns, 16,
+              [&, row](const std::size_t begin, const std::size_t end) {
+                for (auto column = begin; column < end; ++column) {
+                  cells[row * columns + column] += 1;
+                }
+              });
+        }
+      });
+  EXPECT_TRUE(std::ranges::all_of(cells, [](const int cell) {
+    return cell == 1;
+  }));
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
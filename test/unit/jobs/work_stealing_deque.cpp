@@ -0,0 +1,86 @@
+#include <rpg/jobs/work_stealing_deque.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <thread>
+#include <vector>
+
+TEST(jobs_work_stealing_deque, owner_takes_newest_thieves_take_oldest) {
+  rpg::jobs::work_stealing_deque<int> deque{};
+  for (auto i = 0; i < 4; ++i) {
+    deque.push(i);
+  }
+  EXPECT_EQ(deque.size(), 4);
+  EXPECT_EQ(deque.take(), 3);
+  EXPECT_EQ(deque.steal(), 0);
+  EXPECT_EQ(deque.take(), 2);
+  EXPECT_EQ(deque.steal(), 1);
+  EXPECT_EQ(deque.take(), std::nullopt);
+  EXPECT_EQ(deque.steal(), std::nullopt);
+  EXPECT_TRUE(deque.empty());
+}
+
+TEST(jobs_work_stealing_deque, grows_without_losing_items) {
+  rpg::jobs::work_stealing_deque<int> deque{2};
+  for (auto i = 0; i < 100; ++i) {
+    deque.push(i);
+  }
+  EXPECT_GE(deque.capacity(), 100);
+  EXPECT_EQ(deque.steal(), 0);
+  for (auto i = 99; i > 0; --i) {
+    EXPECT_EQ(deque.take(), i);
+  }
+  EXPECT_TRUE(deque.empty());
+}
+
+TEST(jobs_work_stealing_deque, every_item_is_taken_exactly_once) {
+  constexpr auto item_count = 100'000;
+  constexpr auto thief_count = 3;
+  rpg::jobs::work_stealing_deque<int> deque{16};
+  std::vector<std::atomic<int>> seen(item_count);
+  std::atomic<bool> done{false};
+
+  std::vector<std::jthread> thieves{};
+  for (auto i = 0; i < thief_count; ++i) {
+    thieves.emplace_back([&] {
+      while (not done.load()) {
+        if (const auto item = deque.steal()) {
+          ++seen[static_cast<std::size_t>(*item)];
+        }
+      }
+    });
+  }
+
+  // Keep a few items in the deque at a time so the owner and the thieves
+  // keep racing for the last one.
+  for (auto i = 0; i < item_count; ++i) {
+    deque.push(i);
+    if (i % 3 == 0) {
+      if (const auto item = deque.take()) {
+        ++seen[static_cast<std::size_t>(*item)];
+      }
+    }
+  }
+  while (const auto item = deque.take()) {
+    ++seen[static_cast<std::size_t>(*item)];
+  }
+  while (not deque.empty()) {
+    std::this_thread::yield();
+  }
+  done = true;
+  thieves.clear();
+
+  for (auto i = 0; i < item_count; ++i) {
+    ASSERT_EQ(seen[static_cast<std::size_t>(i)].load(), 1) << "item " << i;
+  }
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,192 @@
+#include <rpg/math.hpp>
+#include <rpg/math/batch.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr auto error_bound = 2.4e-7;
+
+// Every kernel set this machine can run.
+[[nodiscard]] auto available_isas() {
+  std::vector<rpg::math::batch::isa> isas{rpg::math::batch::isa::scalar};
+  const auto best = rpg::math::batch::detect_isa();
+  if (best == rpg::math::batch::isa::sse2 or
+      best == rpg::math::batch::isa::avx2) {
+    isas.push_back(rpg::math::batch::isa::sse2);
+  }
+  if (best == rpg::math::batch::isa::avx2) {
+    isas.push_back(rpg::math::batch::isa::avx2);
+  }
+  return isas;
+}
+
+[[nodiscard]] std::string name(const rpg::math::batch::isa isa) {
+  switch (isa) {
+  case rpg::math::batch::isa::scalar:
+    return "scalar";
+  case rpg::math::batch::isa::sse2:
+    return "sse2";
+  case rpg::math::batch::isa::avx2:
+    return "avx2";
+  }
+  return "unknown";
+}
+
+// A mix of random angles and the multiples of 45 degrees where snapping and
+// quadrant boundaries matter. The odd count exercises the scalar tails.
+[[nodiscard]] auto test_angles() {
+  std::vector<float> degrees{};
+  for (auto angle = -1080; angle <= 1080; angle += 45) {
+    degrees.push_back(static_cast<float>(angle));
+  }
+  std::mt19937 random{42};
+  std::uniform_real_distribution<float> angles{-100'000.0f, 100'000.0f};
+  std::uniform_real_distribution<float> rotations{0.0f, 360.0f};
+  for (auto i = 0; i < 10'001; ++i) {
+    degrees.push_back(i % 2 == 0 ? rotations(random) : angles(random));
+  }
+  return degrees;
+}
+} // namespace
+
+TEST(math_batch, rotate_vector_is_within_error_bound) {
+  const auto degrees = test_angles();
+  std::vector<float> x(std::size(degrees));
+  std::vector<float> y(std::size(degrees));
+  for (const auto isa : available_isas()) {
+    rpg::math::batch::kernels_for(isa).rotate_vector(
+        std::data(degrees), std::data(x), std::data(y), std::size(degrees));
+    for (std::size_t i = 0; i < std::size(degrees); ++i) {
+      const auto radians = static_cast<double>(degrees[i]) *
+                           std::numbers::pi_v<double> / 180.0;
+      // Snapping may zero a component up to float epsilon away from zero.
+      const auto tolerance =
+          std::abs(std::cos(radians)) <= 1.2e-7 or
+                  std::abs(std::sin(radians)) <= 1.2e-7
+              ? 1.2e-7 + error_bound
+              : error_bound;
+      ASSERT_NEAR(std::cos(radians), x[i], tolerance)
+          << name(isa) << " " << degrees[i];
+      ASSERT_NEAR(std::sin(radians), y[i], tolerance)
+          << name(isa) << " " << degrees[i];
+    }
+  }
+}
+
+TEST(math_batch, rotate_vector_matches_scalar_math) {
+  const auto degrees = test_angles();
+  std::vector<float> x(std::size(degrees));
+  std::vector<float> y(std::size(degrees));
+  rpg::math::batch::rotate_vector(degrees, x, y);
+  for (std::size_t i = 0; i < std::size(degrees); ++i) {
+    if (std::abs(degrees[i]) > 1080.0f) {
+      continue;
+    }
+    // math::rotate_vector rounds the angle to float radians before calling
+    // std::cos/std::sin, which is off by up to half an ulp of the radians, and
+    // snaps anything within epsilon of zero.
+    const auto radians = std::abs(rpg::math::degrees_to_radians(degrees[i]));
+    const auto tolerance =
+        error_bound + radians * std::numeric_limits<float>::epsilon() / 2 +
+        std::numeric_limits<float>::epsilon();
+    const auto expected = rpg::math::rotate_vector(degrees[i]);
+    EXPECT_NEAR(expected.x, x[i], tolerance) << degrees[i];
+    EXPECT_NEAR(expected.y, y[i], tolerance) << degrees[i];
+  }
+}
+
+TEST(math_batch, rotate_vector_is_exact_at_right_angles) {
+  std::vector<float> degrees{};
+  for (auto angle = -720; angle <= 720; angle += 90) {
+    degrees.push_back(static_cast<float>(angle));
+  }
+  for (const auto isa : available_isas()) {
+    std::vector<float> x(std::size(degrees));
+    std::vector<float> y(std::size(degrees));
+    rpg::math::batch::kernels_for(isa).rotate_vector(
+        std::data(degrees), std::data(x), std::data(y), std::size(degrees));
+    for (std::size_t i = 0; i < std::size(degrees); ++i) {
+      const auto radians = static_cast<double>(degrees[i]) *
+                           std::numbers::pi_v<double> / 180.0;
+      EXPECT_EQ(std::round(std::cos(radians)), x[i])
+          << name(isa) << " " << degrees[i];
+      EXPECT_EQ(std::round(std::sin(radians)), y[i])
+          << name(isa) << " " << degrees[i];
+    }
+  }
+}
+
+TEST(math_batch, left_and_right_match_scalar_math) {
+  std::mt19937 random{42};
+  std::uniform_real_distribution<float> values{-1.0f, 1.0f};
+  std::vector<float> x(1001);
+  std::vector<float> y(1001);
+  for (std::size_t i = 0; i < std::size(x); ++i) {
+    x[i] = values(random);
+    y[i] = values(random);
+  }
+
+  for (const auto isa : available_isas()) {
+    const auto &kernels = rpg::math::batch::kernels_for(isa);
+    std::vector<float> left_x(std::size(x));
+    std::vector<float> left_y(std::size(x));
+    std::vector<float> right_x(std::size(x));
+    std::vector<float> right_y(std::size(x));
+    kernels.left(std::data(x), std::data(y), std::data(left_x),
+                 std::data(left_y), std::size(x));
+    kernels.right(std::data(x), std::data(y), std::data(right_x),
+                  std::data(right_y), std::size(x));
+    for (std::size_t i = 0; i < std::size(x); ++i) {
+      const auto left = rpg::math::left(sf::Vector2f{x[i], y[i]});
+      const auto right = rpg::math::right(sf::Vector2f{x[i], y[i]});
+      ASSERT_EQ(left.x, left_x[i]) << name(isa);
+      ASSERT_EQ(left.y, left_y[i]) << name(isa);
+      ASSERT_EQ(right.x, right_x[i]) << name(isa);
+      ASSERT_EQ(right.y, right_y[i]) << name(isa);
+    }
+  }
+}
+
+TEST(math_batch, left_and_right_can_work_in_place) {
+  std::vector<float> x{1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+  std::vector<float> y{6.0f, 7.0f, 8.0f, 9.0f, 10.0f};
+  rpg::math::batch::left(x, y, x, y);
+  EXPECT_EQ((std::vector{6.0f, 7.0f, 8.0f, 9.0f, 10.0f}), x);
+  EXPECT_EQ((std::vector{-1.0f, -2.0f, -3.0f, -4.0f, -5.0f}), y);
+  rpg::math::batch::right(x, y, x, y);
+  EXPECT_EQ((std::vector{1.0f, 2.0f, 3.0f, 4.0f, 5.0f}), x);
+  EXPECT_EQ((std::vector{6.0f, 7.0f, 8.0f, 9.0f, 10.0f}), y);
+}
+
+TEST(math_batch, degree_conversion_matches_scalar_math) {
+  std::vector<float> degrees(1001);
+  for (std::size_t i = 0; i < std::size(degrees); ++i) {
+    degrees[i] = static_cast<float>(i) * 0.36f - 180.0f;
+  }
+  std::vector<float> radians(std::size(degrees));
+  std::vector<float> back(std::size(degrees));
+  rpg::math::batch::degrees_to_radians(degrees, radians);
+  rpg::math::batch::radians_to_degrees(radians, back);
+  for (std::size_t i = 0; i < std::size(degrees); ++i) {
+    EXPECT_FLOAT_EQ(
+        static_cast<float>(rpg::math::degrees_to_radians(degrees[i])),
+        radians[i]);
+    EXPECT_NEAR(degrees[i], back[i], 3e-5);
+  }
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,130 @@
+#include <rpg/action.hpp>
+#include <rpg/controllers/movement.hpp>
+#include <rpg/math.hpp>
+#include <rpg/math/trig.hpp>
+#include <rpg/window/key_position.hpp>
+#include <rpg/window/key_state.hpp>
+
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/Window/Keyboard.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+// The tables are built at compile time.
+static_assert(rpg::math::sincos_table<256>::sample(0) == 0.0f);
+static_assert(rpg::math::sincos_table<256>::sample(64) == 1.0f);
+static_assert(rpg::math::sincos_table<256>::sample(128) == 0.0f);
+static_assert(rpg::math::sincos_table<256>::sample(192) == -1.0f);
+
+namespace {
+template <class TTable> class math_sincos_table : public testing::Test {};
+
+using table_sizes =
+    testing::Types<rpg::math::sincos_table<16>, rpg::math::sincos_table<64>,
+                   rpg::math::sincos_table<256>, rpg::math::sincos_table<1024>,
+                   rpg::math::sincos_table<4096>>;
+
+// Reports the rotate right key as down.
+struct rotate_right_input {
+  [[nodiscard]] rpg::window::key_state
+  get_key_state(const sf::Keyboard::Key key) const {
+    return {.position = key == sf::Keyboard::Key::E
+                            ? rpg::window::key_position::down
+                            : rpg::window::key_position::up,
+            .seconds_in_current_position = 0};
+  }
+
+  void subscribe(const sf::Keyboard::Key) {}
+  void unsubscribe(const sf::Keyboard::Key) {}
+};
+
+struct speed {
+  [[nodiscard]] float frontal_movement() const noexcept { return 10.0f; }
+  [[nodiscard]] float backward_movement() const noexcept { return 10.0f; }
+  [[nodiscard]] float lateral_movement() const noexcept { return 10.0f; }
+  [[nodiscard]] float rotational_movement() const noexcept { return 37.0f; }
+};
+} // namespace
+
+TYPED_TEST_SUITE(math_sincos_table, table_sizes);
+
+TYPED_TEST(math_sincos_table, is_within_max_error) {
+  auto max_error = 0.0;
+  // Ten samples between each pair of entries, over more than one turn in
+  // both directions.
+  const auto step = 36.0f / TypeParam::resolution;
+  for (auto degrees = -720.0f; degrees <= 720.0f; degrees += step) {
+    const auto radians = static_cast<double>(degrees) *
+                         std::numbers::pi_v<double> / 180.0;
+    const auto direction = TypeParam::rotate_vector(degrees);
+    max_error =
+        std::max({max_error, std::abs(std::cos(radians) - direction.x),
+                  std::abs(std::sin(radians) - direction.y)});
+  }
+  EXPECT_LE(max_error, TypeParam::max_error);
+  // The bound is meant to be tight, not just safe.
+  EXPECT_GE(max_error, TypeParam::max_error / 4);
+}
+
+TYPED_TEST(math_sincos_table, is_exact_at_right_angles) {
+  for (auto degrees = -720; degrees <= 720; degrees += 90) {
+    const auto radians = degrees * std::numbers::pi_v<double> / 180.0;
+    const auto direction =
+        TypeParam::rotate_vector(static_cast<float>(degrees));
+    EXPECT_EQ(std::round(std::cos(radians)), direction.x) << degrees;
+    EXPECT_EQ(std::round(std::sin(radians)), direction.y) << degrees;
+  }
+}
+
+TYPED_TEST(math_sincos_table, handles_large_angles) {
+  for (const auto degrees : {-100'000.5f, 100'000.5f, 1'000'000.0f}) {
+    const auto radians = static_cast<double>(degrees) *
+                         std::numbers::pi_v<double> / 180.0;
+    const auto direction = TypeParam::rotate_vector(degrees);
+    EXPECT_NEAR(std::cos(radians), direction.x, TypeParam::max_error);
+    EXPECT_NEAR(std::sin(radians), direction.y, TypeParam::max_error);
+  }
+}
+
+TEST(math_std_trig, matches_rotate_vector) {
+  for (auto degrees = -720.0f; degrees <= 720.0f; degrees += 0.5f) {
+    EXPECT_EQ(rpg::math::rotate_vector(degrees),
+              rpg::math::std_trig::rotate_vector(degrees));
+  }
+}
+
+TEST(math_sincos_table, can_drive_movement_controller) {
+  using table = rpg::math::sincos_table<1024>;
+  rotate_right_input input{};
+  speed speeds{};
+  sf::Transformable transformable{};
+  rpg::controllers::movement<rotate_right_input, speed, table> movement{
+      input, speeds};
+  movement.map_action(rpg::action::rotate_right, sf::Keyboard::Key::E);
+  movement.attach(transformable);
+  movement.update(sf::seconds(1.0f));
+  EXPECT_EQ(37.0f, transformable.getRotation());
+
+  // The controller now faces the table's direction for 37 degrees, which
+  // moving forward shows.
+  movement.map_action(rpg::action::rotate_right, sf::Keyboard::Key::Unknown);
+  movement.map_action(rpg::action::move_forward, sf::Keyboard::Key::E);
+  movement.update(sf::seconds(1.0f));
+  const auto direction = table::rotate_vector(37.0f);
+  EXPECT_EQ(direction * 10.0f, transformable.getPosition());
+  EXPECT_NEAR(std::cos(37.0 * std::numbers::pi_v<double> / 180.0),
+              direction.x, table::max_error);
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
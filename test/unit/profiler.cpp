@@ -0,0 +1,199 @@
+#define RPG_PROFILE 1
+#include <rpg/profiler.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <latch>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+// Every test records into the one profiler, so each clears it first.
+auto recorded_zones() {
+  std::vector<rpg::profile_zone> zones{};
+  rpg::profiler::instance().collect(zones);
+  return zones;
+}
+} // namespace
+
+TEST(profiler, scopes_record_nested_zones) {
+  auto &profiler = rpg::profiler::instance();
+  profiler.clear();
+  {
+    RPG_PROFILE_ZONE("outer");
+    {
+      RPG_PROFILE_ZONE("inner");
+      std::this_thread::sleep_for(std::chrono::microseconds{100});
+    }
+  }
+  const auto zones = recorded_zones();
+  ASSERT_EQ(std::size(zones), 2);
+  // Zones are in the order they ended.
+  EXPECT_EQ(std::string_view{zones[0].name}, "inner");
+  EXPECT_EQ(zones[0].depth, 1);
+  EXPECT_EQ(std::string_view{zones[1].name}, "outer");
+  EXPECT_EQ(zones[1].depth, 0);
+  EXPECT_EQ(zones[0].thread, zones[1].thread);
+  EXPECT_LE(zones[1].begin, zones[0].begin);
+  EXPECT_LE(zones[0].end, zones[1].end);
+  EXPECT_GE(zones[0].end - zones[0].begin, 50'000);
+}
+
+TEST(profiler, threads_record_into_their_own_lanes) {
+  auto &profiler = rpg::profiler::instance();
+  profiler.clear();
+  constexpr auto thread_count = 4;
+  constexpr auto zone_count = 1000;
+  // Kept alive until all have recorded, since an exited thread's ring goes
+  // to the next thread.
+  std::latch recorded{thread_count};
+  std::vector<std::thread> threads{};
+  for (auto i = 0; i < thread_count; ++i) {
+    threads.emplace_back([i, &recorded] {
+      RPG_PROFILE_THREAD("worker " + std::to_string(i));
+      for (auto zone = 0; zone < zone_count; ++zone) {
+        RPG_PROFILE_ZONE("work");
+      }
+      recorded.arrive_and_wait();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  const auto zones = recorded_zones();
+  ASSERT_EQ(std::size(zones), thread_count * zone_count);
+  std::set<std::uint32_t> lanes{};
+  for (const auto &zone : zones) {
+    lanes.insert(zone.thread);
+    EXPECT_EQ(zone.depth, 0);
+  }
+  ASSERT_EQ(std::size(lanes), thread_count);
+  std::set<std::string> names{};
+  for (const auto lane : lanes) {
+    names.insert(profiler.thread_name(lane));
+  }
+  EXPECT_EQ(names, (std::set<std::string>{"worker 0", "worker 1", "worker 2",
+                                          "worker 3"}));
+}
+
+TEST(profiler, exited_threads_hand_their_ring_on) {
+  auto &profiler = rpg::profiler::instance();
+  profiler.clear();
+  const auto record_on_a_thread = [] {
+    std::thread{[] {
+      RPG_PROFILE_THREAD("short lived");
+      RPG_PROFILE_ZONE("work");
+    }}.join();
+  };
+  record_on_a_thread();
+  const auto rings = profiler.thread_count();
+  for (auto i = 0; i < 100; ++i) {
+    record_on_a_thread();
+  }
+  EXPECT_EQ(profiler.thread_count(), rings);
+  // Only the last thread's zone is left; the others were cleared with the
+  // ring handed on.
+  const auto zones = recorded_zones();
+  ASSERT_EQ(std::size(zones), 1);
+  EXPECT_EQ(profiler.thread_name(zones[0].thread), "short lived");
+}
+
+TEST(profiler, rings_keep_the_most_recent_zones) {
+  auto &profiler = rpg::profiler::instance();
+  profiler.clear();
+  static constexpr const char *names[] = {"even", "odd"};
+  const auto extra = 10;
+  for (std::size_t i = 0; i < rpg::profiler::ring_size + extra; ++i) {
+    const auto now = rpg::profile_clock::now();
+    profiler.record(names[i % 2], now, now, static_cast<std::uint32_t>(i));
+  }
+  const auto zones = recorded_zones();
+  ASSERT_EQ(std::size(zones), rpg::profiler::ring_size - 1);
+  EXPECT_EQ(zones.front().depth, extra + 1);
+  EXPECT_EQ(zones.back().depth, rpg::profiler::ring_size + extra - 1);
+}
+
+TEST(profiler, collect_while_threads_record) {
+  auto &profiler = rpg::profiler::instance();
+  profiler.clear();
+  std::atomic<bool> done{false};
+  std::thread recording{[&done] {
+    while (not done.load()) {
+      RPG_PROFILE_ZONE("busy");
+    }
+  }};
+  std::vector<rpg::profile_zone> zones{};
+  for (auto pass = 0; pass < 100; ++pass) {
+    zones.clear();
+    profiler.collect(zones);
+    for (const auto &zone : zones) {
+      ASSERT_EQ(std::string_view{zone.name}, "busy");
+      ASSERT_LE(zone.begin, zone.end);
+    }
+  }
+  done.store(true);
+  recording.join();
+}
+
+TEST(profiler, collect_skips_zones_that_ended_before_since) {
+  auto &profiler = rpg::profiler::instance();
+  profiler.clear();
+  { RPG_PROFILE_ZONE("before"); }
+  std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  const auto since = profiler.now();
+  { RPG_PROFILE_ZONE("after"); }
+
+  std::vector<rpg::profile_zone> zones{};
+  profiler.collect(zones, since);
+  ASSERT_EQ(std::size(zones), 1);
+  EXPECT_EQ(std::string_view{zones[0].name}, "after");
+}
+
+TEST(profiler, frames_are_remembered) {
+  auto &profiler = rpg::profiler::instance();
+  const auto frames = profiler.frame_count();
+  RPG_PROFILE_FRAME();
+  const auto first = profiler.frame_start(0);
+  std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  RPG_PROFILE_FRAME();
+  EXPECT_EQ(profiler.frame_count(), frames + 2);
+  EXPECT_EQ(profiler.frame_start(1), first);
+  EXPECT_GT(profiler.frame_start(0), first);
+  EXPECT_EQ(profiler.frame_start(rpg::profiler::frame_history), 0);
+}
+
+TEST(profiler, chrome_trace_lists_threads_and_zones) {
+  auto &profiler = rpg::profiler::instance();
+  profiler.clear();
+  RPG_PROFILE_THREAD("main \"thread\"");
+  { RPG_PROFILE_ZONE("traced"); }
+
+  std::ostringstream trace{};
+  profiler.write_chrome_trace(trace);
+  const auto json = trace.str();
+  EXPECT_TRUE(
+      json.starts_with("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_TRUE(json.ends_with("]}\n"));
+  EXPECT_NE(json.find("\"args\":{\"name\":\"main \\\"thread\\\"\"}"),
+            std::string::npos);
+  EXPECT_NE(json.find("{\"ph\":\"X\",\"name\":\"traced\",\"pid\":0"),
+            std::string::npos);
+  EXPECT_EQ(std::ranges::count(json, '{'), std::ranges::count(json, '}'));
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
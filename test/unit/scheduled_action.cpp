@@ -1,5 +1,8 @@
+#include <rpg/inplace_function.hpp>
 #include <rpg/operators/guid.hpp>
 #include <rpg/scheduled_action.hpp>
+#include <rpg/slab_pool.hpp>
+#include <rpg/test/allocations.hpp>
 #include <rpg/test/mocks/guid.hpp>
 
 #include <SFML/System/Clock.hpp>
@@ -7,7 +10,27 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <array>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+struct sequential_guid {
+  std::uint64_t next{0};
+
+  [[nodiscard]] rpg::guid generate() noexcept {
+    rpg::guid guid{};
+    ++next;
+    std::memcpy(std::data(guid), &next, sizeof(next));
+    return guid;
+  }
+};
+
+using type_erased_action =
+    rpg::scheduled_action<rpg::inplace_function<void()>>;
+} // namespace
 
 TEST(scheduled_action, scheduled_actions_have_unique_guid) {
   using rpg::operators::operator""_guid;
@@ -94,6 +117,68 @@ TEST(scheduled_action, resume_scheduled_actions) {
   EXPECT_EQ(42, x);
 }
 
+TEST(scheduled_action, type_erased_action_does_not_allocate) {
+  sequential_guid guid{};
+  auto x = 0;
+  auto y = 0;
+  const auto allocations = rpg::test::allocations::count();
+  type_erased_action action(guid, std::chrono::seconds{1}, [&x, &y] {
+    x = 42;
+    y = 7;
+  });
+  action.update(sf::seconds(0.5f));
+  action.update(sf::seconds(0.5f));
+  EXPECT_EQ(allocations, rpg::test::allocations::count());
+  EXPECT_EQ(42, x);
+  EXPECT_EQ(7, y);
+}
+
+TEST(scheduled_action, heterogeneous_actions_in_slab_pool_do_not_allocate) {
+  constexpr auto action_count = 4096;
+  sequential_guid guid{};
+  rpg::slab_pool<type_erased_action> pool{};
+  pool.reserve(action_count);
+  std::vector<type_erased_action *> actions{};
+  actions.reserve(action_count);
+  std::int64_t sum = 0;
+  std::array<std::int64_t, 4> payload{1, 2, 3, 4};
+
+  const auto allocations = rpg::test::allocations::count();
+  for (auto i = 0; i < action_count; ++i) {
+    if (i % 2 == 0) {
+      actions.push_back(pool.create(guid, std::chrono::seconds{1},
+                                    [&sum, i] { sum += i; }));
+    } else {
+      actions.push_back(pool.create(guid, std::chrono::seconds{1},
+                                    [&sum, payload] { sum += payload[3]; }));
+    }
+  }
+  for (auto *action : actions) {
+    action->update(sf::seconds(1.0f));
+  }
+  for (auto *action : actions) {
+    pool.destroy(action);
+  }
+  EXPECT_EQ(allocations, rpg::test::allocations::count());
+  EXPECT_EQ(0, pool.size());
+  EXPECT_EQ(action_count / 2 * (action_count - 2) / 2 + action_count / 2 * 4,
+            sum);
+}
+
+TEST(scheduled_action, slab_pool_recycles_released_slots) {
+  sequential_guid guid{};
+  rpg::slab_pool<type_erased_action, 8> pool{};
+  auto *first = pool.create(guid, std::chrono::seconds{1}, [] {});
+  pool.destroy(first);
+  const auto allocations = rpg::test::allocations::count();
+  auto *second = pool.create(guid, std::chrono::seconds{1}, [] {});
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(1, pool.size());
+  EXPECT_EQ(8, pool.capacity());
+  pool.destroy(second);
+  EXPECT_EQ(allocations, rpg::test::allocations::count());
+}
+
 #if defined(RPG_OS_IS_WINDOWS)
 
 int main(int argc, char** argv)
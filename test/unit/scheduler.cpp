@@ -0,0 +1,167 @@
+#include <rpg/guid_generator.hpp>
+#include <rpg/operators/guid.hpp>
+#include <rpg/scheduler.hpp>
+
+#include <rpg/test/allocations.hpp>
+#include <rpg/test/mocks/guid.hpp>
+
+#include <SFML/System/Time.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+TEST(scheduler, schedule_returns_generated_guid) {
+  using rpg::operators::operator""_guid;
+  rpg::test::mocks::guid guid{};
+  EXPECT_CALL(guid, generate())
+      .Times(1)
+      .WillOnce(::testing::Return("0000000000000001"_guid));
+  rpg::scheduler scheduler{guid};
+  const auto id = scheduler.schedule(std::chrono::seconds{1}, [] {});
+  EXPECT_EQ("0000000000000001"_guid, id);
+  EXPECT_TRUE(scheduler.contains(id));
+  EXPECT_EQ(1, scheduler.size());
+}
+
+TEST(scheduler, do_thing_at_end_of_time) {
+  using rpg::operators::operator""_guid;
+  rpg::test::mocks::guid guid{};
+  EXPECT_CALL(guid, generate())
+      .Times(1)
+      .WillOnce(::testing::Return("0000000000000001"_guid));
+  rpg::scheduler scheduler{guid};
+  auto x = 0;
+  const auto id = scheduler.schedule(std::chrono::seconds{1}, [&] { x = 42; });
+  scheduler.update(sf::seconds(0.5f));
+  EXPECT_EQ(0, x);
+  scheduler.update(sf::seconds(0.5f));
+  EXPECT_EQ(42, x);
+  EXPECT_FALSE(scheduler.contains(id));
+  x = 10;
+  scheduler.update(sf::seconds(2.0f));
+  EXPECT_EQ(10, x);
+}
+
+TEST(scheduler, can_cancel_scheduled_action) {
+  using rpg::operators::operator""_guid;
+  rpg::test::mocks::guid guid{};
+  EXPECT_CALL(guid, generate())
+      .Times(1)
+      .WillOnce(::testing::Return("0000000000000001"_guid));
+  rpg::scheduler scheduler{guid};
+  auto x = 0;
+  const auto id = scheduler.schedule(std::chrono::seconds{1}, [&] { x = 42; });
+  scheduler.update(sf::seconds(0.5f));
+  scheduler.cancel(id);
+  EXPECT_FALSE(scheduler.contains(id));
+  scheduler.update(sf::seconds(0.5f));
+  EXPECT_EQ(0, x);
+}
+
+TEST(scheduler, can_pause_and_resume_scheduled_action) {
+  using rpg::operators::operator""_guid;
+  rpg::test::mocks::guid guid{};
+  EXPECT_CALL(guid, generate())
+      .Times(1)
+      .WillOnce(::testing::Return("0000000000000001"_guid));
+  rpg::scheduler scheduler{guid};
+  auto x = 0;
+  const auto id = scheduler.schedule(std::chrono::seconds{1}, [&] { x = 42; });
+  scheduler.update(sf::seconds(0.5f));
+  scheduler.pause(id);
+  EXPECT_TRUE(scheduler.is_paused(id));
+  scheduler.update(sf::seconds(10.0f));
+  EXPECT_EQ(0, x);
+  scheduler.resume(id);
+  EXPECT_FALSE(scheduler.is_paused(id));
+  scheduler.update(sf::seconds(0.25f));
+  EXPECT_EQ(0, x);
+  scheduler.update(sf::seconds(0.25f));
+  EXPECT_EQ(42, x);
+}
+
+TEST(scheduler, fires_actions_in_order_across_wheel_levels) {
+  using rpg::operators::operator""_guid;
+  rpg::test::mocks::guid guid{};
+  EXPECT_CALL(guid, generate())
+      .Times(4)
+      .WillOnce(::testing::Return("0000000000000001"_guid))
+      .WillOnce(::testing::Return("0000000000000002"_guid))
+      .WillOnce(::testing::Return("0000000000000003"_guid))
+      .WillOnce(::testing::Return("0000000000000004"_guid));
+  rpg::scheduler scheduler{guid};
+  std::vector<int> fired{};
+  std::ignore = scheduler.schedule(std::chrono::hours{30},
+                                   [&] { fired.push_back(4); });
+  std::ignore = scheduler.schedule(std::chrono::minutes{2},
+                                   [&] { fired.push_back(3); });
+  std::ignore = scheduler.schedule(std::chrono::milliseconds{300},
+                                   [&] { fired.push_back(2); });
+  std::ignore = scheduler.schedule(std::chrono::milliseconds{10},
+                                   [&] { fired.push_back(1); });
+
+  scheduler.update(sf::seconds(1.0f));
+  EXPECT_EQ((std::vector{1, 2}), fired);
+  scheduler.update(sf::seconds(119.0f));
+  EXPECT_EQ((std::vector{1, 2, 3}), fired);
+  for (auto hour = 0; hour < 29; ++hour) {
+    scheduler.update(sf::seconds(3600.0f));
+  }
+  EXPECT_EQ((std::vector{1, 2, 3}), fired);
+  scheduler.update(sf::seconds(3600.0f));
+  EXPECT_EQ((std::vector{1, 2, 3, 4}), fired);
+  EXPECT_EQ(0, scheduler.size());
+}
+
+TEST(scheduler, actions_can_schedule_more_actions) {
+  using rpg::operators::operator""_guid;
+  rpg::test::mocks::guid guid{};
+  EXPECT_CALL(guid, generate())
+      .Times(2)
+      .WillOnce(::testing::Return("0000000000000001"_guid))
+      .WillOnce(::testing::Return("0000000000000002"_guid));
+  rpg::scheduler scheduler{guid};
+  auto x = 0;
+  std::ignore = scheduler.schedule(std::chrono::seconds{1}, [&] {
+    x = 1;
+    std::ignore =
+        scheduler.schedule(std::chrono::seconds{1}, [&] { x = 2; });
+  });
+  scheduler.update(sf::seconds(1.0f));
+  EXPECT_EQ(1, x);
+  scheduler.update(sf::seconds(0.5f));
+  EXPECT_EQ(1, x);
+  scheduler.update(sf::seconds(0.5f));
+  EXPECT_EQ(2, x);
+}
+
+TEST(scheduler, scheduling_and_firing_reserved_actions_does_not_allocate) {
+  constexpr auto action_count = 10'000;
+  rpg::guid_generator guid{};
+  std::ignore = guid.generate();
+  rpg::scheduler scheduler{guid};
+  scheduler.reserve(action_count);
+  auto fired = 0;
+
+  const auto allocations = rpg::test::allocations::count();
+  for (auto frame = 0; frame < 3; ++frame) {
+    for (auto i = 0; i < action_count; ++i) {
+      std::ignore = scheduler.schedule(std::chrono::milliseconds{i % 100},
+                                       [&fired] { ++fired; });
+    }
+    scheduler.update(sf::seconds(1.0f));
+  }
+  EXPECT_EQ(allocations, rpg::test::allocations::count());
+  EXPECT_EQ(3 * action_count, fired);
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
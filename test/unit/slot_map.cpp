@@ -0,0 +1,109 @@
+#include <rpg/slot_map.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <vector>
+
+TEST(slot_map, inserted_values_are_found_by_handle) {
+  rpg::slot_map<std::string> names{};
+  const auto first = names.insert("first");
+  const auto second = names.insert(3, 'x');
+  EXPECT_EQ(names.size(), 2);
+  EXPECT_NE(first, second);
+  EXPECT_TRUE(names.contains(first));
+  EXPECT_EQ(names.get(first), "first");
+  EXPECT_EQ(names.get(second), "xxx");
+  EXPECT_FALSE(names.contains(rpg::null_slot_handle));
+}
+
+TEST(slot_map, erased_handles_go_stale) {
+  rpg::slot_map<int> numbers{};
+  const auto handle = numbers.insert(1);
+  EXPECT_TRUE(numbers.erase(handle));
+  EXPECT_FALSE(numbers.contains(handle));
+  EXPECT_EQ(numbers.try_get(handle), nullptr);
+  EXPECT_FALSE(numbers.erase(handle));
+
+  // The slot is reused, but the old handle still does not match it.
+  const auto reused = numbers.insert(2);
+  EXPECT_EQ(reused.index, handle.index);
+  EXPECT_NE(reused.generation, handle.generation);
+  EXPECT_FALSE(numbers.contains(handle));
+  EXPECT_EQ(numbers.get(reused), 2);
+}
+
+TEST(slot_map, handles_survive_values_moving) {
+  rpg::slot_map<std::unique_ptr<int>> numbers{};
+  std::vector<rpg::slot_handle> handles{};
+  for (auto i = 0; i < 1000; ++i) {
+    handles.push_back(numbers.insert(std::make_unique<int>(i)));
+  }
+  // Erasing every third value moves values from the back into the holes.
+  for (std::size_t i = 0; i < std::size(handles); i += 3) {
+    EXPECT_TRUE(numbers.erase(handles[i]));
+  }
+  for (std::size_t i = 0; i < std::size(handles); ++i) {
+    if (i % 3 == 0) {
+      EXPECT_FALSE(numbers.contains(handles[i]));
+    } else {
+      ASSERT_TRUE(numbers.contains(handles[i]));
+      EXPECT_EQ(*numbers.get(handles[i]), static_cast<int>(i));
+    }
+  }
+}
+
+TEST(slot_map, values_are_dense) {
+  rpg::slot_map<int> numbers{};
+  std::vector<rpg::slot_handle> handles{};
+  for (auto i = 0; i < 8; ++i) {
+    handles.push_back(numbers.insert(i));
+  }
+  std::ignore = numbers.erase(handles[2]);
+  std::ignore = numbers.erase(handles[5]);
+
+  EXPECT_EQ(std::size(numbers.values()), 6);
+  EXPECT_EQ(std::accumulate(numbers.begin(), numbers.end(), 0),
+            0 + 1 + 3 + 4 + 6 + 7);
+  for (std::size_t position = 0; position < numbers.size(); ++position) {
+    EXPECT_EQ(&numbers.get(numbers.handle(position)),
+              &numbers.values()[position]);
+  }
+}
+
+TEST(slot_map, clear_invalidates_every_handle) {
+  rpg::slot_map<int> numbers{};
+  const auto first = numbers.insert(1);
+  const auto second = numbers.insert(2);
+  numbers.clear();
+  EXPECT_TRUE(numbers.empty());
+  EXPECT_FALSE(numbers.contains(first));
+  EXPECT_FALSE(numbers.contains(second));
+
+  const auto third = numbers.insert(3);
+  const auto fourth = numbers.insert(4);
+  EXPECT_FALSE(numbers.contains(first));
+  EXPECT_FALSE(numbers.contains(second));
+  EXPECT_EQ(numbers.get(third), 3);
+  EXPECT_EQ(numbers.get(fourth), 4);
+}
+
+TEST(slot_map, rejects_handles_from_nowhere) {
+  rpg::slot_map<int> numbers{};
+  const auto kept = numbers.insert(1);
+  std::ignore = numbers.erase(numbers.insert(2));
+  EXPECT_FALSE(numbers.contains({.index = 1, .generation = 1}));
+  EXPECT_FALSE(numbers.contains({.index = 7, .generation = 0}));
+  EXPECT_TRUE(numbers.contains(kept));
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,230 @@
+#include <rpg/spatial_hash.hpp>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+auto random_points(const std::size_t count, const float extent,
+                   const unsigned seed) {
+  std::mt19937 random{seed};
+  std::uniform_real_distribution<float> coordinate{-extent, extent};
+  std::vector<sf::Vector2f> points(count);
+  for (auto &point : points) {
+    point = {coordinate(random), coordinate(random)};
+  }
+  return points;
+}
+
+auto within(const sf::Vector2f a, const sf::Vector2f b, const float radius) {
+  const auto offset = a - b;
+  return offset.x * offset.x + offset.y * offset.y <= radius * radius;
+}
+
+auto found_around(const rpg::spatial_hash &grid, const sf::Vector2f center,
+                  const float radius) {
+  std::set<std::uint32_t> found{};
+  grid.query_radius(center, radius,
+                    [&](const std::uint32_t id, sf::Vector2f) {
+                      EXPECT_TRUE(found.insert(id).second) << "id " << id;
+                    });
+  return found;
+}
+
+auto brute_force_around(const std::vector<sf::Vector2f> &points,
+                        const sf::Vector2f center, const float radius) {
+  std::set<std::uint32_t> found{};
+  for (std::size_t id = 0; id < std::size(points); ++id) {
+    if (within(points[id], center, radius)) {
+      found.insert(static_cast<std::uint32_t>(id));
+    }
+  }
+  return found;
+}
+} // namespace
+
+TEST(spatial_hash, radius_queries_match_brute_force) {
+  // A handful of buckets for a lot of cells, so plenty of cells share one.
+  for (const std::uint32_t buckets : {1u, 16u, 4096u}) {
+    rpg::spatial_hash grid{{.cell_size = 32.0f, .bucket_count = buckets}};
+    const auto points = random_points(2000, 500.0f, 1);
+    for (std::size_t id = 0; id < std::size(points); ++id) {
+      grid.insert(static_cast<std::uint32_t>(id), points[id]);
+    }
+    EXPECT_EQ(grid.size(), std::size(points));
+
+    for (const auto radius : {0.0f, 10.0f, 16.0f, 45.0f, 200.0f}) {
+      for (const auto center : random_points(50, 550.0f, 2)) {
+        EXPECT_EQ(found_around(grid, center, radius),
+                  brute_force_around(points, center, radius))
+            << buckets << " buckets, radius " << radius;
+      }
+    }
+  }
+}
+
+TEST(spatial_hash, rect_queries_match_brute_force) {
+  rpg::spatial_hash grid{{.cell_size = 50.0f}};
+  const auto points = random_points(2000, 500.0f, 3);
+  for (std::size_t id = 0; id < std::size(points); ++id) {
+    grid.insert(static_cast<std::uint32_t>(id), points[id]);
+  }
+  const sf::FloatRect area{-120.0f, 30.0f, 310.0f, 75.0f};
+  std::set<std::uint32_t> found{};
+  grid.query_rect(area, [&](const std::uint32_t id, sf::Vector2f) {
+    found.insert(id);
+  });
+  std::set<std::uint32_t> expected{};
+  for (std::size_t id = 0; id < std::size(points); ++id) {
+    const auto point = points[id];
+    if (point.x >= area.left and point.x <= area.left + area.width and
+        point.y >= area.top and point.y <= area.top + area.height) {
+      expected.insert(static_cast<std::uint32_t>(id));
+    }
+  }
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(found, expected);
+}
+
+TEST(spatial_hash, only_rebuckets_points_that_change_cells) {
+  rpg::spatial_hash grid{{.cell_size = 10.0f}};
+  grid.insert(0, {1.0f, 1.0f});
+  grid.insert(1, {-1.0f, 5.0f});
+  EXPECT_FALSE(grid.update(0, {9.5f, 9.5f}));
+  EXPECT_EQ(grid.position(0), (sf::Vector2f{9.5f, 9.5f}));
+  EXPECT_EQ(grid.take_rebucketed(), 0);
+
+  EXPECT_TRUE(grid.update(0, {10.0f, 9.5f}));
+  EXPECT_TRUE(grid.update(1, {1.0f, 5.0f}));
+  EXPECT_EQ(grid.take_rebucketed(), 2);
+  EXPECT_EQ(grid.take_rebucketed(), 0);
+  EXPECT_EQ(found_around(grid, {10.0f, 9.5f}, 0.0f),
+            std::set<std::uint32_t>{0});
+  EXPECT_EQ(found_around(grid, {1.0f, 5.0f}, 0.5f),
+            std::set<std::uint32_t>{1});
+}
+
+TEST(spatial_hash, stays_correct_through_updates_and_removals) {
+  rpg::spatial_hash grid{{.cell_size = 16.0f, .bucket_count = 64}};
+  auto points = random_points(1000, 200.0f, 4);
+  grid.reserve(std::size(points));
+  for (std::size_t id = 0; id < std::size(points); ++id) {
+    grid.insert(static_cast<std::uint32_t>(id), points[id]);
+  }
+
+  std::mt19937 random{5};
+  std::uniform_real_distribution<float> step{-6.0f, 6.0f};
+  for (auto tick = 0; tick < 20; ++tick) {
+    for (auto &point : points) {
+      point += sf::Vector2f{step(random), step(random)};
+    }
+    grid.update(points);
+  }
+  EXPECT_GT(grid.take_rebucketed(), 0);
+
+  std::vector<sf::Vector2f> remaining{};
+  for (std::uint32_t id = 0; id < std::size(points); ++id) {
+    if (id % 3 == 0) {
+      EXPECT_TRUE(grid.remove(id));
+      EXPECT_FALSE(grid.contains(id));
+      // Keeps brute force from finding it.
+      points[id] = {1e9f, 1e9f};
+    }
+  }
+  EXPECT_FALSE(grid.remove(0));
+  EXPECT_EQ(grid.size(), 666);
+  for (const auto center : random_points(50, 220.0f, 6)) {
+    EXPECT_EQ(found_around(grid, center, 25.0f),
+              brute_force_around(points, center, 25.0f));
+  }
+}
+
+TEST(spatial_hash, updates_ignore_ids_not_present) {
+  rpg::spatial_hash grid{{.cell_size = 10.0f}};
+  grid.insert(1, {1.0f, 1.0f});
+  EXPECT_FALSE(grid.update(0, {50.0f, 50.0f}));
+  EXPECT_FALSE(grid.update(7, {50.0f, 50.0f}));
+  EXPECT_TRUE(grid.remove(1));
+  EXPECT_FALSE(grid.update(1, {50.0f, 50.0f}));
+  EXPECT_EQ(grid.size(), 0);
+  EXPECT_TRUE(found_around(grid, {50.0f, 50.0f}, 1.0f).empty());
+}
+
+TEST(spatial_hash, huge_and_far_queries_match_brute_force) {
+  rpg::spatial_hash grid{{.cell_size = 1.0f, .bucket_count = 64}};
+  auto points = random_points(200, 500.0f, 7);
+  points.push_back({3e9f, -3e9f});
+  points.push_back({-1e30f, 1e30f});
+  for (std::size_t id = 0; id < std::size(points); ++id) {
+    grid.insert(static_cast<std::uint32_t>(id), points[id]);
+  }
+  for (const auto radius : {5.0f, 1e6f, 1e10f, 1e31f}) {
+    for (const sf::Vector2f center :
+         {sf::Vector2f{0.0f, 0.0f}, sf::Vector2f{3e9f, -3e9f},
+          sf::Vector2f{-1e30f, 1e30f}}) {
+      EXPECT_EQ(found_around(grid, center, radius),
+                brute_force_around(points, center, radius))
+          << "radius " << radius;
+    }
+  }
+}
+
+TEST(spatial_hash, batch_queries_match_single_queries) {
+  rpg::spatial_hash grid{};
+  const auto points = random_points(500, 300.0f, 7);
+  for (std::size_t id = 0; id < std::size(points); ++id) {
+    grid.insert(static_cast<std::uint32_t>(id), points[id]);
+  }
+  const auto centers = random_points(40, 300.0f, 8);
+  std::vector<std::uint32_t> ids{};
+  std::vector<std::size_t> offsets{};
+  grid.query_radius(centers, 40.0f, ids, offsets);
+  ASSERT_EQ(std::size(offsets), std::size(centers) + 1);
+  EXPECT_EQ(offsets.back(), std::size(ids));
+  for (std::size_t i = 0; i < std::size(centers); ++i) {
+    const std::set<std::uint32_t> batch{
+        std::begin(ids) + static_cast<std::ptrdiff_t>(offsets[i]),
+        std::begin(ids) + static_cast<std::ptrdiff_t>(offsets[i + 1])};
+    EXPECT_EQ(batch, found_around(grid, centers[i], 40.0f));
+  }
+}
+
+TEST(spatial_hash, each_pair_reports_every_close_pair_once) {
+  rpg::spatial_hash grid{{.cell_size = 20.0f}};
+  const auto points = random_points(800, 200.0f, 9);
+  for (std::size_t id = 0; id < std::size(points); ++id) {
+    grid.insert(static_cast<std::uint32_t>(id), points[id]);
+  }
+  std::set<std::pair<std::uint32_t, std::uint32_t>> pairs{};
+  grid.each_pair(10.0f, [&](const std::uint32_t first,
+                            const std::uint32_t second) {
+    EXPECT_LT(first, second);
+    EXPECT_TRUE(pairs.emplace(first, second).second);
+  });
+  std::set<std::pair<std::uint32_t, std::uint32_t>> expected{};
+  for (std::uint32_t first = 0; first < std::size(points); ++first) {
+    for (auto second = first + 1; second < std::size(points); ++second) {
+      if (within(points[first], points[second], 10.0f)) {
+        expected.emplace(first, second);
+      }
+    }
+  }
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(pairs, expected);
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,145 @@
+#include <rpg/window/bitset_input.hpp>
+#include <rpg/window/input.hpp>
+#include <rpg/window/key_position.hpp>
+#include <rpg/window/key_state.hpp>
+
+#include <rpg/test/mocks/keyboard_input.hpp>
+
+#include <SFML/System/Time.hpp>
+#include <SFML/Window/Keyboard.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+
+namespace {
+struct fake_keyboard {
+  std::array<bool, sf::Keyboard::KeyCount> pressed{};
+
+  [[nodiscard]] bool is_key_pressed(const sf::Keyboard::Key key) const {
+    return pressed[key];
+  }
+};
+} // namespace
+
+TEST(window_bitset_input, key_state_is_pressed_the_first_time_its_pressed) {
+  rpg::test::mocks::keyboard_input input{};
+  EXPECT_CALL(input, is_key_pressed(sf::Keyboard::Key::A))
+      .Times(1)
+      .WillOnce(::testing::Return(true));
+
+  rpg::window::bitset_input window_input{input};
+  window_input.subscribe(sf::Keyboard::Key::A);
+  window_input.update(sf::seconds(1.0f));
+  EXPECT_EQ(rpg::window::key_position::pressed,
+            window_input.get_key_state(sf::Keyboard::Key::A).position);
+}
+
+TEST(window_bitset_input, walks_through_every_key_position) {
+  rpg::test::mocks::keyboard_input input{};
+  EXPECT_CALL(input, is_key_pressed(sf::Keyboard::Key::A))
+      .Times(4)
+      .WillOnce(::testing::Return(true))
+      .WillOnce(::testing::Return(true))
+      .WillOnce(::testing::Return(false))
+      .WillOnce(::testing::Return(false));
+
+  rpg::window::bitset_input window_input{input, sf::Keyboard::Key::A};
+  const auto delta_time = sf::seconds(1.0f);
+  window_input.update(delta_time);
+  EXPECT_EQ(rpg::window::key_position::pressed,
+            window_input.get_key_state(sf::Keyboard::Key::A).position);
+  window_input.update(delta_time);
+  EXPECT_EQ(rpg::window::key_position::down,
+            window_input.get_key_state(sf::Keyboard::Key::A).position);
+  window_input.update(delta_time);
+  EXPECT_EQ(rpg::window::key_position::released,
+            window_input.get_key_state(sf::Keyboard::Key::A).position);
+  window_input.update(delta_time);
+  EXPECT_EQ(rpg::window::key_position::up,
+            window_input.get_key_state(sf::Keyboard::Key::A).position);
+}
+
+TEST(window_bitset_input, only_polls_subscribed_keys) {
+  rpg::test::mocks::keyboard_input input{};
+  EXPECT_CALL(input, is_key_pressed(sf::Keyboard::Key::A))
+      .Times(1)
+      .WillOnce(::testing::Return(false));
+  EXPECT_CALL(input, is_key_pressed(sf::Keyboard::Key::Pause))
+      .Times(2)
+      .WillRepeatedly(::testing::Return(false));
+
+  rpg::window::bitset_input window_input{input, sf::Keyboard::Key::A,
+                                         sf::Keyboard::Key::Pause};
+  window_input.update(sf::seconds(1.0f));
+  window_input.unsubscribe(sf::Keyboard::Key::A);
+  window_input.update(sf::seconds(1.0f));
+  EXPECT_EQ(rpg::window::key_position::unknown,
+            window_input.get_key_state(sf::Keyboard::Key::A).position);
+  EXPECT_EQ(rpg::window::key_position::up,
+            window_input.get_key_state(sf::Keyboard::Key::Pause).position);
+}
+
+TEST(window_bitset_input, unsubscribed_key_is_unknown) {
+  fake_keyboard keyboard{};
+  keyboard.pressed[sf::Keyboard::Key::W] = true;
+  rpg::window::bitset_input window_input{keyboard};
+  window_input.update(sf::seconds(1.0f));
+  EXPECT_EQ(rpg::window::key_position::unknown,
+            window_input.get_key_state(sf::Keyboard::Key::W).position);
+}
+
+TEST(window_bitset_input, keys_outside_the_bitsets_are_ignored) {
+  fake_keyboard keyboard{};
+  rpg::window::bitset_input window_input{keyboard, sf::Keyboard::Key::Unknown,
+                                         sf::Keyboard::Key::KeyCount};
+  window_input.subscribe(sf::Keyboard::Key::Unknown);
+  window_input.update(sf::seconds(1.0f));
+  EXPECT_EQ(rpg::window::key_position::unknown,
+            window_input.get_key_state(sf::Keyboard::Key::Unknown).position);
+  EXPECT_EQ(rpg::window::key_position::unknown,
+            window_input.get_key_state(sf::Keyboard::Key::KeyCount).position);
+  window_input.unsubscribe(sf::Keyboard::Key::Unknown);
+  EXPECT_EQ(window_input.down_keys().words,
+            rpg::window::key_bitset{}.words);
+}
+
+TEST(window_bitset_input, matches_flat_map_input) {
+  fake_keyboard keyboard{};
+  rpg::window::input expected{keyboard};
+  rpg::window::bitset_input actual{keyboard};
+  for (auto key = 0; key < sf::Keyboard::KeyCount; key += 3) {
+    expected.subscribe(static_cast<sf::Keyboard::Key>(key));
+    actual.subscribe(static_cast<sf::Keyboard::Key>(key));
+  }
+
+  std::mt19937 random{42};
+  std::bernoulli_distribution flip{0.2};
+  std::uniform_int_distribution<int> milliseconds{1, 50};
+  for (auto frame = 0; frame < 1000; ++frame) {
+    for (auto &pressed : keyboard.pressed) {
+      pressed = pressed != flip(random);
+    }
+    const auto delta_time = sf::milliseconds(milliseconds(random));
+    expected.update(delta_time);
+    actual.update(delta_time);
+    for (auto key = 0; key < sf::Keyboard::KeyCount; key += 3) {
+      const auto &expected_state =
+          expected.get_key_state(static_cast<sf::Keyboard::Key>(key));
+      const auto actual_state =
+          actual.get_key_state(static_cast<sf::Keyboard::Key>(key));
+      ASSERT_EQ(expected_state.position, actual_state.position);
+      ASSERT_FLOAT_EQ(expected_state.seconds_in_current_position,
+                      actual_state.seconds_in_current_position);
+    }
+  }
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,124 @@
+#include <rpg/window/bitset_input.hpp>
+#include <rpg/window/event_input.hpp>
+#include <rpg/window/key_position.hpp>
+
+#include <SFML/System/Time.hpp>
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Keyboard.hpp>
+
+#include <gtest/gtest.h>
+
+namespace {
+[[nodiscard]] sf::Event key_event(const sf::Event::EventType type,
+                                  const sf::Keyboard::Key key) {
+  sf::Event event{};
+  event.type = type;
+  event.key.code = key;
+  return event;
+}
+
+[[nodiscard]] sf::Event press(const sf::Keyboard::Key key) {
+  return key_event(sf::Event::KeyPressed, key);
+}
+
+[[nodiscard]] sf::Event release(const sf::Keyboard::Key key) {
+  return key_event(sf::Event::KeyReleased, key);
+}
+} // namespace
+
+TEST(window_event_input, walks_through_every_key_position) {
+  rpg::window::event_input events{};
+  rpg::window::bitset_input input{events, sf::Keyboard::Key::A};
+  const auto delta_time = sf::seconds(1.0f);
+
+  events.process(press(sf::Keyboard::Key::A));
+  input.update(delta_time);
+  EXPECT_EQ(rpg::window::key_position::pressed,
+            input.get_key_state(sf::Keyboard::Key::A).position);
+  input.update(delta_time);
+  EXPECT_EQ(rpg::window::key_position::down,
+            input.get_key_state(sf::Keyboard::Key::A).position);
+  EXPECT_EQ(1.0f, input.get_key_state(sf::Keyboard::Key::A)
+                      .seconds_in_current_position);
+  events.process(release(sf::Keyboard::Key::A));
+  input.update(delta_time);
+  EXPECT_EQ(rpg::window::key_position::released,
+            input.get_key_state(sf::Keyboard::Key::A).position);
+  input.update(delta_time);
+  EXPECT_EQ(rpg::window::key_position::up,
+            input.get_key_state(sf::Keyboard::Key::A).position);
+}
+
+TEST(window_event_input, tap_within_a_frame_is_not_missed) {
+  rpg::window::event_input events{};
+  rpg::window::bitset_input input{events, sf::Keyboard::Key::A};
+  const auto delta_time = sf::seconds(1.0f);
+  input.update(delta_time);
+  input.update(delta_time);
+
+  events.process(press(sf::Keyboard::Key::A));
+  events.process(release(sf::Keyboard::Key::A));
+  EXPECT_FALSE(events.is_key_pressed(sf::Keyboard::Key::A));
+  input.update(delta_time);
+  EXPECT_EQ(rpg::window::key_position::pressed,
+            input.get_key_state(sf::Keyboard::Key::A).position);
+  input.update(delta_time);
+  EXPECT_EQ(rpg::window::key_position::released,
+            input.get_key_state(sf::Keyboard::Key::A).position);
+  input.update(delta_time);
+  EXPECT_EQ(rpg::window::key_position::up,
+            input.get_key_state(sf::Keyboard::Key::A).position);
+}
+
+TEST(window_event_input, release_and_press_within_a_frame_is_not_missed) {
+  rpg::window::event_input events{};
+  rpg::window::bitset_input input{events, sf::Keyboard::Key::A};
+  const auto delta_time = sf::seconds(1.0f);
+  events.process(press(sf::Keyboard::Key::A));
+  input.update(delta_time);
+  input.update(delta_time);
+
+  events.process(release(sf::Keyboard::Key::A));
+  events.process(press(sf::Keyboard::Key::A));
+  input.update(delta_time);
+  EXPECT_EQ(rpg::window::key_position::released,
+            input.get_key_state(sf::Keyboard::Key::A).position);
+  input.update(delta_time);
+  EXPECT_EQ(rpg::window::key_position::pressed,
+            input.get_key_state(sf::Keyboard::Key::A).position);
+  input.update(delta_time);
+  EXPECT_EQ(rpg::window::key_position::down,
+            input.get_key_state(sf::Keyboard::Key::A).position);
+}
+
+TEST(window_event_input, losing_focus_releases_held_keys) {
+  rpg::window::event_input events{};
+  rpg::window::bitset_input input{events, sf::Keyboard::Key::W};
+  events.process(press(sf::Keyboard::Key::W));
+  input.update(sf::seconds(1.0f));
+
+  sf::Event lost_focus{};
+  lost_focus.type = sf::Event::LostFocus;
+  events.process(lost_focus);
+  input.update(sf::seconds(1.0f));
+  EXPECT_EQ(rpg::window::key_position::released,
+            input.get_key_state(sf::Keyboard::Key::W).position);
+}
+
+TEST(window_event_input, ignores_unknown_keys) {
+  rpg::window::event_input events{};
+  events.process(press(sf::Keyboard::Key::Unknown));
+  EXPECT_FALSE(events.is_key_pressed(sf::Keyboard::Key::Unknown));
+  const auto snapshot = events.snapshot();
+  for (const auto word : snapshot.words) {
+    EXPECT_EQ(0, word);
+  }
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
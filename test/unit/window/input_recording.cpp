@@ -0,0 +1,193 @@
+#include <rpg/window/bitset_input.hpp>
+#include <rpg/window/input_recorder.hpp>
+#include <rpg/window/input_recording.hpp>
+#include <rpg/window/input_replay.hpp>
+#include <rpg/window/key_bitset.hpp>
+#include <rpg/window/key_position.hpp>
+
+#include <SFML/System/Time.hpp>
+#include <SFML/Window/Keyboard.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct fake_source {
+  rpg::window::key_bitset pressed{};
+
+  [[nodiscard]] const rpg::window::key_bitset &snapshot() const {
+    return pressed;
+  }
+};
+
+// Flips each key with a small probability, like a player mashing keys.
+void flip_keys(std::mt19937 &random, rpg::window::key_bitset &pressed) {
+  std::bernoulli_distribution flip{0.05};
+  for (std::size_t key = 0; key < rpg::window::key_bitset::key_count; ++key) {
+    if (flip(random)) {
+      pressed.words[rpg::window::key_bitset::word_index(key)] ^=
+          rpg::window::key_bitset::bit(key);
+    }
+  }
+}
+
+[[nodiscard]] std::vector<std::byte> bytes(const std::string &data) {
+  const auto *begin = reinterpret_cast<const std::byte *>(std::data(data));
+  return {begin, begin + std::size(data)};
+}
+} // namespace
+
+TEST(input_recording, varints_round_trip) {
+  std::vector<std::byte> buffer{};
+  const std::vector<std::uint64_t> values{
+      0,         1,
+      127,       128,
+      16'383,    16'384,
+      1'000'000, std::numeric_limits<std::uint64_t>::max(),
+  };
+  for (const auto value : values) {
+    rpg::window::input_recording::write_varint(buffer, value);
+  }
+  EXPECT_EQ(1 + 1 + 1 + 2 + 2 + 3 + 3 + 10, std::size(buffer));
+
+  std::span<const std::byte> input{buffer};
+  for (const auto value : values) {
+    EXPECT_EQ(value, rpg::window::input_recording::read_varint(input));
+  }
+  EXPECT_TRUE(input.empty());
+}
+
+TEST(input_recording, replay_matches_live_input) {
+  constexpr auto frame_count = 2000;
+  fake_source live_source{};
+  rpg::window::bitset_input live{live_source};
+  std::stringstream stream{};
+  {
+    rpg::window::input_recorder recorder{stream};
+    std::mt19937 random{42};
+    std::uniform_int_distribution<int> microseconds{1, 100'000};
+    for (auto frame = 0; frame < frame_count; ++frame) {
+      flip_keys(random, live_source.pressed);
+      recorder.record(sf::microseconds(microseconds(random)),
+                      live_source.pressed);
+    }
+  }
+
+  const auto data = bytes(stream.str());
+  rpg::window::input_replay replay{data};
+  live_source.pressed = {};
+  std::mt19937 random{42};
+  std::uniform_int_distribution<int> microseconds{1, 100'000};
+  for (auto key = 0; key < sf::Keyboard::KeyCount; ++key) {
+    live.subscribe(static_cast<sf::Keyboard::Key>(key));
+    replay.subscribe(static_cast<sf::Keyboard::Key>(key));
+  }
+  for (auto frame = 0; frame < frame_count; ++frame) {
+    flip_keys(random, live_source.pressed);
+    const auto delta_time = sf::microseconds(microseconds(random));
+    live.update(delta_time);
+    ASSERT_TRUE(replay.next());
+    ASSERT_EQ(delta_time, replay.delta_time());
+    for (auto key = 0; key < sf::Keyboard::KeyCount; ++key) {
+      const auto expected =
+          live.get_key_state(static_cast<sf::Keyboard::Key>(key));
+      const auto actual =
+          replay.get_key_state(static_cast<sf::Keyboard::Key>(key));
+      ASSERT_EQ(expected.position, actual.position);
+      ASSERT_EQ(expected.seconds_in_current_position,
+                actual.seconds_in_current_position);
+    }
+  }
+  EXPECT_FALSE(replay.next());
+  EXPECT_EQ(frame_count, replay.frame());
+}
+
+TEST(input_recording, idle_frames_at_60_fps_are_three_bytes) {
+  std::stringstream stream{};
+  {
+    rpg::window::input_recorder recorder{stream};
+    for (auto frame = 0; frame < 100; ++frame) {
+      recorder.record(sf::milliseconds(16), {});
+    }
+  }
+  const auto header_size = std::size(rpg::window::input_recording::magic) + 2;
+  EXPECT_EQ(header_size + 100 * 3, std::size(stream.str()));
+}
+
+TEST(input_recording, replay_drives_key_positions) {
+  std::stringstream stream{};
+  {
+    rpg::window::input_recorder recorder{stream};
+    rpg::window::key_bitset pressed{};
+    pressed.set(sf::Keyboard::Key::W);
+    recorder.record(sf::milliseconds(16), pressed);
+    recorder.record(sf::milliseconds(16), pressed);
+    recorder.record(sf::milliseconds(16), {});
+  }
+
+  const auto data = bytes(stream.str());
+  rpg::window::input_replay replay{data};
+  replay.subscribe(sf::Keyboard::Key::W);
+  ASSERT_TRUE(replay.next());
+  EXPECT_EQ(rpg::window::key_position::pressed,
+            replay.get_key_state(sf::Keyboard::Key::W).position);
+  EXPECT_TRUE(replay.snapshot().test(sf::Keyboard::Key::W));
+  ASSERT_TRUE(replay.next());
+  EXPECT_EQ(rpg::window::key_position::down,
+            replay.get_key_state(sf::Keyboard::Key::W).position);
+  ASSERT_TRUE(replay.next());
+  EXPECT_EQ(rpg::window::key_position::released,
+            replay.get_key_state(sf::Keyboard::Key::W).position);
+  EXPECT_FALSE(replay.snapshot().test(sf::Keyboard::Key::W));
+  EXPECT_FALSE(replay.next());
+}
+
+TEST(input_recording, failed_writes_throw) {
+  // No buffer to write into, so every write fails.
+  std::ostream broken{nullptr};
+  rpg::window::input_recorder recorder{broken};
+  recorder.record(sf::milliseconds(16), {});
+  EXPECT_THROW(recorder.flush(), std::runtime_error);
+  // Enough frames to fill the buffer, which record then writes.
+  const auto record_frames = [&] {
+    for (auto frame = 0; frame < 10'000; ++frame) {
+      recorder.record(sf::milliseconds(16), {});
+    }
+  };
+  EXPECT_THROW(record_frames(), std::runtime_error);
+}
+
+TEST(input_recording, rejects_malformed_recordings) {
+  const auto not_a_recording = bytes("not a recording");
+  EXPECT_THROW(rpg::window::input_replay{not_a_recording}, std::runtime_error);
+
+  std::stringstream stream{};
+  {
+    rpg::window::input_recorder recorder{stream};
+    rpg::window::key_bitset pressed{};
+    pressed.set(sf::Keyboard::Key::W);
+    recorder.record(sf::milliseconds(16), pressed);
+  }
+  auto truncated = bytes(stream.str());
+  truncated.pop_back();
+  rpg::window::input_replay replay{truncated};
+  EXPECT_THROW(std::ignore = replay.next(), std::runtime_error);
+}
+
+#if defined(RPG_OS_IS_WINDOWS)
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif